@@ -0,0 +1,45 @@
+#pragma once
+// 基准测试使用的数据模型，与 examples/full_usage_example.cpp 中的 Product / Order 一致
+
+#include "uORM/orm/Reflection.h"
+#include <string>
+
+struct Product {
+    int id;
+    std::string name;
+    std::string category;
+    double price;
+    int stock;
+    bool is_active;
+    std::string created_at;
+};
+
+struct Order {
+    long long id;
+    int user_id;
+    int product_id;
+    int quantity;
+    double total_amount;
+    std::string status;
+    std::string order_time;
+};
+
+UORM_TABLE_BEGIN(Product, "products")
+    UORM_FIELD(id, "id", PRIMARY KEY AUTO_INCREMENT),
+    UORM_FIELD(name, "name", NOT NULL),
+    UORM_FIELD(category, "category", NOT NULL),
+    UORM_FIELD(price, "price", NOT NULL),
+    UORM_FIELD(stock, "stock", DEFAULT 0),
+    UORM_FIELD(is_active, "is_active", DEFAULT 1),
+    UORM_FIELD_TYPE(created_at, "created_at", "DATETIME", DEFAULT CURRENT_TIMESTAMP)
+UORM_TABLE_END()
+
+UORM_TABLE_BEGIN(Order, "orders")
+    UORM_FIELD(id, "id", PRIMARY KEY AUTO_INCREMENT),
+    UORM_FIELD(user_id, "user_id", NOT NULL),
+    UORM_FIELD(product_id, "product_id", NOT NULL),
+    UORM_FIELD(quantity, "quantity", NOT NULL),
+    UORM_FIELD(total_amount, "total_amount", NOT NULL),
+    UORM_FIELD(status, "status", DEFAULT 'PENDING'),
+    UORM_FIELD_TYPE(order_time, "order_time", "DATETIME", DEFAULT CURRENT_TIMESTAMP)
+UORM_TABLE_END()
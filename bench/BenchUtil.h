@@ -0,0 +1,49 @@
+#pragma once
+// 文件说明：
+// uorm_bench 的公共工具：基准用例注册、计时以及堆分配计数。
+// 分配计数由 bench_main.cpp 中替换的全局 operator new 维护。
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace uORM { 
+namespace bench { 
+
+// 进程内累计的堆分配次数
+extern std::atomic<size_t> g_allocations;
+
+// 一个基准用例：fn 内部自行循环 iterations 次
+struct BenchCase {
+    std::string name;
+    size_t iterations;
+    std::function<void(size_t)> fn;
+};
+
+inline std::vector<BenchCase>& registry() {
+    static std::vector<BenchCase> cases;
+    return cases;
+}
+
+struct Registrar {
+    Registrar(const char* name, size_t iterations, void (*fn)(size_t)) {
+        registry().push_back(BenchCase{name, iterations, fn});
+    }
+};
+
+// 阻止编译器把被测结果优化掉
+template<typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace bench
+} // namespace uORM
+
+// 定义并注册一个基准用例，函数体中使用 iterations 作为循环次数
+#define UORM_BENCH(Name, Iterations) \
+    static void Name(size_t iterations); \
+    static ::uORM::bench::Registrar Name##_registrar(#Name, Iterations, &Name); \
+    static void Name(size_t iterations)
@@ -0,0 +1,239 @@
+#pragma once
+// 文件说明：
+// uorm_bench 使用的内存驱动：实现 IConnection / IPreparedStatement / IResultSet，不访问网络。
+// 结果由 FakeDatabase::respond 按 SQL 生成，每条语句执行前可注入固定延迟，模拟数据库往返。
+//
+//   auto& db = uORM::bench::installFakeDriver(8);    // 连接池使用内存驱动，大小为 8
+//   db.respond = [](const std::string& sql) { return productRows(100); };
+//   db.latency = std::chrono::microseconds(50);
+//
+// 结果集按列名查找 (与 MySQL Connector 一致)，值以 long long / double / string 保存，取值时按需转换。
+
+#include "uORM/driver/ConnectionPool.h"
+#include "uORM/driver/DBInterfaces.h"
+#include "uORM/driver/DriverPolicy.h"
+#include "uORM/driver/SqlDialect.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace uORM {
+namespace bench {
+
+using FakeValue = std::variant<long long, double, std::string>;
+
+// 一个结果集的全部数据，构造后只读，可被多个结果集共享
+struct FakeResult {
+    std::vector<std::string> columns;
+    std::vector<std::vector<FakeValue>> rows;
+
+    FakeResult() = default;
+    explicit FakeResult(std::vector<std::string> cols) : columns(std::move(cols)) {
+        for (size_t i = 0; i < columns.size(); ++i) index_.emplace(columns[i], i);
+    }
+
+    size_t column(const std::string& name) const {
+        auto it = index_.find(name);
+        if (it == index_.end()) throw std::runtime_error("Column not found: " + name);
+        return it->second;
+    }
+
+private:
+    std::unordered_map<std::string, size_t> index_;
+};
+
+struct FakeDatabase {
+    // 每条语句执行前的延迟，0 表示不等待。sleep_for 的精度约为几十微秒
+    std::chrono::microseconds latency{0};
+    // 按 SQL 返回结果；为空或返回空指针时查询得到空结果集
+    std::function<std::shared_ptr<const FakeResult>(const std::string& sql)> respond;
+
+    std::atomic<uint64_t> statements{0};   // 已执行的语句数
+    std::atomic<uint64_t> connections{0};  // 已建立的连接数
+};
+
+class FakeResultSet final : public IResultSet {
+public:
+    explicit FakeResultSet(std::shared_ptr<const FakeResult> result) : result_(std::move(result)) {}
+
+    bool next() override {
+        if (!result_ || row_ + 1 >= result_->rows.size()) return false;
+        ++row_;
+        return true;
+    }
+
+    int getInt(const std::string& colName) override { return static_cast<int>(integer(value(colName))); }
+    long long getInt64(const std::string& colName) override { return integer(value(colName)); }
+    unsigned int getUInt(const std::string& colName) override { return static_cast<unsigned int>(integer(value(colName))); }
+    bool getBoolean(const std::string& colName) override { return integer(value(colName)) != 0; }
+
+    double getDouble(const std::string& colName) override {
+        const FakeValue& v = value(colName);
+        if (auto d = std::get_if<double>(&v)) return *d;
+        if (auto i = std::get_if<long long>(&v)) return static_cast<double>(*i);
+        return std::stod(std::get<std::string>(v));
+    }
+
+    std::string getString(const std::string& colName) override {
+        const FakeValue& v = value(colName);
+        if (auto s = std::get_if<std::string>(&v)) return *s;
+        if (auto i = std::get_if<long long>(&v)) return std::to_string(*i);
+        return std::to_string(std::get<double>(v));
+    }
+
+private:
+    const FakeValue& value(const std::string& colName) const {
+        return result_->rows[row_][result_->column(colName)];
+    }
+
+    static long long integer(const FakeValue& v) {
+        if (auto i = std::get_if<long long>(&v)) return *i;
+        if (auto d = std::get_if<double>(&v)) return static_cast<long long>(*d);
+        return std::stoll(std::get<std::string>(v));
+    }
+
+    std::shared_ptr<const FakeResult> result_;
+    size_t row_ = static_cast<size_t>(-1);   // 第一次 next() 之前位于首行之前
+};
+
+class FakePreparedStatement final : public IPreparedStatement {
+public:
+    FakePreparedStatement(FakeDatabase& db, std::string sql) : db_(db), sql_(std::move(sql)) {}
+
+    void executeUpdate() override {
+        run();
+    }
+
+    std::unique_ptr<IResultSet> executeQuery() override {
+        return std::make_unique<FakeResultSet>(run());
+    }
+
+    void setInt(int index, int val) override { set(index, static_cast<long long>(val)); }
+    void setInt64(int index, long long val) override { set(index, val); }
+    void setUInt(int index, unsigned int val) override { set(index, static_cast<long long>(val)); }
+    void setString(int index, const std::string& val) override { set(index, val); }
+    void setBoolean(int index, bool val) override { set(index, static_cast<long long>(val)); }
+    void setDouble(int index, double val) override { set(index, val); }
+
+    void clearParameters() override {
+        params_.clear();
+    }
+
+    const std::vector<FakeValue>& params() const {
+        return params_;
+    }
+
+private:
+    void set(int index, FakeValue value) {
+        if (index < 1) throw std::out_of_range("Parameter index out of range");
+        if (params_.size() < static_cast<size_t>(index)) params_.resize(static_cast<size_t>(index));
+        params_[static_cast<size_t>(index) - 1] = std::move(value);
+    }
+
+    std::shared_ptr<const FakeResult> run() {
+        if (db_.latency.count() > 0) std::this_thread::sleep_for(db_.latency);
+        db_.statements.fetch_add(1, std::memory_order_relaxed);
+        return db_.respond ? db_.respond(sql_) : nullptr;
+    }
+
+    FakeDatabase& db_;
+    std::string sql_;
+    std::vector<FakeValue> params_;
+};
+
+class FakeStatement : public IStatement {
+public:
+    explicit FakeStatement(FakeDatabase& db) : db_(db) {}
+
+    void execute(const std::string& sql) override {
+        FakePreparedStatement(db_, sql).executeUpdate();
+    }
+
+    std::unique_ptr<IResultSet> executeQuery(const std::string& sql) override {
+        return FakePreparedStatement(db_, sql).executeQuery();
+    }
+
+private:
+    FakeDatabase& db_;
+};
+
+class FakeConnection : public IConnection {
+public:
+    explicit FakeConnection(FakeDatabase& db) : db_(db) {
+        db_.connections.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~FakeConnection() override {
+        clearStatementCache();
+    }
+
+    bool isValid() override { return true; }
+    void setSchema(const std::string&) override {}
+
+    std::unique_ptr<IStatement> createStatement() override {
+        return std::make_unique<FakeStatement>(db_);
+    }
+
+    std::unique_ptr<IPreparedStatement> prepareStatement(const std::string& sql) override {
+        return std::make_unique<FakePreparedStatement>(db_, sql);
+    }
+
+private:
+    FakeDatabase& db_;
+};
+
+// 内存驱动的编译期策略，Mapper<T, FakeStaticDriver> 与 Mapper<T, DynamicDriver> 对照衡量虚函数调用的开销
+using FakeStaticDriver = StaticDriver<FakeConnection, FakePreparedStatement, FakeResultSet, MySQLDialect>;
+
+// 进程内唯一的内存数据库
+inline FakeDatabase& fakeDatabase() {
+    static FakeDatabase db;
+    return db;
+}
+
+// 让 ConnectionPool 使用内存驱动 (MySQL 方言)。只在首次调用时安装，之后的调用直接返回数据库
+inline FakeDatabase& installFakeDriver(int poolSize = 8) {
+    static bool installed = [poolSize] {
+        ConfigManager::getInstance().databaseconfigdata_.poolsize = poolSize;
+        ConnectionPool::setConnectionFactory([] { return new FakeConnection(fakeDatabase()); },
+                                             std::make_shared<MySQLDialect>());
+        return true;
+    }();
+    (void)installed;
+    return fakeDatabase();
+}
+
+// 在作用域内修改延迟与结果生成函数，结束时恢复
+class FakeScope {
+public:
+    FakeScope(std::chrono::microseconds latency,
+              std::function<std::shared_ptr<const FakeResult>(const std::string&)> respond)
+        : db_(installFakeDriver()), latency_(db_.latency), respond_(std::move(db_.respond)) {
+        db_.latency = latency;
+        db_.respond = std::move(respond);
+    }
+
+    ~FakeScope() {
+        db_.latency = latency_;
+        db_.respond = std::move(respond_);
+    }
+
+    FakeScope(const FakeScope&) = delete;
+    FakeScope& operator=(const FakeScope&) = delete;
+
+private:
+    FakeDatabase& db_;
+    std::chrono::microseconds latency_;
+    std::function<std::shared_ptr<const FakeResult>(const std::string&)> respond_;
+};
+
+} // namespace bench
+} // namespace uORM
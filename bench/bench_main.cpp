@@ -0,0 +1,55 @@
+#include "BenchUtil.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace uORM { 
+namespace bench { 
+std::atomic<size_t> g_allocations{0};
+} // namespace bench
+} // namespace uORM
+
+// 替换全局分配函数以统计每次操作的堆分配次数
+void* operator new(std::size_t size) {
+    uORM::bench::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    uORM::bench::g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// 用法: uorm_bench [名称过滤子串]
+int main(int argc, char** argv) {
+    using namespace uORM::bench;
+    std::string filter = argc > 1 ? argv[1] : "";
+
+    std::printf("%-40s %12s %12s %12s\n", "benchmark", "iterations", "ns/op", "allocs/op");
+    for (const auto& c : registry()) {
+        if (!filter.empty() && c.name.find(filter) == std::string::npos) continue;
+
+        // 预热，避免首次调用的静态初始化计入结果
+        c.fn(c.iterations / 10 + 1);
+
+        size_t allocsBefore = g_allocations.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        c.fn(c.iterations);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        size_t allocs = g_allocations.load(std::memory_order_relaxed) - allocsBefore;
+
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / c.iterations;
+        std::printf("%-40s %12zu %12.1f %12.2f\n", c.name.c_str(), c.iterations, ns,
+                    static_cast<double>(allocs) / c.iterations);
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "BenchUtil.h"
+#include "BenchModels.h"
+#include "FakeDriver.h"
+#include "uORM/orm/Mapper.h"
+#include <memory>
+#include <string>
+
+using uORM::bench::doNotOptimize;
+using uORM::bench::FakeResult;
+using uORM::bench::FakeScope;
+
+namespace {
+
+// 基准用例显式指定驱动策略，以 UORM_STATIC_DRIVER 构建时内存驱动同样可用
+using DynamicMapper = uORM::Mapper<Product, uORM::DynamicDriver>;
+using StaticMapper = uORM::Mapper<Product, uORM::bench::FakeStaticDriver>;
+
+// products 表的 n 行确定性数据
+std::shared_ptr<const FakeResult> productRows(size_t n) {
+    auto result = std::make_shared<FakeResult>(
+        std::vector<std::string>{"id", "name", "category", "price", "stock", "is_active", "created_at"});
+    for (size_t i = 0; i < n; ++i) {
+        long long id = static_cast<long long>(i) + 1;
+        result->rows.push_back({id, "Product " + std::to_string(id), std::string("Electronics"),
+                                9.99 + static_cast<double>(i), 100LL + id, 1LL, std::string("2024-01-01 00:00:00")});
+    }
+    return result;
+}
+
+std::shared_ptr<const FakeResult> countRow(long long n) {
+    auto result = std::make_shared<FakeResult>(std::vector<std::string>{"count_val"});
+    result->rows.push_back({n});
+    return result;
+}
+
+Product sampleProduct(int id) {
+    return Product{id, "Gaming Laptop", "Electronics", 1299.99, 10, true, ""};
+}
+
+} // namespace
+
+// INSERT 语句生成 + 6 个参数绑定，驱动不返回结果
+UORM_BENCH(Mapper_SaveSqlAndBind, 500000) {
+    FakeScope scope(std::chrono::microseconds(0), nullptr);
+    Product p = sampleProduct(0);
+    for (size_t i = 0; i < iterations; ++i) {
+        p.stock = static_cast<int>(i);
+        doNotOptimize(DynamicMapper::save(p));
+    }
+}
+
+// UPDATE ... WHERE 主键，7 个参数
+UORM_BENCH(Mapper_UpdateSqlAndBind, 500000) {
+    FakeScope scope(std::chrono::microseconds(0), nullptr);
+    Product p = sampleProduct(42);
+    for (size_t i = 0; i < iterations; ++i) {
+        p.stock = static_cast<int>(i);
+        doNotOptimize(DynamicMapper::update(p));
+    }
+}
+
+// Query -> COUNT SQL -> 绑定 -> 读取一个值
+UORM_BENCH(Mapper_CountQuery, 500000) {
+    auto row = countRow(3);
+    FakeScope scope(std::chrono::microseconds(0), [row](const std::string&) { return row; });
+    for (size_t i = 0; i < iterations; ++i) {
+        uORM::Query q;
+        q.eq(&Product::category, "Electronics").gt(&Product::price, 100.0);
+        doNotOptimize(DynamicMapper::count(q));
+    }
+}
+
+// 按主键查询一行：SQL 生成、绑定与单行映射
+UORM_BENCH(Mapper_FindById, 500000) {
+    auto rows = productRows(1);
+    FakeScope scope(std::chrono::microseconds(0), [rows](const std::string&) { return rows; });
+    for (size_t i = 0; i < iterations; ++i) {
+        auto p = DynamicMapper::findById(static_cast<int>(i));
+        doNotOptimize(p->id);
+    }
+}
+
+UORM_BENCH(Mapper_FindById_Static, 500000) {
+    auto rows = productRows(1);
+    FakeScope scope(std::chrono::microseconds(0), [rows](const std::string&) { return rows; });
+    for (size_t i = 0; i < iterations; ++i) {
+        auto p = StaticMapper::findById(static_cast<int>(i));
+        doNotOptimize(p->id);
+    }
+}
+
+// 100 行结果映射为实体 (mapRow)，ns/op 为每次查询的耗时
+UORM_BENCH(Mapper_Select100Rows, 50000) {
+    auto rows = productRows(100);
+    FakeScope scope(std::chrono::microseconds(0), [rows](const std::string&) { return rows; });
+    uORM::Query q;
+    q.eq(&Product::category, "Electronics").orderBy(&Product::price, false).limit(100);
+    for (size_t i = 0; i < iterations; ++i) {
+        auto list = DynamicMapper::select(q);
+        doNotOptimize(list.size());
+    }
+}
+
+// 同上，编译期驱动策略：逐列取值直接调用 FakeResultSet
+UORM_BENCH(Mapper_Select100Rows_Static, 50000) {
+    auto rows = productRows(100);
+    FakeScope scope(std::chrono::microseconds(0), [rows](const std::string&) { return rows; });
+    uORM::Query q;
+    q.eq(&Product::category, "Electronics").orderBy(&Product::price, false).limit(100);
+    for (size_t i = 0; i < iterations; ++i) {
+        auto list = StaticMapper::select(q);
+        doNotOptimize(list.size());
+    }
+}
+
+// 作为对照：相同查询只映射 1 行，两者之差即为 99 行的映射开销
+UORM_BENCH(Mapper_Select1Row, 500000) {
+    auto rows = productRows(1);
+    FakeScope scope(std::chrono::microseconds(0), [rows](const std::string&) { return rows; });
+    uORM::Query q;
+    q.eq(&Product::category, "Electronics").orderBy(&Product::price, false).limit(100);
+    for (size_t i = 0; i < iterations; ++i) {
+        auto list = DynamicMapper::select(q);
+        doNotOptimize(list.size());
+    }
+}
@@ -0,0 +1,63 @@
+#include "BenchUtil.h"
+#include "BenchModels.h"
+#include "FakeDriver.h"
+#include "uORM/orm/Mapper.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using uORM::bench::doNotOptimize;
+using uORM::bench::FakeResult;
+using uORM::bench::FakeScope;
+
+namespace {
+
+// 将 iterations 次操作平均分给 threads 个线程，ns/op 为总耗时除以总次数 (吞吐的倒数)
+template<typename Fn>
+void runThreads(size_t threads, size_t iterations, Fn fn) {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        size_t n = iterations / threads + (t < iterations % threads ? 1 : 0);
+        workers.emplace_back([n, &fn] {
+            for (size_t i = 0; i < n; ++i) fn();
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+void acquireRelease() {
+    auto conn = uORM::ConnectionPool::instance().getConnection();
+    doNotOptimize(conn.get());
+}
+
+std::shared_ptr<const FakeResult> countRow() {
+    auto result = std::make_shared<FakeResult>(std::vector<std::string>{"count_val"});
+    result->rows.push_back({1LL});
+    return result;
+}
+
+} // namespace
+
+// 连接池取出与归还，连接池大小为 8 (installFakeDriver 的默认值)
+UORM_BENCH(Pool_AcquireRelease_1Thread, 2000000) {
+    FakeScope scope(std::chrono::microseconds(0), nullptr);
+    runThreads(1, iterations, acquireRelease);
+}
+
+UORM_BENCH(Pool_AcquireRelease_4Threads, 2000000) {
+    FakeScope scope(std::chrono::microseconds(0), nullptr);
+    runThreads(4, iterations, acquireRelease);
+}
+
+UORM_BENCH(Pool_AcquireRelease_16Threads, 2000000) {
+    FakeScope scope(std::chrono::microseconds(0), nullptr);
+    runThreads(16, iterations, acquireRelease);
+}
+
+// 每条语句 50us 延迟，16 个线程执行 COUNT：衡量连接持有期间的排队与连接池扩张
+UORM_BENCH(Pool_Count50us_16Threads, 20000) {
+    auto row = countRow();
+    FakeScope scope(std::chrono::microseconds(50), [row](const std::string&) { return row; });
+    runThreads(16, iterations, [] { doNotOptimize(uORM::Mapper<Product, uORM::DynamicDriver>::count()); });
+}
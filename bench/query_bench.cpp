@@ -0,0 +1,71 @@
+#include "BenchUtil.h"
+#include "BenchModels.h"
+#include "uORM/orm/Query.h"
+#include <string_view>
+
+using uORM::bench::doNotOptimize;
+
+// 8 个条件 + 排序分页，列名与值均为字面量
+UORM_BENCH(QueryBuild_8Conditions, 2000000) {
+    for (size_t i = 0; i < iterations; ++i) {
+        uORM::Query q;
+        q.eq("category", "Electronics")
+         .gt("price", 100.0)
+         .le("price", 2000.0)
+         .ge("stock", 1)
+         .eq("is_active", true)
+         .like("name", "%Phone%")
+         .ne("id", static_cast<int>(i))
+         .isNotNull("created_at")
+         .orderBy("price", false)
+         .limit(20)
+         .offset(40);
+        doNotOptimize(q.getWhere().size());
+        doNotOptimize(q.getParams().size());
+    }
+}
+
+// 字符串值以 std::string_view 传入，不复制
+UORM_BENCH(QueryBuild_StringViewValues, 2000000) {
+    const std::string category = "Electronics and home appliances";
+    const std::string pattern = "%Professional Edition%";
+    for (size_t i = 0; i < iterations; ++i) {
+        uORM::Query q;
+        q.eq("category", std::string_view(category))
+         .like("name", std::string_view(pattern))
+         .lt("price", 500.0)
+         .limit(10);
+        doNotOptimize(q.getWhere().size());
+    }
+}
+
+// 编译期列引用：条件片段在编译期拼接
+UORM_BENCH(QueryBuild_TypedColumns, 2000000) {
+    for (size_t i = 0; i < iterations; ++i) {
+        uORM::Query q;
+        q.eq<&Product::category>("Electronics")
+         .gt<&Product::price>(100.0)
+         .le<&Product::price>(2000.0)
+         .ge<&Product::stock>(1)
+         .eq<&Product::is_active>(true)
+         .like<&Product::name>("%Phone%")
+         .ne<&Product::id>(static_cast<int>(i))
+         .isNotNull<&Product::created_at>()
+         .orderBy<&Product::price>(false)
+         .limit(20);
+        doNotOptimize(q.getWhere().size());
+    }
+}
+
+// 运行期成员指针列引用
+UORM_BENCH(QueryBuild_MemberPointers, 2000000) {
+    for (size_t i = 0; i < iterations; ++i) {
+        uORM::Query q;
+        q.eq(&Product::category, "Electronics")
+         .gt(&Product::price, 100.0)
+         .ge(&Product::stock, 1)
+         .eq(&Product::is_active, true)
+         .orderBy(&Product::price, false);
+        doNotOptimize(q.getWhere().size());
+    }
+}
@@ -0,0 +1,318 @@
+// 文件说明：
+// uorm_workload：在真实的 MySQL / PostgreSQL 上运行 OLTP 风格的混合负载，
+// 使用与 examples/full_usage_example.cpp 相同的 Product / Order 表。
+// 驱动、连接池大小、异步驱动、multi_statements 等由配置文件决定，
+// 负载本身 (线程数、数据量、操作比例、批量方式) 由命令行参数决定，便于在同一负载上对比不同设置。
+//
+//   uorm_workload --config=config.json --threads=16 --duration=30 --products=100000
+//   uorm_workload --mix=point:80,count:20 --batch=8 --skip-load
+//
+// 输出每种操作的吞吐 (ops/s) 与延迟分位数 (毫秒)。
+
+#include "BenchModels.h"
+#include "uORM/orm/ORM.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <future>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+enum Op { Point, Insert, Decrement, Range, Count, OpCount };
+
+const char* kOpNames[OpCount] = {"point", "insert", "decrement", "range", "count"};
+const int kCategories = 16;
+
+struct Options {
+    std::string config = "config.json";
+    size_t threads = 8;
+    double duration = 10;          // 秒
+    double warmup = 2;             // 秒，期间的结果不计入统计
+    size_t products = 10000;       // 装载的商品行数
+    size_t rangeRows = 50;         // 范围扫描的 LIMIT
+    size_t batch = 1;              // >1 时点查以 Pipeline 每批发送 batch 条
+    bool compiled = false;         // 点查使用 CompiledQuery
+    bool skipLoad = false;         // 复用已有数据，不建表、不清空、不装载
+    uint64_t seed = 42;
+    int weights[OpCount] = {50, 15, 15, 10, 10};
+};
+
+void usage() {
+    std::printf(
+        "usage: uorm_workload [options]\n"
+        "  --config=PATH        配置文件 (默认 config.json)\n"
+        "  --threads=N          并发线程数 (默认 8)\n"
+        "  --duration=SEC       计时阶段时长 (默认 10)\n"
+        "  --warmup=SEC         预热时长 (默认 2)\n"
+        "  --products=N         装载的商品行数 (默认 10000)\n"
+        "  --mix=OP:W,...       操作比例，OP 为 point/insert/decrement/range/count (默认 50/15/15/10/10)\n"
+        "  --range-rows=N       范围扫描返回的最大行数 (默认 50)\n"
+        "  --batch=N            点查以 Pipeline 每批发送 N 条 (默认 1，不使用 Pipeline)\n"
+        "  --compiled           点查使用 CompiledQuery\n"
+        "  --skip-load          使用已有数据\n"
+        "  --seed=N             随机数种子 (默认 42)\n");
+}
+
+bool parseMix(const std::string& spec, int (&weights)[OpCount]) {
+    std::fill(std::begin(weights), std::end(weights), 0);
+    std::stringstream ss(spec);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        auto colon = item.find(':');
+        if (colon == std::string::npos) return false;
+        std::string name = item.substr(0, colon);
+        auto it = std::find_if(std::begin(kOpNames), std::end(kOpNames), [&](const char* n) { return name == n; });
+        if (it == std::end(kOpNames)) return false;
+        weights[it - std::begin(kOpNames)] = std::atoi(item.c_str() + colon + 1);
+    }
+    return std::any_of(std::begin(weights), std::end(weights), [](int w) { return w > 0; });
+}
+
+bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--config") opt.config = value;
+        else if (key == "--threads") opt.threads = std::max<size_t>(1, std::strtoul(value.c_str(), nullptr, 10));
+        else if (key == "--duration") opt.duration = std::atof(value.c_str());
+        else if (key == "--warmup") opt.warmup = std::atof(value.c_str());
+        else if (key == "--products") opt.products = std::max<size_t>(1, std::strtoul(value.c_str(), nullptr, 10));
+        else if (key == "--range-rows") opt.rangeRows = std::max<size_t>(1, std::strtoul(value.c_str(), nullptr, 10));
+        else if (key == "--batch") opt.batch = std::max<size_t>(1, std::strtoul(value.c_str(), nullptr, 10));
+        else if (key == "--compiled") opt.compiled = true;
+        else if (key == "--skip-load") opt.skipLoad = true;
+        else if (key == "--seed") opt.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (key == "--mix") {
+            if (!parseMix(value, opt.weights)) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string category(int i) {
+    return "category-" + std::to_string(i % kCategories);
+}
+
+// 建表、清空并由多个线程并行装载商品
+void load(const Options& opt) {
+    uORM::Schema::createTable<Product>();
+    uORM::Schema::createTable<Order>();
+    uORM::Mapper<Order>::truncate();
+    uORM::Mapper<Product>::truncate();
+
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < opt.threads; ++t) {
+        workers.emplace_back([&] {
+            for (size_t i = next++; i < opt.products; i = next++) {
+                Product p{0, "product-" + std::to_string(i), category(static_cast<int>(i)),
+                          5.0 + static_cast<double>(i % 1000), 1000, true, ""};
+                uORM::Mapper<Product>::save(p);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+// TRUNCATE 不一定重置自增序列 (PostgreSQL)，从表中读取实际的主键
+std::vector<int> productIds() {
+    std::vector<int> ids;
+    for (const auto& p : uORM::Mapper<Product>::findAll()) ids.push_back(p.id);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+struct Shared {
+    Shared(const Options& o, const std::vector<int>& productIds)
+        : opt(o), ids(productIds), mix(std::begin(o.weights), std::end(o.weights)) {}
+
+    const Options& opt;
+    const std::vector<int>& ids;
+    std::discrete_distribution<int> mix;
+    std::atomic<bool> measuring{false};
+    std::atomic<bool> stop{false};
+    uORM::detail::ShardedStats stats[OpCount];
+};
+
+class Worker {
+public:
+    Worker(Shared& shared, size_t index)
+        : s_(shared), rng_(shared.opt.seed + index), mix_(shared.mix) {
+        if (s_.opt.compiled) {
+            byId_.emplace(uORM::Mapper<Product>::compile(uORM::Query().eq(&Product::id, uORM::placeholder).limit(1)));
+        }
+    }
+
+    void run() {
+        while (!s_.stop.load(std::memory_order_relaxed)) {
+            Op op = static_cast<Op>(mix_(rng_));
+            bool measuring = s_.measuring.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            bool failed = false;
+            uint64_t rows = 0;
+            try {
+                rows = execute(op);
+            } catch (const std::exception& e) {
+                failed = true;
+                if (errors_++ < 3) std::fprintf(stderr, "%s failed: %s\n", kOpNames[op], e.what());
+            }
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+            if (measuring) s_.stats[op].record(static_cast<uint64_t>(micros), failed, rows, 0);
+        }
+    }
+
+private:
+    int randomId() {
+        return s_.ids[std::uniform_int_distribution<size_t>(0, s_.ids.size() - 1)(rng_)];
+    }
+
+    uint64_t execute(Op op) {
+        switch (op) {
+            case Point: return point();
+            case Insert: {
+                int pid = randomId();
+                int qty = std::uniform_int_distribution<int>(1, 5)(rng_);
+                Order o{0, std::uniform_int_distribution<int>(1, 100000)(rng_), pid, qty, 9.99 * qty, "PENDING", ""};
+                return uORM::Mapper<Order>::save(o) ? 1 : 0;
+            }
+            case Decrement: {
+                // 与示例相同的读取-修改-写回：查询商品后扣减库存，库存耗尽时补货
+                auto p = uORM::Mapper<Product>::findById(randomId());
+                if (!p) return 0;
+                p->stock = p->stock > 0 ? p->stock - 1 : 1000;
+                return uORM::Mapper<Product>::update(*p) ? 1 : 0;
+            }
+            case Range: {
+                double low = std::uniform_real_distribution<double>(5.0, 900.0)(rng_);
+                uORM::Query q;
+                q.eq(&Product::category, category(std::uniform_int_distribution<int>(0, kCategories - 1)(rng_)))
+                 .ge(&Product::price, low)
+                 .le(&Product::price, low + 100.0)
+                 .orderBy(&Product::price, true)
+                 .limit(static_cast<int>(s_.opt.rangeRows));
+                return uORM::Mapper<Product>::select(q).size();
+            }
+            case Count: {
+                uORM::Query q;
+                q.eq(&Product::category, category(std::uniform_int_distribution<int>(0, kCategories - 1)(rng_)));
+                return uORM::Mapper<Product>::count(q) > 0 ? 1 : 0;
+            }
+            default: return 0;
+        }
+    }
+
+    // batch > 1 时一次操作在同一条连接上流水线执行 batch 条点查
+    uint64_t point() {
+        if (s_.opt.batch <= 1) {
+            int id = randomId();
+            auto p = byId_ ? byId_->executeOne(id) : uORM::Mapper<Product>::findById(id);
+            return p ? 1 : 0;
+        }
+        uORM::Pipeline pipeline;
+        std::vector<std::future<uORM::EntityList<Product>>> results;
+        results.reserve(s_.opt.batch);
+        for (size_t i = 0; i < s_.opt.batch; ++i) {
+            results.push_back(pipeline.add(uORM::Mapper<Product>::selectOp(uORM::Query().eq(&Product::id, randomId()).limit(1))));
+        }
+        pipeline.run();
+        uint64_t rows = 0;
+        for (auto& r : results) rows += r.get().size();
+        return rows;
+    }
+
+    Shared& s_;
+    std::mt19937_64 rng_;
+    std::discrete_distribution<int> mix_;
+    std::optional<uORM::CompiledQuery<Product>> byId_;
+    size_t errors_ = 0;
+};
+
+void report(const Shared& shared, double seconds) {
+    std::printf("\n%-10s %10s %10s %8s %9s %9s %9s %9s %9s\n", "op", "ops", "ops/s", "errors", "rows/op", "mean ms",
+                "p50 ms", "p99 ms", "max ms");
+    uint64_t totalOps = 0;
+    for (int i = 0; i < OpCount; ++i) {
+        auto s = shared.stats[i].snapshot();
+        if (s.calls == 0) continue;
+        totalOps += s.calls;
+        std::printf("%-10s %10llu %10.1f %8llu %9.2f %9.3f %9.3f %9.3f %9.3f\n", kOpNames[i],
+                    static_cast<unsigned long long>(s.calls), s.calls / seconds,
+                    static_cast<unsigned long long>(s.errors), static_cast<double>(s.rows) / s.calls,
+                    static_cast<double>(s.totalMicros) / s.calls / 1000.0, s.p50Micros / 1000.0, s.p99Micros / 1000.0,
+                    s.maxMicros / 1000.0);
+    }
+    std::printf("%-10s %10llu %10.1f\n", "total", static_cast<unsigned long long>(totalOps), totalOps / seconds);
+
+    // 配置中开启 metrics 时附带连接池等待时间，用于对比连接池设置
+    if (uORM::Metrics::instance().enabled()) {
+        auto wait = uORM::Metrics::instance().snapshot().poolWait;
+        std::printf("\npool wait: p50 %.3f ms, p99 %.3f ms, max %.3f ms, errors %llu\n", wait.p50Micros / 1000.0,
+                    wait.p99Micros / 1000.0, wait.maxMicros / 1000.0, static_cast<unsigned long long>(wait.errors));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+
+    try {
+        uORM::ConfigManager::getInstance().readDataBaseconfig(opt.config);
+        const auto& db = uORM::ConfigManager::getInstance().databaseconfigdata_;
+        std::printf("driver=%s pool=%d async=%d multi_statements=%d threads=%zu batch=%zu compiled=%d\n",
+                    db.driver_type == uORM::DriverType::PostgreSQL ? "postgresql"
+                        : db.driver_type == uORM::DriverType::SQLite ? "sqlite" : "mysql", db.poolsize, db.async,
+                    db.multi_statements, opt.threads, opt.batch, opt.compiled);
+
+        if (!opt.skipLoad) {
+            auto start = std::chrono::steady_clock::now();
+            load(opt);
+            std::printf("loaded %zu products in %.1f s\n", opt.products,
+                        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::vector<int> ids = productIds();
+        if (ids.empty()) {
+            std::fprintf(stderr, "products table is empty; run without --skip-load\n");
+            return 1;
+        }
+
+        Shared shared(opt, ids);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < opt.threads; ++t) {
+            threads.emplace_back([&shared, t] { Worker(shared, t).run(); });
+        }
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(opt.warmup));
+        uORM::Metrics::instance().reset();
+        shared.measuring = true;
+        auto start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::duration<double>(opt.duration));
+        shared.measuring = false;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        shared.stop = true;
+        for (auto& t : threads) t.join();
+
+        report(shared, seconds);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "workload failed: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
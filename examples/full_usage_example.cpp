@@ -4,6 +4,7 @@
 #include <vector>
 #include <chrono>
 #include <iomanip>
+#include <optional>
 
 // ==========================================
 // 1. 定义数据模型 (Models)
@@ -29,6 +30,7 @@ struct Order {
     double total_amount;
     std::string status; // "PENDING", "PAID", "SHIPPED", "CANCELLED"
     std::string order_time;
+    std::optional<Product> product; // 关联商品 (非数据库列，由 with<&Order::product>() 预加载)
 };
 
 // ==========================================
@@ -54,6 +56,10 @@ UORM_TABLE_BEGIN(Order, "orders")
     UORM_FIELD_TYPE(order_time, "order_time", "DATETIME", DEFAULT CURRENT_TIMESTAMP)
 UORM_TABLE_END()
 
+// 关联声明: Order::product_id -> Product::id
+UORM_RELATIONS(Order,
+    uORM::belongsTo(&Order::product, &Order::product_id, &Product::id))
+
 // ==========================================
 // 3. 辅助函数
 // ==========================================
@@ -69,6 +75,9 @@ void initData() {
     // 初始化产品数据
     uORM::Schema::createTable<Product>();
     uORM::Schema::createTable<Order>();
+#ifdef USE_POSTGRESQL
+    uORM::Schema::installNotifyTrigger<Product>();
+#endif
 
     // 清空旧数据 (仅作演示)
     // 实际生产环境请勿随意 truncate
@@ -131,14 +140,16 @@ void demonstrateQueryBuilder() {
     }
 
     // 场景 4: 复杂逻辑 (A AND (B OR C))
-    // 查找 (Category = 'Home') OR (Price > 1000)
-    // 目前 Query Builder 默认是链式 AND，支持 or_() 切换
+    // 查找在售的 (家居用品 OR 价格大于 1000) 的商品，group 中的条件整体加括号
     {
-        std::cout << "\n[Query 4] 查找 家居用品 OR 价格大于 1000 的商品:" << std::endl;
+        std::cout << "\n[Query 4] 查找在售的 家居用品 OR 价格大于 1000 的商品:" << std::endl;
         uORM::Query query;
-        query.eq("category", "Home")
-             .or_()
-             .gt("price", 1000.0);
+        query.eq("is_active", true)
+             .group([](uORM::Query& g) {
+                 g.eq("category", "Home")
+                  .or_()
+                  .gt("price", 1000.0);
+             });
 
         auto products = uORM::Mapper<Product>::select(query);
         for (const auto& p : products) {
@@ -157,6 +168,21 @@ void demonstrateQueryBuilder() {
              std::cout << "  - ID:" << p.id << " " << p.name << std::endl;
         }
     }
+
+    // 场景 6: 类型化列引用
+    // 列名由 TableMeta 解析，写错成员或绑定类型不匹配的值会在编译期报错
+    {
+        std::cout << "\n[Query 6] 使用成员指针查找在售的电子产品:" << std::endl;
+        uORM::Query query;
+        query.eq<&Product::category>("Electronics")
+             .eq(&Product::is_active, true)
+             .orderBy(&Product::price);
+
+        auto products = uORM::Mapper<Product>::select(query);
+        for (const auto& p : products) {
+            std::cout << "  - " << p.name << " ($" << p.price << ")" << std::endl;
+        }
+    }
 }
 
 void demonstrateCRUD() {
@@ -184,12 +210,55 @@ void demonstrateCRUD() {
             std::cout << "更新成功: 新价格 " << p.price << ", 库存 " << p.stock << std::endl;
         }
 
+        // 按主键读取：第一次查询数据库并回填实体缓存，第二次直接命中缓存
+        uORM::Mapper<Product>::findById(p.id);
+        if (auto cached = uORM::Mapper<Product>::findById(p.id)) {
+            auto stats = uORM::EntityCache<Product>::instance().stats();
+            std::cout << "按主键读取: " << cached->name << " (缓存命中 " << stats.hits << " 次)" << std::endl;
+        }
+
+        // 互不依赖的查询并行执行，各自占用一条连接
+        uORM::Query electronics;
+        electronics.eq(&Product::category, "Electronics");
+        auto [list, total, orders] = uORM::whenAll(
+            uORM::Mapper<Product>::selectAsync(electronics),
+            uORM::Mapper<Product>::countAsync(),
+            uORM::Mapper<Order>::countAsync());
+        std::cout << "并行查询: 电子产品 " << list.size() << " 个, 商品总数 " << total << ", 订单总数 " << orders << std::endl;
+
         // Delete
         // uORM::Mapper<Product>::remove(p);
         // std::cout << "删除成功" << std::endl;
     }
 }
 
+void demonstrateRelations() {
+    std::cout << "\n=== 演示关联预加载 ===" << std::endl;
+
+    uORM::Mapper<Order>::save({0, 1001, 1, 1, 999.99, "PAID", getCurrentTime(), std::nullopt});
+    uORM::Mapper<Order>::save({0, 1001, 3, 2, 39.98, "PENDING", getCurrentTime(), std::nullopt});
+    uORM::Mapper<Order>::save({0, 1002, 1, 1, 999.99, "SHIPPED", getCurrentTime(), std::nullopt});
+
+    // 所有订单的商品通过一条 IN 查询批量加载，而不是每个订单一次 findOne
+    uORM::Query query;
+    query.eq("user_id", 1001);
+    auto orders = uORM::Mapper<Order>::select(query).with<&Order::product>();
+    for (const auto& o : orders) {
+        std::cout << "  - 订单 #" << o.id << " x" << o.quantity << " "
+                  << (o.product ? o.product->name : std::string("(商品不存在)")) << std::endl;
+    }
+
+    // 需要按商品字段过滤订单时使用 JOIN，一次往返同时取回订单和商品
+    std::cout << "\n电子产品的订单 (JOIN):" << std::endl;
+    uORM::Query joinQuery;
+    joinQuery.eq("products.category", "Electronics")
+             .orderBy("orders.id");
+    auto rows = uORM::Mapper<Order>::join<Product>(uORM::on(&Order::product_id, &Product::id), joinQuery);
+    for (const auto& [order, product] : rows) {
+        std::cout << "  - 订单 #" << order.id << " " << product.name << " [" << order.status << "]" << std::endl;
+    }
+}
+
 int main() {
     // 1. 读取配置
     try {
@@ -211,12 +280,39 @@ int main() {
         return 1;
     }
 
+    // 商品读多写少，开启按主键的实体缓存
+    uORM::EntityCacheOptions cacheOptions;
+    cacheOptions.ttl = std::chrono::seconds(30);
+    uORM::EntityCache<Product>::instance().enable(cacheOptions);
+
+    // 分类列表与分页计数重复率很高，开启查询结果缓存；经 Mapper 写入 products 表后自动失效
+    uORM::QueryCacheOptions queryCacheOptions;
+    queryCacheOptions.ttl = std::chrono::seconds(10);
+    uORM::QueryCache<Product>::instance().enable(queryCacheOptions);
+
+#ifdef USE_POSTGRESQL
+    // 其他服务直接写库时，由触发器发出通知，后台监听线程据此驱逐本进程缓存
+    uORM::CacheInvalidationListener::instance().subscribe<Product>();
+    uORM::CacheInvalidationListener::instance().start();
+#endif
+
+#ifdef USE_REDIS
+    // 多实例部署时在进程内缓存与数据库之间加一层共享的 Redis 缓存
+    try {
+        uORM::ConfigManager::getInstance().readRedisconfig("config.json");
+        uORM::RedisCache<Product>::instance().enable();
+    } catch (const uORM::Exception& e) {
+        std::cerr << "Redis 缓存未开启: " << e.what() << std::endl;
+    }
+#endif
+
     // 3. 初始化表和数据
     initData();
 
     // 4. 运行演示
     demonstrateCRUD();
     demonstrateQueryBuilder();
+    demonstrateRelations();
 
     return 0;
 }
@@ -1,6 +1,7 @@
 #pragma once 
 #include <string> 
 #include <vector>
+#include <map>
 #include <fstream>
 #include <uJSON/ujson.h>
 #include "uORM/orm/Error.h"
@@ -9,10 +10,20 @@ using json = uJSON::Value;
 
 namespace uORM { 
 
+// 默认数据库 (DataBaseConfig 段) 与默认连接池的名字
+inline constexpr const char* DefaultDataBase = "default";
+
 // 驱动类型枚举
 enum class DriverType {
     MySQL,
-    PostgreSQL
+    PostgreSQL,
+    SQLite
+};
+
+// 读语句在只读副本间的分配方式
+enum class ReplicaRouting {
+    RoundRobin,        // 轮询
+    LeastOutstanding   // 选择已借出连接最少的副本
 };
 
 // 配置基类，定义了读取各种配置文件的接口
@@ -38,21 +49,46 @@ struct DataBaseConfigData {
     std::string password; // 密码
     std::string dataname; // 数据库名
     int poolsize;         // 连接池大小
+    bool async = false;   // PostgreSQL 使用基于 epoll 的非阻塞驱动 (PgAsyncConnection)
+    bool multi_statements = false; // MySQL 开启 CLIENT_MULTI_STATEMENTS，Pipeline 可一次发送多条语句
+    bool metrics = false; // 启动时开启执行统计 (Metrics)，也可以运行时通过 Metrics::setEnabled 切换
+    int slow_query_ms = 0; // 慢查询日志阈值 (毫秒)，0 表示关闭
+    int statement_cache = 256; // 每条连接缓存的预编译语句数量 (prepareCached)，超出时淘汰最久未使用的
+    bool slow_query_explain = false; // 慢查询按语句形状限频采集 EXPLAIN
+    int sqlite_busy_timeout_ms = 5000; // SQLite 写冲突时的等待时间
+    int sqlite_statement_cache = 64;   // SQLite 每条连接缓存的预编译语句数量，0 表示不缓存
+    std::vector<DataBaseConfigData> replicas; // 只读副本，Mapper 的查询分配到副本，写入留在本库
+    ReplicaRouting replica_routing = ReplicaRouting::RoundRobin;
+    int replica_max_lag_ms = 1000;     // 复制延迟超过该值的副本暂不使用，0 表示不按延迟排除
+    int replica_check_ms = 1000;       // 检查副本连通性与复制延迟的间隔
     
     // 检查配置是否有效
     bool isValid() const { 
-        return !hostname.empty() && (port > 0 && port < 65535) && !username.empty() && !password.empty() && !dataname.empty() && poolsize > 0; 
+        // SQLite 只需要数据库文件路径 (dataname)
+        if (driver_type == DriverType::SQLite) {
+            return !dataname.empty() && poolsize > 0 && sqlite_busy_timeout_ms >= 0 && sqlite_statement_cache >= 0;
+        }
+        return !hostname.empty() && (port > 0 && port < 65535) && !username.empty() && !password.empty() && !dataname.empty() && poolsize > 0 && statement_cache > 0; 
     } 
+
+    // PostgreSQL 连接字符串: "host=... port=... dbname=... user=... password=..."
+    std::string postgresConnectionString() const {
+        return "host=" + hostname + 
+               " port=" + std::to_string(port) + 
+               " dbname=" + dataname + 
+               " user=" + username + 
+               " password=" + password; 
+    }
 }; 
 
 // Redis配置数据结构
 struct RedisConfigData { 
-    std::string hostname; // 主机地址
-    int port;             // 端口号
-    std::string password; // 密码
-    int poolsize;         // 连接池大小
-    int timeout_seconds;  // 超时时间(秒)
-    int database_index;   // 数据库索引
+    std::string hostname;    // 主机地址
+    int port = 6379;         // 端口号
+    std::string password;    // 密码
+    int poolsize = 0;        // 连接池大小
+    int timeout_seconds = 1; // 超时时间(秒)，0 表示不限制
+    int database_index = 0;  // 数据库索引
     
     // 检查配置是否有效
     bool isValid() const { 
@@ -94,38 +130,27 @@ public:
             if (!j.at("DataBaseConfig").is_object()) {
                 throw ConfigurationError("'DataBaseConfig' must be an object");
             }
-            const json db = j.at("DataBaseConfig"); 
-            
-            // 验证每个配置项的存在性和类型
-            if (!db.contains("hostname") || !db.at("hostname").is_string()) throw ConfigurationError("Missing or invalid 'hostname'");
-            if (!db.contains("username") || !db.at("username").is_string()) throw ConfigurationError("Missing or invalid 'username'");
-            if (!db.contains("password") || !db.at("password").is_string()) throw ConfigurationError("Missing or invalid 'password'");
-            if (!db.contains("dataname") || !db.at("dataname").is_string()) throw ConfigurationError("Missing or invalid 'dataname'");
-            if (!db.contains("port") || !db.at("port").is_number_integer()) throw ConfigurationError("Missing or invalid 'port'");
-            if (!db.contains("poolsize") || !db.at("poolsize").is_number_integer()) throw ConfigurationError("Missing or invalid 'poolsize'");
-
-            // 读取驱动类型，默认为 mysql
-            if (db.contains("driver") && db.at("driver").is_string()) {
-                std::string drv = db.at("driver").get<std::string>();
-                if (drv == "postgres" || drv == "postgresql") {
-                    databaseconfigdata_.driver_type = DriverType::PostgreSQL;
-                } else {
-                    databaseconfigdata_.driver_type = DriverType::MySQL;
-                }
-            } else {
-                databaseconfigdata_.driver_type = DriverType::MySQL;
-            }
+            databaseconfigdata_ = parseDataBaseSection(j.at("DataBaseConfig"));
 
-            // 填充配置数据
-            databaseconfigdata_.hostname = db.at("hostname").get<std::string>(); 
-            databaseconfigdata_.port = db.at("port").get<int>(); 
-            databaseconfigdata_.username = db.at("username").get<std::string>(); 
-            databaseconfigdata_.password = db.at("password").get<std::string>(); 
-            databaseconfigdata_.dataname = db.at("dataname").get<std::string>(); 
-            databaseconfigdata_.poolsize = db.at("poolsize").get<int>(); 
-            
-            if (!databaseconfigdata_.isValid()) {
-                throw ConfigurationError("Invalid database configuration values");
+            // 可选项：命名数据库，每项与 DataBaseConfig 格式相同并带有 "name"
+            if (j.contains("DataBases")) {
+                if (!j.at("DataBases").is_array()) throw ConfigurationError("'DataBases' must be an array");
+                const json list = j.at("DataBases");
+                std::map<std::string, DataBaseConfigData> named;
+                for (size_t i = 0; i < list.size(); ++i) {
+                    const json db = list.at(i);
+                    if (!db.is_object()) throw ConfigurationError("'DataBases' entries must be objects");
+                    if (!db.contains("name") || !db.at("name").is_string()) throw ConfigurationError("Missing or invalid 'name' in 'DataBases'");
+                    std::string name = db.at("name").get<std::string>();
+                    if (name.empty() || name == DefaultDataBase) throw ConfigurationError("Invalid database name '" + name + "'");
+                    if (named.count(name)) throw ConfigurationError("Duplicate database name '" + name + "'");
+                    try {
+                        named.emplace(name, parseDataBaseSection(db));
+                    } catch (const ConfigurationError& e) {
+                        throw ConfigurationError("Database '" + name + "': " + e.what());
+                    }
+                }
+                databaseconfigs_ = std::move(named);
             }
         } catch (const uJSON::ParseError& e) {
             throw ConfigurationError(std::string("JSON Parse Error in ") + path + ": " + e.what());
@@ -136,6 +161,16 @@ public:
         } 
     }
 
+    // 按名字取数据库配置，DefaultDataBase 对应 DataBaseConfig 段，其余来自 DataBases；未配置的名字抛出 ConfigurationError
+    const DataBaseConfigData& databaseConfig(const std::string& name) const {
+        if (name == DefaultDataBase) return databaseconfigdata_;
+        auto it = databaseconfigs_.find(name);
+        if (it == databaseconfigs_.end()) {
+            throw ConfigurationError("No database configured with name '" + name + "'");
+        }
+        return it->second;
+    }
+
     virtual void readRedisconfig(const std::string& path) override {
         std::ifstream f(path); 
         if (!f.is_open()) {
@@ -166,6 +201,16 @@ public:
             redisconfigdata_.port = r.at("port").get<int>(); 
             redisconfigdata_.password = r.at("password").get<std::string>(); 
             redisconfigdata_.poolsize = r.at("poolsize").get<int>(); 
+
+            // 可选项：超时时间与数据库索引
+            if (r.contains("timeout")) {
+                if (!r.at("timeout").is_number_integer()) throw ConfigurationError("Redis invalid 'timeout'");
+                redisconfigdata_.timeout_seconds = r.at("timeout").get<int>();
+            }
+            if (r.contains("database_index")) {
+                if (!r.at("database_index").is_number_integer()) throw ConfigurationError("Redis invalid 'database_index'");
+                redisconfigdata_.database_index = r.at("database_index").get<int>();
+            }
             
             if (!redisconfigdata_.isValid()) {
                 throw ConfigurationError("Invalid Redis configuration values");
@@ -190,6 +235,7 @@ public:
 public: 
     // 公开的配置数据成员
     DataBaseConfigData databaseconfigdata_; 
+    std::map<std::string, DataBaseConfigData> databaseconfigs_; // 命名数据库 (DataBases)，不含默认数据库
     RedisConfigData redisconfigdata_; 
     JWTConfigData jwtconfigdata_; 
     EmailConfigData emailconfigdata_; 
@@ -197,5 +243,146 @@ public:
 private: 
     // 私有构造函数
     ConfigManager() = default; 
+
+    // 解析一个数据库配置对象 (DataBaseConfig 段或 DataBases 中的一项) 并校验
+    static DataBaseConfigData parseDataBaseSection(const json& db) {
+        DataBaseConfigData config;
+
+        // 读取驱动类型，默认为 mysql
+        if (db.contains("driver") && db.at("driver").is_string()) {
+            std::string drv = db.at("driver").get<std::string>();
+            if (drv == "postgres" || drv == "postgresql") {
+                config.driver_type = DriverType::PostgreSQL;
+            } else if (drv == "sqlite" || drv == "sqlite3") {
+                config.driver_type = DriverType::SQLite;
+            } else {
+                config.driver_type = DriverType::MySQL;
+            }
+        } else {
+            config.driver_type = DriverType::MySQL;
+        }
+        const bool embedded = config.driver_type == DriverType::SQLite;
+
+        // 验证每个配置项的存在性和类型；SQLite 不需要主机、端口与账号
+        if (!embedded) {
+            if (!db.contains("hostname") || !db.at("hostname").is_string()) throw ConfigurationError("Missing or invalid 'hostname'");
+            if (!db.contains("username") || !db.at("username").is_string()) throw ConfigurationError("Missing or invalid 'username'");
+            if (!db.contains("password") || !db.at("password").is_string()) throw ConfigurationError("Missing or invalid 'password'");
+            if (!db.contains("port") || !db.at("port").is_number_integer()) throw ConfigurationError("Missing or invalid 'port'");
+        }
+        if (!db.contains("dataname") || !db.at("dataname").is_string()) throw ConfigurationError("Missing or invalid 'dataname'");
+        if (!db.contains("poolsize") || !db.at("poolsize").is_number_integer()) throw ConfigurationError("Missing or invalid 'poolsize'");
+
+        // 填充配置数据
+        if (!embedded) {
+            config.hostname = db.at("hostname").get<std::string>(); 
+            config.port = db.at("port").get<int>(); 
+            config.username = db.at("username").get<std::string>(); 
+            config.password = db.at("password").get<std::string>(); 
+        }
+        config.dataname = db.at("dataname").get<std::string>(); 
+        config.poolsize = db.at("poolsize").get<int>(); 
+
+        // 可选项：非阻塞驱动，仅 PostgreSQL 支持
+        if (db.contains("async")) {
+            if (!db.at("async").is_boolean()) throw ConfigurationError("Invalid 'async'");
+            config.async = db.at("async").get<bool>();
+        }
+        // 可选项：多语句流水线，仅 MySQL 使用
+        if (db.contains("multi_statements")) {
+            if (!db.at("multi_statements").is_boolean()) throw ConfigurationError("Invalid 'multi_statements'");
+            config.multi_statements = db.at("multi_statements").get<bool>();
+        }
+        // 可选项：执行统计
+        if (db.contains("metrics")) {
+            if (!db.at("metrics").is_boolean()) throw ConfigurationError("Invalid 'metrics'");
+            config.metrics = db.at("metrics").get<bool>();
+        }
+        // 可选项：慢查询日志
+        if (db.contains("slow_query_ms")) {
+            if (!db.at("slow_query_ms").is_number() || db.at("slow_query_ms").get<int>() < 0) throw ConfigurationError("Invalid 'slow_query_ms'");
+            config.slow_query_ms = db.at("slow_query_ms").get<int>();
+        }
+        if (db.contains("slow_query_explain")) {
+            if (!db.at("slow_query_explain").is_boolean()) throw ConfigurationError("Invalid 'slow_query_explain'");
+            config.slow_query_explain = db.at("slow_query_explain").get<bool>();
+        }
+        if (db.contains("statement_cache")) {
+            if (!db.at("statement_cache").is_number_integer() || db.at("statement_cache").get<int>() <= 0) throw ConfigurationError("Invalid 'statement_cache'");
+            config.statement_cache = db.at("statement_cache").get<int>();
+        }
+        // 可选项：SQLite
+        if (db.contains("sqlite_busy_timeout_ms")) {
+            if (!db.at("sqlite_busy_timeout_ms").is_number_integer()) throw ConfigurationError("Invalid 'sqlite_busy_timeout_ms'");
+            config.sqlite_busy_timeout_ms = db.at("sqlite_busy_timeout_ms").get<int>();
+        }
+        if (db.contains("sqlite_statement_cache")) {
+            if (!db.at("sqlite_statement_cache").is_number_integer()) throw ConfigurationError("Invalid 'sqlite_statement_cache'");
+            config.sqlite_statement_cache = db.at("sqlite_statement_cache").get<int>();
+        }
+        
+        // 可选项：只读副本，每项未填写的字段沿用主库的配置
+        if (db.contains("replicas")) {
+            if (!db.at("replicas").is_array()) throw ConfigurationError("'replicas' must be an array");
+            if (config.driver_type == DriverType::SQLite) throw ConfigurationError("'replicas' is not supported by the sqlite driver");
+            const json list = db.at("replicas");
+            for (size_t i = 0; i < list.size(); ++i) {
+                const json r = list.at(i);
+                if (!r.is_object()) throw ConfigurationError("'replicas' entries must be objects");
+                DataBaseConfigData replica = config;
+                replica.replicas.clear();
+                if (r.contains("hostname")) {
+                    if (!r.at("hostname").is_string()) throw ConfigurationError("Replica invalid 'hostname'");
+                    replica.hostname = r.at("hostname").get<std::string>();
+                }
+                if (r.contains("port")) {
+                    if (!r.at("port").is_number_integer()) throw ConfigurationError("Replica invalid 'port'");
+                    replica.port = r.at("port").get<int>();
+                }
+                if (r.contains("username")) {
+                    if (!r.at("username").is_string()) throw ConfigurationError("Replica invalid 'username'");
+                    replica.username = r.at("username").get<std::string>();
+                }
+                if (r.contains("password")) {
+                    if (!r.at("password").is_string()) throw ConfigurationError("Replica invalid 'password'");
+                    replica.password = r.at("password").get<std::string>();
+                }
+                if (r.contains("dataname")) {
+                    if (!r.at("dataname").is_string()) throw ConfigurationError("Replica invalid 'dataname'");
+                    replica.dataname = r.at("dataname").get<std::string>();
+                }
+                if (r.contains("poolsize")) {
+                    if (!r.at("poolsize").is_number_integer()) throw ConfigurationError("Replica invalid 'poolsize'");
+                    replica.poolsize = r.at("poolsize").get<int>();
+                }
+                if (!replica.isValid()) throw ConfigurationError("Invalid replica configuration values");
+                config.replicas.push_back(std::move(replica));
+            }
+        }
+        if (db.contains("replica_routing")) {
+            if (!db.at("replica_routing").is_string()) throw ConfigurationError("Invalid 'replica_routing'");
+            std::string routing = db.at("replica_routing").get<std::string>();
+            if (routing == "round_robin") {
+                config.replica_routing = ReplicaRouting::RoundRobin;
+            } else if (routing == "least_outstanding") {
+                config.replica_routing = ReplicaRouting::LeastOutstanding;
+            } else {
+                throw ConfigurationError("Invalid 'replica_routing': " + routing);
+            }
+        }
+        if (db.contains("replica_max_lag_ms")) {
+            if (!db.at("replica_max_lag_ms").is_number_integer() || db.at("replica_max_lag_ms").get<int>() < 0) throw ConfigurationError("Invalid 'replica_max_lag_ms'");
+            config.replica_max_lag_ms = db.at("replica_max_lag_ms").get<int>();
+        }
+        if (db.contains("replica_check_ms")) {
+            if (!db.at("replica_check_ms").is_number_integer() || db.at("replica_check_ms").get<int>() <= 0) throw ConfigurationError("Invalid 'replica_check_ms'");
+            config.replica_check_ms = db.at("replica_check_ms").get<int>();
+        }
+        
+        if (!config.isValid()) {
+            throw ConfigurationError("Invalid database configuration values");
+        }
+        return config;
+    }
 }; 
 } // namespace uORM 
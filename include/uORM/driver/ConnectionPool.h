@@ -1,19 +1,36 @@
 #pragma once 
 // 文件说明： 
 // ConnectionPool 提供通用的数据库连接池实现。 
-// 支持 MySQL 和 PostgreSQL，通过配置自动选择驱动。 
+// 支持 MySQL、PostgreSQL 和 SQLite，通过配置自动选择驱动。 
+// 除默认连接池外，配置文件 DataBases 中的每个数据库各有一个命名连接池，方言按各自的驱动确定；
+// 实体用 UORM_TABLE_POOL 绑定到命名池，调用点用 PoolScope 临时切换。 
+// 配置了只读副本 (replicas) 的连接池为每个副本创建一个子连接池，readPool() 为读语句选择副本， 
+// 后台线程按 replica_check_ms 检查副本的连通性与复制延迟，延迟超过 replica_max_lag_ms 的副本暂不使用。 
 
 #include "uORM/driver/DBInterfaces.h" 
 #include "uORM/driver/SqlDialect.h" 
 #include "uORM/driver/ConfigManager.h" 
 #include "uORM/orm/Error.h"
+#include "uORM/orm/Logger.h"
+#include "uORM/orm/Metrics.h"
+#include "uORM/orm/Tracing.h"
+#include "uORM/orm/Reflection.h"
 #include <functional> 
 #include <queue> 
 #include <mutex> 
 #include <condition_variable> 
 #include <memory> 
+#include <optional> 
 #include <string> 
-#include <iostream>
+#include <map> 
+#include <atomic> 
+#include <chrono> 
+#include <climits> 
+#include <cmath> 
+#include <cstdlib> 
+#include <thread> 
+#include <typeinfo>
+#include <vector> 
 
 // 条件包含驱动头文件
 #ifdef USE_MYSQL
@@ -29,19 +46,66 @@
 
 #ifdef USE_POSTGRESQL
 #include "uORM/driver/postgresql/PostgreSQLWrapper.h" 
+#include "uORM/driver/postgresql/PgAsyncDriver.h" 
+#endif
+
+#ifdef USE_SQLITE
+#include "uORM/driver/sqlite/SQLiteWrapper.h" 
 #endif
 
 namespace uORM { 
 class ConnectionPool { 
 public: 
-    // 获取连接池单例实例 
+    static constexpr const char* DefaultName = DefaultDataBase; 
+
+    // 获取默认连接池单例实例 (配置中的 DataBaseConfig 段) 
     static ConnectionPool& instance() {
-        static ConnectionPool inst; 
+        static ConnectionPool inst(DefaultName, ConfigManager::getInstance().databaseconfigdata_, true); 
         return inst; 
     }
+
+    // 获取命名连接池，首次调用时按 ConfigManager::databaseConfig(name) 创建；未配置的名字抛出 ConfigurationError 
+    static ConnectionPool& instance(const std::string& name) {
+        if (name.empty() || name == DefaultName) return instance(); 
+        auto& reg = registry(); 
+        std::lock_guard<std::mutex> lock(reg.mutex); 
+        auto it = reg.pools.find(name); 
+        if (it != reg.pools.end()) return *it->second; 
+        const auto& config = ConfigManager::getInstance().databaseConfig(name); 
+        auto* pool = new ConnectionPool(name, config, false); 
+        reg.pools.emplace(name, pool); 
+        return *pool; 
+    }
+
+    // 实体 T 应使用的连接池：PoolScope 设置的当前池优先，其次是 UORM_TABLE_POOL 绑定的命名池，否则为默认池 
+    template<typename T> 
+    static ConnectionPool& forType(); 
+
+    // 实体 T 的读语句使用的连接池：forType<T>() 配置了只读副本时为 readPool() 选出的副本，primary 为 true 时固定为主库 
+    template<typename T> 
+    static ConnectionPool& forRead(bool primary = false) { 
+        auto& pool = forType<T>(); 
+        return primary ? pool : pool.readPool(); 
+    } 
     
+    using Handle = std::unique_ptr<IConnection, std::function<void(IConnection*)>>; 
+    using ConnectionFactory = std::function<IConnection*()>; 
+
+    // 用自定义的建连函数代替配置中的驱动 (如基准测试使用的内存驱动)，连接池大小仍取自配置。 
+    // 必须在首次调用 instance() 之前设置，连接池创建之后调用抛出 ConfigurationError 
+    static void setConnectionFactory(ConnectionFactory factory, std::shared_ptr<ISqlDialect> dialect) { 
+        auto& injected = injection(); 
+        if (injected.created) throw ConfigurationError("ConnectionPool already created; set the connection factory before first use"); 
+        if (!factory || !dialect) throw ConfigurationError("Connection factory and dialect must not be empty"); 
+        injected.factory = std::move(factory); 
+        injected.dialect = std::move(dialect); 
+    } 
+
     // 获取连接（使用std::unique_ptr与自定义删除器实现RAII归还） 
-    std::unique_ptr<IConnection, std::function<void(IConnection*)>> getConnection() { 
+    Handle getConnection() { 
+        auto& metrics = Metrics::instance(); 
+        MetricsTimer waitTimer(metrics.enabled() ? &metrics.poolWait() : nullptr); 
+        TraceSpan span(SpanKind::Acquire, "pool.acquire"); 
         std::unique_lock<std::mutex> lock(mutex_); 
         // 简单的等待策略，如果池空了就等 
         // 实际生产中可能需要超时机制或动态扩容 
@@ -49,6 +113,7 @@ public:
             // 如果队列为空，尝试创建一个新连接（应对突发流量或初始化失败的情况） 
             auto conn = createRawConnection(); 
             if (conn && conn->isValid()) { 
+                 outstanding_.fetch_add(1, std::memory_order_relaxed); 
                  auto deleter = [this](IConnection* c){ releaseConnection(c); }; 
                  return std::unique_ptr<IConnection, decltype(deleter)>(conn, deleter); 
             } 
@@ -58,6 +123,7 @@ public:
         
         auto conn = connections_.front(); 
         connections_.pop(); 
+        outstanding_.fetch_add(1, std::memory_order_relaxed); 
         lock.unlock(); 
         
         // 检查有效性 
@@ -66,6 +132,7 @@ public:
             conn = createRawConnection(); 
             if (!conn || !conn->isValid()) { 
                 if(conn) delete conn; 
+                outstanding_.fetch_sub(1, std::memory_order_relaxed); 
                 throw ConnectionError("Failed to obtain valid DB connection"); 
             } 
         } 
@@ -79,37 +146,119 @@ public:
         return dialect_; 
     }
 
+    // 方言的裸指针，与连接池同生命周期；Mapper 每次调用都要取方言，避免 shared_ptr 拷贝的原子引用计数
+    const ISqlDialect* dialect() const {
+        return dialect_.get();
+    }
+
+    // 连接池名字，默认池为 DefaultName 
+    const std::string& name() const { return name_; } 
+
+    // 创建连接池时使用的数据库配置 
+    const DataBaseConfigData& config() const { return config_; } 
+
+    // 已借出尚未归还的连接数 
+    int outstanding() const { return outstanding_.load(std::memory_order_relaxed); } 
+
+    // 读语句使用的连接池：配置了只读副本且当前线程没有 PrimaryReadScope 时，按 replica_routing 选择一个可用的副本； 
+    // 没有可用副本时回退到本库。写入与事务应直接使用本库的 getConnection() 
+    ConnectionPool& readPool(); 
+
+    // 只读副本的状态，lagMs 为最近一次检查得到的复制延迟，-1 表示未知 (连接失败或复制已停止) 
+    struct ReplicaStatus { 
+        std::string name; 
+        bool available; 
+        long long lagMs; 
+        int outstanding; 
+    }; 
+
+    std::vector<ReplicaStatus> replicaStatus() const { 
+        std::vector<ReplicaStatus> status; 
+        for (const auto& replica : replicas_) { 
+            status.push_back({replica->pool->name(), replica->available.load(std::memory_order_acquire), 
+                              replica->lagMs.load(std::memory_order_relaxed), replica->pool->outstanding()}); 
+        } 
+        return status; 
+    } 
+
+    // 立即检查一次各副本的连通性与复制延迟 (后台线程按 replica_check_ms 定期调用) 
+    void checkReplicas() { 
+        std::lock_guard<std::mutex> lock(checkMutex_); 
+        for (auto& replica : replicas_) checkReplica(*replica); 
+    } 
+
+    // StaticDriver 在每个连接池上只核对一次驱动类型，核对通过后记下策略的标记 
+    const void* verifiedPolicy() const { return verifiedPolicy_.load(std::memory_order_acquire); } 
+    void setVerifiedPolicy(const void* tag) { verifiedPolicy_.store(tag, std::memory_order_release); } 
+
+    // 各只读副本的子连接池 
+    std::vector<const ConnectionPool*> replicaPools() const {
+        std::vector<const ConnectionPool*> pools;
+        for (const auto& replica : replicas_) pools.push_back(replica->pool);
+        return pools;
+    }
+
+    // StaticDriver 核对本库后设置：副本的连接必须是该类型，检查时类型不符的副本被排除，不会被 readPool() 选中。
+    // 设置后立即重新检查一次，当前可用的副本在返回前完成核对
+    void requireReplicaConnection(const std::type_info& type) {
+        if (replicas_.empty()) return;
+        requiredConnection_.store(&type, std::memory_order_release);
+        checkReplicas();
+    }
+
     // 禁止拷贝与赋值 
     ConnectionPool(const ConnectionPool&) = delete; 
     ConnectionPool& operator=(const ConnectionPool&) = delete; 
 private: 
-    // 构造函数 
-    ConnectionPool() { 
-        // 加载配置 
-        config_ = ConfigManager::getInstance().databaseconfigdata_; 
+    // 构造函数；setConnectionFactory 注入的驱动只作用于默认连接池 
+    ConnectionPool(std::string name, DataBaseConfigData config, bool useInjection) 
+        : config_(std::move(config)), name_(std::move(name)) { 
+        auto& injected = injection(); 
+        if (useInjection) injected.created = true; 
         
         // 初始化方言 
         // 根据宏定义决定默认方言，或运行时检查
-        if (config_.driver_type == DriverType::PostgreSQL) { 
+        if (useInjection && injected.factory) { 
+            factory_ = injected.factory; 
+            dialect_ = injected.dialect; 
+        } else if (config_.driver_type == DriverType::PostgreSQL) { 
     #ifdef USE_POSTGRESQL
             dialect_ = std::make_shared<PostgreSQLDialect>(); 
     #else
-            std::cerr << "Error: PostgreSQL driver not compiled in!" << std::endl;
+            Logger::error("PostgreSQL driver not compiled in!");
             // Fallback or throw? For now just log.
+    #endif
+        } else if (config_.driver_type == DriverType::SQLite) { 
+    #ifdef USE_SQLITE
+            dialect_ = std::make_shared<SQLiteDialect>(); 
+            // 每个连接池使用独立的内存数据库，池内连接共享
+            if (config_.dataname == ":memory:") config_.dataname = SQLiteConnection::newMemoryDatabase();
+    #else
+            Logger::error("SQLite driver not compiled in!");
     #endif
         } else { 
     #ifdef USE_MYSQL
             dialect_ = std::make_shared<MySQLDialect>(); 
     #else
-            std::cerr << "Error: MySQL driver not compiled in!" << std::endl;
+            Logger::error("MySQL driver not compiled in!");
     #endif
         } 
         
         initializePool(); 
+        initializeReplicas(); 
     }
 
-    // 析构函数：安全释放池中所有连接 
+    // 析构函数：先停止副本检查线程，再安全释放池中所有连接 
     ~ConnectionPool() { 
+        if (monitor_.joinable()) { 
+            { 
+                std::lock_guard<std::mutex> lock(monitorMutex_); 
+                stopping_ = true; 
+            } 
+            monitorCond_.notify_all(); 
+            monitor_.join(); 
+        } 
+        replicas_.clear(); 
         std::lock_guard<std::mutex> lock(mutex_); 
         while (!connections_.empty()) { 
             auto conn = connections_.front(); 
@@ -118,17 +267,38 @@ private:
         } 
     }
     
-    // 创建新连接的辅助函数 
+    // 创建新连接的辅助函数，记录建连耗时 
     IConnection* createRawConnection() { 
+        auto& metrics = Metrics::instance(); 
+        MetricsTimer timer(metrics.enabled() ? &metrics.poolConnect() : nullptr); 
+        TraceSpan span(SpanKind::Connect, "pool.connect"); 
+        IConnection* conn = openConnection(); 
+        if (!conn || !conn->isValid()) { 
+            timer.fail(); 
+            span.fail(); 
+        } 
+        if (conn) conn->setStatementCacheCapacity(static_cast<size_t>(config_.statement_cache)); 
+        return conn; 
+    }
+
+    // 按配置的驱动打开一条数据库连接 
+    IConnection* openConnection() { 
+        if (factory_) { 
+            return factory_(); 
+        } 
         if (config_.driver_type == DriverType::PostgreSQL) { 
     #ifdef USE_POSTGRESQL
-            // 构建 PG 连接字符串: "host=... port=... dbname=... user=... password=..." 
-            std::string connStr = "host=" + config_.hostname + 
-                                  " port=" + std::to_string(config_.port) + 
-                                  " dbname=" + config_.dataname + 
-                                  " user=" + config_.username + 
-                                  " password=" + config_.password; 
-            return new PostgreSQLConnection(connStr); 
+            if (config_.async) { 
+                return new PgAsyncConnection(config_.postgresConnectionString()); 
+            } 
+            return new PostgreSQLConnection(config_.postgresConnectionString()); 
+    #else
+            return nullptr;
+    #endif
+        } else if (config_.driver_type == DriverType::SQLite) { 
+    #ifdef USE_SQLITE
+            return new SQLiteConnection(config_.dataname, config_.sqlite_busy_timeout_ms, 
+                                        static_cast<size_t>(config_.sqlite_statement_cache)); 
     #else
             return nullptr;
     #endif
@@ -137,24 +307,35 @@ private:
     #ifdef USE_MYSQL
             try { 
                 sql::Driver* driver = get_driver_instance(); 
-                auto* conn = driver->connect(config_.hostname + ":" + std::to_string(config_.port), 
-                                             config_.username, config_.password); 
+                sql::Connection* conn = nullptr; 
+                if (config_.multi_statements) { 
+                    // 多语句只在显式开启时启用，避免扩大拼接 SQL 时的注入影响面 
+                    sql::ConnectOptionsMap options; 
+                    options["hostName"] = sql::SQLString(config_.hostname + ":" + std::to_string(config_.port)); 
+                    options["userName"] = sql::SQLString(config_.username); 
+                    options["password"] = sql::SQLString(config_.password); 
+                    options["CLIENT_MULTI_STATEMENTS"] = true; 
+                    conn = driver->connect(options); 
+                } else { 
+                    conn = driver->connect(config_.hostname + ":" + std::to_string(config_.port), 
+                                           config_.username, config_.password); 
+                } 
                 // 创建连接后，尝试设置 schema，或者在连接字符串中指定 (connect 只有 host, user, pass)
                 // setSchema(config_.dataname) 应该在 connect 后调用
                 // 但是 MySQLWrapper 中封装了 setSchema 逻辑。
                 // 这里我们直接创建 Wrapper，然后调用 setSchema
-                auto* wrapper = new MySQLConnection(conn);
+                auto* wrapper = new MySQLConnection(conn, config_.multi_statements);
                 try {
                     wrapper->setSchema(config_.dataname);
                 } catch (const std::exception& e) {
                      // 如果数据库不存在，可能需要先创建？
                      // 或者直接抛出
-                     std::cerr << "Warning: Failed to select database '" << config_.dataname << "': " << e.what() << std::endl;
+                     Logger::warn("Failed to select database '", config_.dataname, "': ", e.what());
                      // 如果是为了 create database，这里可能允许失败
                 }
                 return wrapper;
             } catch (const std::exception& e) { 
-                std::cerr << "MySQL Connect Error: " << e.what() << std::endl; 
+                Logger::error("MySQL Connect Error: ", e.what()); 
                 return nullptr; 
             } 
     #else
@@ -170,7 +351,7 @@ private:
             if (conn && conn->isValid()) { 
                 connections_.push(conn); 
             } else { 
-                std::cerr << "Failed to create initial connection #" << i << std::endl; 
+                Logger::error("Failed to create initial connection #", i); 
                 if (conn) delete conn; 
             } 
         } 
@@ -182,10 +363,137 @@ private:
             // 可以在这里做一些重置操作，如回滚未提交事务 
             std::lock_guard<std::mutex> lock(mutex_); 
             connections_.push(conn); 
+            outstanding_.fetch_sub(1, std::memory_order_relaxed); 
             cond_.notify_one(); 
         } 
     }
 
+    // 只读副本：子连接池、检查用的专用连接与最近一次检查的结果 
+    struct Replica { 
+        ConnectionPool* pool = nullptr; 
+        std::unique_ptr<IConnection> probe; 
+        std::atomic<bool> available{false}; 
+        std::atomic<long long> lagMs{-1}; 
+        ~Replica() { delete pool; } 
+    }; 
+
+    // 为每个副本创建子连接池，同步检查一次后启动后台检查线程 
+    void initializeReplicas() { 
+        for (size_t i = 0; i < config_.replicas.size(); ++i) { 
+            auto replica = std::make_unique<Replica>(); 
+            DataBaseConfigData config = config_.replicas[i]; 
+            config.replicas.clear(); 
+            replica->pool = new ConnectionPool(name_ + "#replica" + std::to_string(i + 1), std::move(config), false); 
+            replicas_.push_back(std::move(replica)); 
+        } 
+        if (replicas_.empty()) return; 
+        checkReplicas(); 
+        monitor_ = std::thread([this] { 
+            std::unique_lock<std::mutex> lock(monitorMutex_); 
+            while (!monitorCond_.wait_for(lock, std::chrono::milliseconds(config_.replica_check_ms), [this] { return stopping_; })) { 
+                lock.unlock(); 
+                checkReplicas(); 
+                lock.lock(); 
+            } 
+        }); 
+    } 
+
+    // 在专用连接上查询复制延迟；连接失败、延迟未知或超过 replica_max_lag_ms 时排除该副本 
+    void checkReplica(Replica& replica) { 
+        long long lag = -1; 
+        std::string error; 
+        try { 
+            if (!replica.probe || !replica.probe->isValid()) { 
+                replica.probe.reset(replica.pool->createRawConnection()); 
+            } 
+            const std::type_info* required = requiredConnection_.load(std::memory_order_acquire);
+            if (!replica.probe || !replica.probe->isValid()) { 
+                error = "connection failed"; 
+            } else if (required && typeid(*replica.probe) != *required) {
+                error = std::string("connection type ") + typeid(*replica.probe).name() + " does not match the compile-time driver policy";
+            } else { 
+                const ISqlDialect* dialect = replica.pool->dialect(); 
+                std::string sql = dialect ? dialect->replicaLagSql() : ""; 
+                if (sql.empty()) { 
+                    lag = 0; 
+                } else { 
+                    auto res = replica.probe->createStatement()->executeQuery(sql); 
+                    if (!res->next()) { 
+                        error = "replication status unavailable";   // 未配置复制 (MySQL 没有复制状态) 
+                    } else { 
+                        std::string value = res->getString(dialect->replicaLagColumn()); 
+                        if (value.empty()) { 
+                            error = "replication lag unknown"; 
+                        } else { 
+                            lag = std::llround(std::strtod(value.c_str(), nullptr) * 1000.0); 
+                        } 
+                    } 
+                } 
+            } 
+        } catch (const std::exception& e) { 
+            replica.probe.reset(); 
+            error = e.what(); 
+        } 
+
+        bool available = lag >= 0 && (config_.replica_max_lag_ms == 0 || lag <= config_.replica_max_lag_ms); 
+        replica.lagMs.store(lag, std::memory_order_relaxed); 
+        bool previous = replica.available.exchange(available, std::memory_order_acq_rel); 
+        if (previous && !available) { 
+            if (lag >= 0) { 
+                Logger::warn("Replica '", replica.pool->name(), "' excluded: replication lag ", lag, " ms"); 
+            } else { 
+                Logger::warn("Replica '", replica.pool->name(), "' excluded: ", error); 
+            } 
+        } else if (!previous && available) { 
+            Logger::info("Replica '", replica.pool->name(), "' available, replication lag ", lag, " ms"); 
+        } 
+    } 
+
+    // 按路由策略选择一个可用的副本，都不可用时返回 nullptr。起点轮转，延迟相同时也能分散到各副本 
+    ConnectionPool* selectReplica() { 
+        const size_t n = replicas_.size(); 
+        const size_t start = nextReplica_.fetch_add(1, std::memory_order_relaxed); 
+        ConnectionPool* best = nullptr; 
+        int fewest = INT_MAX; 
+        for (size_t i = 0; i < n; ++i) { 
+            const auto& replica = *replicas_[(start + i) % n]; 
+            if (!replica.available.load(std::memory_order_acquire)) continue; 
+            if (config_.replica_routing == ReplicaRouting::RoundRobin) return replica.pool; 
+            int outstanding = replica.pool->outstanding(); 
+            if (outstanding < fewest) { 
+                fewest = outstanding; 
+                best = replica.pool; 
+            } 
+        } 
+        return best; 
+    } 
+
+    // setConnectionFactory 保存的设置，构造时读取 
+    struct Injection { 
+        ConnectionFactory factory; 
+        std::shared_ptr<ISqlDialect> dialect; 
+        bool created = false; 
+    }; 
+
+    static Injection& injection() { 
+        static Injection inst; 
+        return inst; 
+    } 
+
+    // 命名连接池表，进程退出时释放 
+    struct Registry { 
+        std::mutex mutex; 
+        std::map<std::string, ConnectionPool*> pools; 
+        ~Registry() { 
+            for (auto& [name, pool] : pools) delete pool; 
+        } 
+    }; 
+
+    static Registry& registry() { 
+        static Registry inst; 
+        return inst; 
+    } 
+
 private: 
     // 连接队列 
     std::queue<IConnection*> connections_; 
@@ -198,5 +506,94 @@ private:
     
     // SQL 方言实例 
     std::shared_ptr<ISqlDialect> dialect_; 
+
+    // 非空时代替配置中的驱动建立连接 
+    ConnectionFactory factory_; 
+
+    std::string name_; 
+    std::atomic<const void*> verifiedPolicy_{nullptr}; 
+    std::atomic<const std::type_info*> requiredConnection_{nullptr};
+    std::atomic<int> outstanding_{0}; 
+
+    // 只读副本与后台检查线程 
+    std::vector<std::unique_ptr<Replica>> replicas_; 
+    std::atomic<size_t> nextReplica_{0}; 
+    std::mutex checkMutex_; 
+    std::mutex monitorMutex_; 
+    std::condition_variable monitorCond_; 
+    bool stopping_ = false; 
+    std::thread monitor_; 
+}; 
+
+// 在当前线程的作用域内让读语句留在主库，不分配到只读副本，用于读取刚写入的数据 (read-your-writes)；可嵌套。
+// 用法: { PrimaryReadScope primary; Mapper<Order>::save(order); auto fresh = Mapper<Order>::findById(order.id); }
+// 单次查询也可以用 Query::fromPrimary()
+class PrimaryReadScope { 
+public: 
+    PrimaryReadScope() { ++depth(); } 
+    ~PrimaryReadScope() { --depth(); } 
+
+    PrimaryReadScope(const PrimaryReadScope&) = delete; 
+    PrimaryReadScope& operator=(const PrimaryReadScope&) = delete; 
+
+    static bool active() { return depth() > 0; } 
+
+private: 
+    static int& depth() { 
+        thread_local int value = 0; 
+        return value; 
+    } 
+}; 
+
+// 原生 SQL 查询 (Mapper::find / findOne) 可能带有 RETURNING、FOR UPDATE 等需要主库的语句，默认在主库执行； 
+// 确认语句只读时把 replicaRead 作为第一个参数，允许分配到只读副本 
+// 用法: Mapper<Order>::find(uORM::replicaRead, "status = ?", "PAID") 
+struct ReplicaRead {}; 
+inline constexpr ReplicaRead replicaRead{}; 
+
+inline ConnectionPool& ConnectionPool::readPool() { 
+    if (replicas_.empty() || PrimaryReadScope::active()) return *this; 
+    ConnectionPool* replica = selectReplica(); 
+    return replica ? *replica : *this; 
+} 
+
+// 在当前线程的作用域内把 Mapper / Schema 调用切换到指定连接池，优先于 UORM_TABLE_POOL 的绑定；可嵌套。
+// 用法: { PoolScope scope("reporting"); auto rows = Mapper<Order>::select(...); }
+// 异步与协程接口在提交任务时记下当前池，任务在线程池中执行时沿用
+class PoolScope { 
+public: 
+    // primaryReads 为 true 时同时让读语句留在主库，异步接口用它在执行器线程上还原调用方的 PrimaryReadScope 
+    explicit PoolScope(ConnectionPool& pool, bool primaryReads = false) : previous_(slot()) { 
+        slot() = &pool; 
+        if (primaryReads) primary_.emplace(); 
+    } 
+    explicit PoolScope(const std::string& name) : PoolScope(ConnectionPool::instance(name)) {} 
+    ~PoolScope() { slot() = previous_; } 
+
+    PoolScope(const PoolScope&) = delete; 
+    PoolScope& operator=(const PoolScope&) = delete; 
+
+    // 当前线程生效的连接池，未设置时为 nullptr 
+    static ConnectionPool* current() { return slot(); } 
+
+private: 
+    static ConnectionPool*& slot() { 
+        thread_local ConnectionPool* pool = nullptr; 
+        return pool; 
+    } 
+
+    ConnectionPool* previous_; 
+    std::optional<PrimaryReadScope> primary_; 
 }; 
+
+template<typename T> 
+ConnectionPool& ConnectionPool::forType() { 
+    if (auto* scoped = PoolScope::current()) return *scoped; 
+    if constexpr (PoolBinding<T>::name != nullptr) { 
+        static ConnectionPool& bound = instance(PoolBinding<T>::name); 
+        return bound; 
+    } else { 
+        return instance(); 
+    } 
+} 
 } // namespace uORM 
@@ -1,7 +1,11 @@
 #pragma once 
 #include <string> 
 #include <memory> 
+#include <exception> 
+#include <functional> 
 #include <vector> 
+#include <list> 
+#include <unordered_map> 
 
 namespace uORM { 
 
@@ -10,6 +14,10 @@ class IResultSet;
 class IPreparedStatement; 
 class IStatement; 
 
+// 异步完成回调：成功时 error 为空，失败时 result 为空且 error 保存异常 
+using QueryCallback = std::function<void(std::unique_ptr<IResultSet> result, std::exception_ptr error)>; 
+using UpdateCallback = std::function<void(std::exception_ptr error)>; 
+
 // 数据库连接接口 
 class IConnection { 
 public: 
@@ -19,6 +27,84 @@ public:
     virtual std::unique_ptr<IStatement> createStatement() = 0; 
     virtual std::unique_ptr<IPreparedStatement> prepareStatement(const std::string& sql) = 0; 
     // 可以添加 commit, rollback 等事务接口 
+
+    // 获取连接级缓存的预编译语句：同一连接上相同的 SQL 只编译一次， 
+    // 再次取出时清空上次绑定的参数。语句归连接所有，随连接一起销毁； 
+    // 缓存超过容量时淘汰最久未使用的语句，返回的指针在下一次 prepareCached 之前有效。 
+    virtual IPreparedStatement* prepareCached(const std::string& sql); 
+
+    // 语句缓存的容量 (至少为 1)，连接池按配置 statement_cache 设置 
+    void setStatementCacheCapacity(size_t capacity) { 
+        statementCacheCapacity_ = capacity > 0 ? capacity : 1; 
+        while (statementCache_.size() > statementCacheCapacity_) evictStatement(); 
+    } 
+
+    // executeQueryAsync 是否真正非阻塞 (立即返回、在其他线程完成)。 
+    // 为 false 时异步接口会在调用线程上同步执行，协程层据此改为投递到执行器 
+    virtual bool nativeAsync() const { return false; } 
+
+    // 流水线中的语句：默认与 prepareStatement 相同；把参数内联发送的驱动可以返回只记录参数的语句 
+    virtual std::unique_ptr<IPreparedStatement> preparePipelineStatement(const std::string& sql) { 
+        return prepareStatement(sql); 
+    } 
+
+    // 流水线执行：先发送全部语句再依次读取结果，多条语句只花费约一次网络往返。 
+    // 结果按语句顺序追加到 results；某条语句失败时抛出异常，results 中保留此前语句的结果。 
+    // 默认实现逐条执行；支持的驱动 (PostgreSQL、MySQL) 在同一事务中执行整批语句。 
+    virtual void executePipeline(const std::vector<IPreparedStatement*>& statements, 
+                                 std::vector<std::unique_ptr<IResultSet>>& results); 
+
+protected: 
+    // 派生类在关闭底层连接前调用，保证缓存的语句先于连接释放 
+    void clearStatementCache() { 
+        statementCache_.clear(); 
+        statementLru_.clear(); 
+    } 
+
+    // 查找缓存的语句并标记为最近使用，未缓存时返回 nullptr 
+    IPreparedStatement* findCachedStatement(const std::string& sql) { 
+        auto it = statementCache_.find(sql); 
+        if (it == statementCache_.end()) return nullptr; 
+        statementLru_.splice(statementLru_.begin(), statementLru_, it->second.position); 
+        return it->second.stmt.get(); 
+    } 
+
+    // 加入缓存，已满时先淘汰最久未使用的语句 
+    IPreparedStatement* cacheStatement(const std::string& sql, std::unique_ptr<IPreparedStatement> stmt) { 
+        while (statementCache_.size() >= statementCacheCapacity_) evictStatement(); 
+        statementLru_.push_front(sql); 
+        auto* raw = stmt.get(); 
+        statementCache_.emplace(sql, CachedStatement{std::move(stmt), statementLru_.begin()}); 
+        return raw; 
+    } 
+
+    // 移除缓存中的语句而不调用 releaseCachedStatement，用于服务端预编译失败的语句 
+    void discardCachedStatement(const std::string& sql) { 
+        auto it = statementCache_.find(sql); 
+        if (it == statementCache_.end()) return; 
+        statementLru_.erase(it->second.position); 
+        statementCache_.erase(it); 
+    } 
+
+    // 语句被淘汰、即将销毁时调用；在服务端预编译的驱动在此释放服务端语句 
+    virtual void releaseCachedStatement(IPreparedStatement*) {} 
+
+private: 
+    struct CachedStatement { 
+        std::unique_ptr<IPreparedStatement> stmt; 
+        std::list<std::string>::iterator position; 
+    }; 
+
+    void evictStatement() { 
+        auto it = statementCache_.find(statementLru_.back()); 
+        releaseCachedStatement(it->second.stmt.get()); 
+        statementCache_.erase(it); 
+        statementLru_.pop_back(); 
+    } 
+
+    std::unordered_map<std::string, CachedStatement> statementCache_; 
+    std::list<std::string> statementLru_;   // 最近使用的在前 
+    size_t statementCacheCapacity_ = 256; 
 }; 
 
 // 结果集接口 
@@ -58,6 +144,50 @@ public:
     virtual void setString(int index, const std::string& val) = 0; 
     virtual void setBoolean(int index, bool val) = 0; 
     virtual void setDouble(int index, double val) = 0; 
+
+    // 清空已绑定的参数，以便复用语句重新绑定 
+    virtual void clearParameters() = 0; 
+
+    // 异步执行，完成后调用 done。调用时拷贝已绑定的参数，返回后即可重新绑定。 
+    // 默认实现在当前线程同步执行后回调；非阻塞驱动 (PgAsyncConnection) 立即返回，在事件循环线程回调。 
+    virtual void executeQueryAsync(QueryCallback done); 
+    virtual void executeUpdateAsync(UpdateCallback done); 
 }; 
 
+inline IPreparedStatement* IConnection::prepareCached(const std::string& sql) { 
+    if (auto* stmt = findCachedStatement(sql)) { 
+        stmt->clearParameters(); 
+        return stmt; 
+    } 
+    return cacheStatement(sql, prepareStatement(sql)); 
+} 
+
+inline void IConnection::executePipeline(const std::vector<IPreparedStatement*>& statements, 
+                                         std::vector<std::unique_ptr<IResultSet>>& results) { 
+    for (auto* stmt : statements) { 
+        results.push_back(stmt->executeQuery()); 
+    } 
+} 
+
+inline void IPreparedStatement::executeQueryAsync(QueryCallback done) { 
+    std::unique_ptr<IResultSet> result; 
+    try { 
+        result = executeQuery(); 
+    } catch (...) { 
+        done(nullptr, std::current_exception()); 
+        return; 
+    } 
+    done(std::move(result), nullptr); 
+} 
+
+inline void IPreparedStatement::executeUpdateAsync(UpdateCallback done) { 
+    try { 
+        executeUpdate(); 
+    } catch (...) { 
+        done(std::current_exception()); 
+        return; 
+    } 
+    done(nullptr); 
+} 
+
 } // namespace uORM 
@@ -0,0 +1,123 @@
+#pragma once
+// 文件说明：
+// 驱动策略决定 Mapper / Schema 通过哪些类型访问方言、预编译语句和结果集。
+// DynamicDriver 经由 IPreparedStatement / IResultSet 的虚函数调用，运行时按配置选择驱动；
+// StaticDriver 绑定到一组具体的 (final) 驱动类，参数绑定与逐列取值可以在编译期内联。
+//
+// 默认策略 DefaultDriver：
+//   - 定义 UORM_DEFAULT_DRIVER 时使用指定的策略，例如 -DUORM_DEFAULT_DRIVER=uORM::PgAsyncDriver
+//   - 定义 UORM_STATIC_DRIVER 时使用唯一编译进来的驱动的静态策略 (PostgreSQL 为同步驱动)
+//   - 否则为 DynamicDriver，可同时编译多个驱动
+
+#include "uORM/driver/ConnectionPool.h"
+#include "uORM/orm/Error.h"
+#include <type_traits>
+#include <typeinfo>
+
+namespace uORM {
+
+// 运行时多态：任意驱动，每次绑定和取值都是一次虚函数调用
+struct DynamicDriver {
+    using Connection = IConnection;
+    using PreparedStatement = IPreparedStatement;
+    using ResultSet = IResultSet;
+    using Dialect = ISqlDialect;
+
+    // 方言未初始化 (驱动未编译进来) 时返回 nullptr
+    static const Dialect* dialect(ConnectionPool& pool) {
+        return pool.dialect();
+    }
+
+    static PreparedStatement* statement(IPreparedStatement* stmt) { return stmt; }
+    static ResultSet* resultSet(IResultSet* res) { return res; }
+};
+
+// 编译期绑定到具体驱动：语句与结果集直接转换为 final 类型，调用不再经过虚函数表。
+// 在每个连接池上首次取方言时核对实际使用的方言与连接类型，与配置不一致时抛出 ConfigurationError，
+// 之后只是一次原子读取与比较。多个连接池使用不同驱动时，应使用 DynamicDriver
+template<typename Conn, typename Stmt, typename Rs, typename Dial>
+struct StaticDriver {
+    static_assert(std::is_base_of_v<IConnection, Conn> && std::is_base_of_v<IPreparedStatement, Stmt> &&
+                  std::is_base_of_v<IResultSet, Rs> && std::is_base_of_v<ISqlDialect, Dial>,
+                  "StaticDriver 的参数必须是驱动接口的实现类");
+    static_assert(std::is_final_v<Stmt> && std::is_final_v<Rs> && std::is_final_v<Dial>,
+                  "语句、结果集与方言类型必须声明为 final，编译器才能去掉虚函数调用");
+
+    using Connection = Conn;
+    using PreparedStatement = Stmt;
+    using ResultSet = Rs;
+    using Dialect = Dial;
+
+    static const Dialect* dialect(ConnectionPool& pool) {
+        if (pool.verifiedPolicy() != tag()) {
+            verify(pool);
+            pool.setVerifiedPolicy(tag());
+        }
+        return static_cast<const Dialect*>(pool.dialect());
+    }
+
+    static PreparedStatement* statement(IPreparedStatement* stmt) { return static_cast<PreparedStatement*>(stmt); }
+    static ResultSet* resultSet(IResultSet* res) { return static_cast<ResultSet*>(res); }
+
+private:
+    // 每个策略实例化一个唯一地址，用作连接池上的核对标记
+    static const void* tag() {
+        static const char id = 0;
+        return &id;
+    }
+
+    static void verify(ConnectionPool& pool) {
+        const ISqlDialect* current = pool.dialect();
+        if (!current || typeid(*current) != typeid(Dialect)) {
+            throw ConfigurationError("Configured driver of pool '" + pool.name() +
+                                     "' does not match the compile-time driver policy (dialect mismatch)");
+        }
+        auto conn = pool.getConnection();
+        if (typeid(*conn) != typeid(Connection)) {
+            throw ConfigurationError("Configured driver of pool '" + pool.name() +
+                                     "' does not match the compile-time driver policy (connection type " + typeid(*conn).name() + ")");
+        }
+
+        // 读语句在副本上执行，结果集同样按策略类型转换：副本方言不符时报错，
+        // 连接类型由副本检查核对 (副本可能暂时不可达)，不符的副本被排除
+        for (const ConnectionPool* replica : pool.replicaPools()) {
+            const ISqlDialect* dialect = replica->dialect();
+            if (!dialect || typeid(*dialect) != typeid(Dialect)) {
+                throw ConfigurationError("Configured driver of replica pool '" + replica->name() +
+                                         "' does not match the compile-time driver policy (dialect mismatch)");
+            }
+        }
+        pool.requireReplicaConnection(typeid(Connection));
+    }
+};
+
+#ifdef USE_MYSQL
+using MySQLDriver = StaticDriver<MySQLConnection, MySQLPreparedStatement, MySQLResultSet, MySQLDialect>;
+#endif
+
+#ifdef USE_POSTGRESQL
+using PostgreSQLDriver = StaticDriver<PostgreSQLConnection, PostgreSQLPreparedStatement, PostgreSQLResultSet, PostgreSQLDialect>;
+using PgAsyncDriver = StaticDriver<PgAsyncConnection, PgAsyncPreparedStatement, PgAsyncResultSet, PostgreSQLDialect>;
+#endif
+
+#ifdef USE_SQLITE
+using SQLiteDriver = StaticDriver<SQLiteConnection, SQLitePreparedStatement, SQLiteResultSet, SQLiteDialect>;
+#endif
+
+#if defined(UORM_DEFAULT_DRIVER)
+using DefaultDriver = UORM_DEFAULT_DRIVER;
+#elif defined(UORM_STATIC_DRIVER)
+#if defined(USE_MYSQL) + defined(USE_POSTGRESQL) + defined(USE_SQLITE) != 1
+#error "UORM_STATIC_DRIVER requires exactly one of USE_MYSQL / USE_POSTGRESQL / USE_SQLITE; define UORM_DEFAULT_DRIVER to choose one"
+#elif defined(USE_MYSQL)
+using DefaultDriver = MySQLDriver;
+#elif defined(USE_POSTGRESQL)
+using DefaultDriver = PostgreSQLDriver;
+#else
+using DefaultDriver = SQLiteDriver;
+#endif
+#else
+using DefaultDriver = DynamicDriver;
+#endif
+
+} // namespace uORM
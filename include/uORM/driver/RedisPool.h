@@ -0,0 +1,93 @@
+#pragma once
+// 文件说明：
+// RedisPool 管理 Redis 连接，配置来自 ConfigManager 的 RedisConfig 段 (readRedisconfig)。
+// 连接按需创建，最多 poolsize 个；取用时超过 timeout 仍无空闲连接则抛出 ConnectionError。
+
+#include "uORM/driver/ConfigManager.h"
+#include "uORM/driver/redis/RedisClient.h"
+#include "uORM/orm/Error.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace uORM {
+
+class RedisPool {
+public:
+    using Handle = std::unique_ptr<RedisConnection, std::function<void(RedisConnection*)>>;
+
+    static RedisPool& instance() {
+        static RedisPool inst;
+        return inst;
+    }
+
+    // 获取连接 (RAII 归还)，失效的连接在归还时被丢弃
+    Handle getConnection() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto deleter = [this](RedisConnection* c) { releaseConnection(c); };
+
+        auto timeout = std::chrono::seconds(config_.timeout_seconds > 0 ? config_.timeout_seconds : 1);
+        if (!cond_.wait_for(lock, timeout, [this] { return !idle_.empty() || created_ < config_.poolsize; })) {
+            throw ConnectionError("Redis pool exhausted: no connection available within timeout");
+        }
+
+        if (!idle_.empty()) {
+            RedisConnection* conn = idle_.back();
+            idle_.pop_back();
+            return Handle(conn, deleter);
+        }
+
+        // 在锁外建立连接，避免慢连接阻塞其他线程归还/取用
+        ++created_;
+        lock.unlock();
+        try {
+            auto conn = std::make_unique<RedisConnection>(config_.hostname, config_.port, config_.timeout_seconds);
+            conn->authenticate(config_.password, config_.database_index);
+            return Handle(conn.release(), deleter);
+        } catch (...) {
+            lock.lock();
+            --created_;
+            cond_.notify_one();
+            throw;
+        }
+    }
+
+    RedisPool(const RedisPool&) = delete;
+    RedisPool& operator=(const RedisPool&) = delete;
+
+private:
+    RedisPool() {
+        config_ = ConfigManager::getInstance().redisconfigdata_;
+        if (!config_.isValid()) {
+            throw ConfigurationError("Redis configuration is missing or invalid; call readRedisconfig first");
+        }
+    }
+
+    ~RedisPool() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto* conn : idle_) delete conn;
+        idle_.clear();
+    }
+
+    void releaseConnection(RedisConnection* conn) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (conn->isValid()) {
+            idle_.push_back(conn);
+        } else {
+            delete conn;
+            --created_;
+        }
+        cond_.notify_one();
+    }
+
+    RedisConfigData config_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<RedisConnection*> idle_;
+    int created_ = 0;
+};
+
+} // namespace uORM
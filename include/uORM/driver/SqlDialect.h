@@ -1,8 +1,21 @@
 #pragma once 
 #include <string> 
+#include <vector> 
+#include <sstream> 
+#include <limits> 
+#include <type_traits> 
+#include "uORM/orm/SqlValue.h" 
+#include "uORM/orm/Error.h" 
 
 namespace uORM { 
 
+// IN 列表的绑定策略 
+enum class InListStrategy { 
+    Expand,     // 展开为 IN (?, ?, ...)，占位符数量按桶补齐以稳定语句形状 
+    ArrayParam, // 整个列表绑定为一个数组参数 (PG: = ANY(?)) 
+    Chunked     // 按 maxInListSize() 拆分为多条语句分批执行，结果在客户端合并 
+}; 
+
 // SQL 方言接口，处理不同数据库的 SQL 语法差异 
 class ISqlDialect { 
 public: 
@@ -23,25 +36,96 @@ public:
     // 获取获取最后插入ID的 SQL (MySQL: SELECT LAST_INSERT_ID(), PG: RETURNING id) 
     virtual std::string getLastInsertIdSql() const = 0; 
     
+    // 自增主键列使用的类型，空字符串表示沿用字段类型 (SQLite 只有 INTEGER PRIMARY KEY 才是自增的 rowid 别名) 
+    virtual std::string getAutoIncrementColumnType() const = 0; 
+
+    // 清空表的语句，table 为已引用的表名 (SQLite 没有 TRUNCATE) 
+    virtual std::string truncateTableSql(const std::string& table) const = 0; 
+    
     // 获取表引擎选项 (MySQL: ENGINE=InnoDB..., PG: 空) 
     virtual std::string getTableOptions(const std::string& defaultOptions) const = 0; 
     
     // 引用标识符 (MySQL: `col`, PG: "col") 
     virtual std::string quoteIdentifier(const std::string& id) const = 0; 
+
+    // 根据列表长度选择 IN 列表的绑定策略 
+    virtual InListStrategy inListStrategy(size_t count) const = 0; 
+
+    // 单条语句中一个 IN 谓词允许展开的最大占位符数量 
+    virtual size_t maxInListSize() const = 0; 
+
+    // 数组参数形式的 IN 谓词，谓词中只包含一个占位符 
+    virtual std::string arrayInPredicate(const std::string& col, bool negated) const = 0; 
+
+    // 将列表格式化为数组参数的绑定值 
+    virtual std::string formatArrayParam(const std::vector<SqlValue>& values) const = 0; 
+
+    // 超过上限又不能分批执行的 IN 列表 (NOT IN、顶层 OR、带排序分页、JOIN) 先写入会话级临时表， 
+    // 谓词改为 col IN (SELECT v FROM 临时表)。sample 为列表中的一个值，用于确定列类型； 
+    // 返回空字符串表示不支持临时表 
+    virtual std::string createInListTableSql(const std::string& table, const SqlValue& sample) const = 0; 
+    virtual std::string dropInListTableSql(const std::string& table) const = 0; 
+
+    // 以 JSON 格式输出执行计划的 EXPLAIN 语句 (不实际执行)，结果只有一行 
+    virtual std::string explainSql(const std::string& sql) const = 0; 
+
+    // explainSql 结果中保存计划文本的列名 
+    virtual std::string explainColumn() const = 0; 
+
+    // 在只读副本上查询复制延迟的语句，结果列 replicaLagColumn() 为延迟秒数，没有结果行或为 NULL 表示延迟未知；
+    // 返回空字符串表示不支持，此时只检查副本的连通性 
+    virtual std::string replicaLagSql() const = 0; 
+    virtual std::string replicaLagColumn() const = 0; 
 }; 
 
 // MySQL 方言实现 
-class MySQLDialect : public ISqlDialect { 
+class MySQLDialect final : public ISqlDialect { 
 public: 
     std::string getAutoIncrementModifier() const override { return "AUTO_INCREMENT"; } 
     bool supportsReturningId() const override { return false; } 
     std::string getLastInsertIdSql() const override { return "SELECT LAST_INSERT_ID()"; } 
+    std::string getAutoIncrementColumnType() const override { return ""; } 
+    std::string truncateTableSql(const std::string& table) const override { return "TRUNCATE TABLE " + table; } 
     std::string getTableOptions(const std::string& defaultOptions) const override { return defaultOptions; } 
     std::string quoteIdentifier(const std::string& id) const override { return "`" + id + "`"; } 
+
+    // MySQL 没有数组参数，小列表展开，超过上限的列表分批执行 
+    InListStrategy inListStrategy(size_t count) const override { 
+        return count <= maxInListSize() ? InListStrategy::Expand : InListStrategy::Chunked; 
+    } 
+    size_t maxInListSize() const override { return 1000; } 
+    std::string arrayInPredicate(const std::string&, bool) const override { 
+        throw OrmError("MySQL 不支持数组参数绑定"); 
+    } 
+    std::string formatArrayParam(const std::vector<SqlValue>&) const override { 
+        throw OrmError("MySQL 不支持数组参数绑定"); 
+    } 
+    std::string createInListTableSql(const std::string& table, const SqlValue& sample) const override { 
+        return "CREATE TEMPORARY TABLE " + table + " (v " + columnType(sample) + ")"; 
+    } 
+    std::string dropInListTableSql(const std::string& table) const override { return "DROP TEMPORARY TABLE IF EXISTS " + table; } 
+    std::string explainSql(const std::string& sql) const override { return "EXPLAIN FORMAT=JSON " + sql; } 
+    std::string explainColumn() const override { return "EXPLAIN"; } 
+    // 8.0.22 起的语法；不是副本时没有结果行，复制线程停止时延迟为 NULL，两者都视为延迟未知 
+    std::string replicaLagSql() const override { return "SHOW REPLICA STATUS"; } 
+    std::string replicaLagColumn() const override { return "Seconds_Behind_Source"; } 
+
+private: 
+    // 临时表的列类型；字符串使用 TEXT，长度不受限制 
+    static std::string columnType(const SqlValue& sample) { 
+        return std::visit([](auto&& v) -> std::string { 
+            using V = std::decay_t<decltype(v)>; 
+            if constexpr (std::is_same_v<V, unsigned int> || std::is_same_v<V, unsigned long long>) return "BIGINT UNSIGNED"; 
+            else if constexpr (std::is_same_v<V, bool>) return "BOOLEAN"; 
+            else if constexpr (std::is_same_v<V, double>) return "DOUBLE"; 
+            else if constexpr (std::is_integral_v<V>) return "BIGINT"; 
+            else return "TEXT"; 
+        }, sample); 
+    } 
 }; 
 
 // PostgreSQL 方言实现 
-class PostgreSQLDialect : public ISqlDialect { 
+class PostgreSQLDialect final : public ISqlDialect { 
 public: 
     std::string getAutoIncrementModifier() const override { 
         // PG 10+ 使用 GENERATED BY DEFAULT AS IDENTITY，旧版用 SERIAL 
@@ -53,8 +137,116 @@ public:
     } 
     bool supportsReturningId() const override { return true; } 
     std::string getLastInsertIdSql() const override { return "RETURNING id"; } 
+    std::string getAutoIncrementColumnType() const override { return ""; } 
+    std::string truncateTableSql(const std::string& table) const override { return "TRUNCATE TABLE " + table; } 
     std::string getTableOptions(const std::string&) const override { return ""; } // PG 不支持 ENGINE=InnoDB 
     std::string quoteIdentifier(const std::string& id) const override { return "\"" + id + "\""; } 
+
+    // 短列表直接展开，较长的列表绑定为一个数组参数，语句形状与列表长度无关 
+    InListStrategy inListStrategy(size_t count) const override { 
+        return count <= 16 ? InListStrategy::Expand : InListStrategy::ArrayParam; 
+    } 
+    size_t maxInListSize() const override { return 16; } 
+    std::string arrayInPredicate(const std::string& col, bool negated) const override { 
+        // NOT IN 等价于 <> ALL，二者对 NULL 的处理一致 
+        return negated ? col + " <> ALL(?)" : col + " = ANY(?)"; 
+    } 
+
+    // 生成数组字面量，例如 {1,2,3} 或 {"a","b"}，元素类型由服务端根据列类型推断 
+    std::string formatArrayParam(const std::vector<SqlValue>& values) const override { 
+        std::ostringstream ss; 
+        ss.precision(std::numeric_limits<double>::max_digits10); 
+        ss << '{'; 
+        for (size_t i = 0; i < values.size(); ++i) { 
+            if (i > 0) ss << ','; 
+            std::visit([&](auto&& v) { 
+                using V = std::decay_t<decltype(v)>; 
+                if constexpr (std::is_same_v<V, std::nullptr_t>) { 
+                    ss << "NULL"; 
+                } else if constexpr (std::is_same_v<V, bool>) { 
+                    ss << (v ? "true" : "false"); 
+                } else if constexpr (std::is_same_v<V, std::string>) { 
+                    appendQuoted(ss, v); 
+                } else if constexpr (std::is_same_v<V, const char*>) { 
+                    appendQuoted(ss, v ? std::string(v) : std::string()); 
+                } else if constexpr (std::is_same_v<V, std::string_view>) { 
+                    appendQuoted(ss, std::string(v)); 
+                } else if constexpr (std::is_same_v<V, std::shared_ptr<const SqlArray>>) { 
+                    throw OrmError("不支持嵌套的数组参数"); 
+                } else if constexpr (std::is_same_v<V, SqlPlaceholder>) { 
+                    throw OrmError("IN 列表中不支持占位符"); 
+                } else { 
+                    ss << v; 
+                } 
+            }, values[i]); 
+        } 
+        ss << '}'; 
+        return ss.str(); 
+    } 
+
+    // 长列表总是绑定为数组参数，不需要临时表 
+    std::string createInListTableSql(const std::string&, const SqlValue&) const override { return ""; } 
+    std::string dropInListTableSql(const std::string&) const override { return ""; } 
+
+    std::string explainSql(const std::string& sql) const override { return "EXPLAIN (FORMAT JSON) " + sql; } 
+    // 按列名取值最终经过 PQfnumber，含空格与大写的列名需要加引号 
+    std::string explainColumn() const override { return "\"QUERY PLAN\""; } 
+    // WAL 接收进程不在 streaming 状态或尚未重放过事务时延迟未知 (NULL)；
+    // 已接收的 WAL 全部重放时延迟为 0，否则按最后重放事务的提交时间计算，主库空闲时不会误报延迟 
+    std::string replicaLagSql() const override { 
+        return "SELECT CASE WHEN NOT EXISTS (SELECT 1 FROM pg_stat_wal_receiver WHERE status = 'streaming') " 
+               "OR pg_last_xact_replay_timestamp() IS NULL THEN NULL " 
+               "WHEN pg_last_wal_receive_lsn() = pg_last_wal_replay_lsn() THEN 0 " 
+               "ELSE EXTRACT(EPOCH FROM now() - pg_last_xact_replay_timestamp()) END AS lag_seconds"; 
+    } 
+    std::string replicaLagColumn() const override { return "lag_seconds"; } 
+
+private: 
+    static void appendQuoted(std::ostringstream& ss, const std::string& s) { 
+        ss << '"'; 
+        for (char c : s) { 
+            if (c == '"' || c == '\\') ss << '\\'; 
+            ss << c; 
+        } 
+        ss << '"'; 
+    } 
+}; 
+
+// SQLite 方言实现 
+class SQLiteDialect final : public ISqlDialect { 
+public: 
+    // INTEGER PRIMARY KEY 本身就会自动分配 rowid；AUTOINCREMENT 只额外保证不复用已删除的最大值， 
+    // 代价是每次插入都要更新 sqlite_sequence，因此不使用 
+    std::string getAutoIncrementModifier() const override { return ""; } 
+    bool supportsReturningId() const override { return false; } 
+    std::string getLastInsertIdSql() const override { return "SELECT last_insert_rowid()"; } 
+    std::string getAutoIncrementColumnType() const override { return "INTEGER"; } 
+    std::string truncateTableSql(const std::string& table) const override { return "DELETE FROM " + table; } 
+    std::string getTableOptions(const std::string&) const override { return ""; } 
+    std::string quoteIdentifier(const std::string& id) const override { return "\"" + id + "\""; } 
+
+    // 没有数组参数，列表展开；单条语句的参数上限为 32766 (3.32 之前为 999)，超过上限的列表分批执行 
+    InListStrategy inListStrategy(size_t count) const override { 
+        return count <= maxInListSize() ? InListStrategy::Expand : InListStrategy::Chunked; 
+    } 
+    size_t maxInListSize() const override { return 500; } 
+    std::string arrayInPredicate(const std::string&, bool) const override { 
+        throw OrmError("SQLite 不支持数组参数绑定"); 
+    } 
+    std::string formatArrayParam(const std::vector<SqlValue>&) const override { 
+        throw OrmError("SQLite 不支持数组参数绑定"); 
+    } 
+    // 临时表只对当前连接可见；列不声明类型，比较时按目标列的类型亲和性转换 
+    std::string createInListTableSql(const std::string& table, const SqlValue&) const override { 
+        return "CREATE TEMP TABLE " + table + " (v)"; 
+    } 
+    std::string dropInListTableSql(const std::string& table) const override { return "DROP TABLE IF EXISTS temp." + table; } 
+    // 每个计划节点一行，SlowQueryLog 将各行的 detail 汇总为 JSON 数组 
+    std::string explainSql(const std::string& sql) const override { return "EXPLAIN QUERY PLAN " + sql; } 
+    std::string explainColumn() const override { return "detail"; } 
+    // 嵌入式数据库没有复制延迟 
+    std::string replicaLagSql() const override { return ""; } 
+    std::string replicaLagColumn() const override { return ""; } 
 }; 
 
 } // namespace uORM 
@@ -1,14 +1,20 @@
 #pragma once 
 #include "uORM/driver/DBInterfaces.h" 
 #include <mysql_connection.h> 
+#include <cppconn/datatype.h> 
 #include <cppconn/prepared_statement.h> 
 #include <cppconn/resultset.h> 
 #include <cppconn/statement.h> 
+#include <cstdio> 
+#include <string> 
+#include <type_traits> 
+#include <variant> 
+#include <vector> 
 
 namespace uORM { 
 
 // MySQL 结果集包装 
-class MySQLResultSet : public IResultSet { 
+class MySQLResultSet final : public IResultSet { 
 public: 
     MySQLResultSet(sql::ResultSet* rs) : rs_(rs) {} 
     bool next() override { return rs_->next(); } 
@@ -23,21 +29,119 @@ private:
 }; 
 
 // MySQL 预编译语句包装 
-class MySQLPreparedStatement : public IPreparedStatement { 
+// MySQLConnection::preparePipelineStatement 创建的语句只记录绑定的参数，由 executePipeline 转义后内联发送； 
+// 单独执行时才在服务端预编译并重新绑定记录的参数 
+class MySQLPreparedStatement final : public IPreparedStatement { 
 public: 
-    MySQLPreparedStatement(sql::PreparedStatement* stmt) : stmt_(stmt) {} 
-    void executeUpdate() override { stmt_->executeUpdate(); } 
+    MySQLPreparedStatement(sql::PreparedStatement* stmt, const std::string& sql = "") : stmt_(stmt), sql_(sql) {} 
+    // 只记录参数的流水线语句 
+    MySQLPreparedStatement(sql::Connection* conn, const std::string& sql) : conn_(conn), sql_(sql) {} 
+
+    void executeUpdate() override { prepared()->executeUpdate(); } 
     std::unique_ptr<IResultSet> executeQuery() override { 
-        return std::make_unique<MySQLResultSet>(stmt_->executeQuery()); 
+        return std::make_unique<MySQLResultSet>(prepared()->executeQuery()); 
+    } 
+    void setInt(int index, int val) override { bind(index, val); } 
+    void setInt64(int index, long long val) override { bind(index, val); } 
+    void setUInt(int index, unsigned int val) override { bind(index, val); } 
+    void setString(int index, const std::string& val) override { bind(index, val); } 
+    void setBoolean(int index, bool val) override { bind(index, val); } 
+    void setDouble(int index, double val) override { bind(index, val); } 
+    void clearParameters() override { 
+        if (stmt_) stmt_->clearParameters(); 
+        values_.clear(); 
+    } 
+
+    // 是否仍只记录参数 (尚未在服务端预编译) 
+    bool recording() const { return !stmt_; } 
+
+    // 参数以字面量内联后的完整 SQL，跳过字符串字面量和引用标识符中的 ?。 
+    // 字符串经连接的 escapeString (mysql_real_escape_string) 按连接字符集转义 
+    std::string inlinedSql(sql::mysql::MySQL_Connection& escaper) const { 
+        std::string out; 
+        out.reserve(sql_.size() + values_.size() * 8); 
+        size_t index = 0; 
+        char quote = 0; 
+        for (char c : sql_) { 
+            if (quote) { 
+                if (c == quote) quote = 0; 
+                out += c; 
+            } else if (c == '\'' || c == '"' || c == '`') { 
+                quote = c; 
+                out += c; 
+            } else if (c == '?') { 
+                if (index < values_.size()) appendLiteral(out, values_[index], escaper); 
+                else out += "NULL"; 
+                ++index; 
+            } else { 
+                out += c; 
+            } 
+        } 
+        return out; 
     } 
-    void setInt(int index, int val) override { stmt_->setInt(index, val); } 
-    void setInt64(int index, long long val) override { stmt_->setInt64(index, val); } 
-    void setUInt(int index, unsigned int val) override { stmt_->setUInt(index, val); } 
-    void setString(int index, const std::string& val) override { stmt_->setString(index, val); } 
-    void setBoolean(int index, bool val) override { stmt_->setBoolean(index, val); } 
-    void setDouble(int index, double val) override { stmt_->setDouble(index, val); } 
+
 private: 
+    using Value = std::variant<std::nullptr_t, int, long long, unsigned int, std::string, bool, double>; 
+
+    template<typename V> 
+    void bind(int index, const V& val) { 
+        if (stmt_) { 
+            setOn(stmt_.get(), index, val); 
+            return; 
+        } 
+        if (index < 1) return; 
+        if (values_.size() < static_cast<size_t>(index)) values_.resize(index); 
+        values_[index - 1] = val; 
+    } 
+
+    template<typename V> 
+    static void setOn(sql::PreparedStatement* stmt, int index, const V& val) { 
+        if constexpr (std::is_same_v<V, int>) stmt->setInt(index, val); 
+        else if constexpr (std::is_same_v<V, long long>) stmt->setInt64(index, val); 
+        else if constexpr (std::is_same_v<V, unsigned int>) stmt->setUInt(index, val); 
+        else if constexpr (std::is_same_v<V, std::string>) stmt->setString(index, val); 
+        else if constexpr (std::is_same_v<V, bool>) stmt->setBoolean(index, val); 
+        else if constexpr (std::is_same_v<V, double>) stmt->setDouble(index, val); 
+        else stmt->setNull(index, sql::DataType::SQLNULL); 
+    } 
+
+    // 单独执行流水线语句时才在服务端预编译，并绑定此前记录的参数 
+    sql::PreparedStatement* prepared() { 
+        if (!stmt_) { 
+            stmt_.reset(conn_->prepareStatement(sql_)); 
+            for (size_t i = 0; i < values_.size(); ++i) { 
+                std::visit([&](const auto& val) { setOn(stmt_.get(), static_cast<int>(i + 1), val); }, values_[i]); 
+            } 
+            values_.clear(); 
+        } 
+        return stmt_.get(); 
+    } 
+
+    static void appendLiteral(std::string& out, const Value& value, sql::mysql::MySQL_Connection& escaper) { 
+        std::visit([&](const auto& val) { 
+            using V = std::decay_t<decltype(val)>; 
+            if constexpr (std::is_same_v<V, std::nullptr_t>) { 
+                out += "NULL"; 
+            } else if constexpr (std::is_same_v<V, std::string>) { 
+                out += '\''; 
+                out += std::string(escaper.escapeString(val)); 
+                out += '\''; 
+            } else if constexpr (std::is_same_v<V, bool>) { 
+                out += val ? '1' : '0'; 
+            } else if constexpr (std::is_same_v<V, double>) { 
+                char buf[32]; 
+                std::snprintf(buf, sizeof(buf), "%.17g", val); 
+                out += buf; 
+            } else { 
+                out += std::to_string(val); 
+            } 
+        }, value); 
+    } 
+
     std::unique_ptr<sql::PreparedStatement> stmt_; 
+    sql::Connection* conn_ = nullptr; // 只记录参数的语句延迟预编译时使用 
+    std::string sql_; 
+    std::vector<Value> values_; 
 }; 
 
 // MySQL 语句包装 
@@ -55,8 +159,12 @@ private:
 // MySQL 连接包装 
 class MySQLConnection : public IConnection { 
 public: 
-    MySQLConnection(sql::Connection* conn) : conn_(conn) {} 
+    // multiStatements: 连接建立时开启了 CLIENT_MULTI_STATEMENTS，流水线可以一次发送多条语句 
+    MySQLConnection(sql::Connection* conn, bool multiStatements = false) : conn_(conn), multiStatements_(multiStatements) {} 
     ~MySQLConnection() { 
+        // 缓存的预编译语句依赖底层连接，必须先释放 
+        clearStatementCache(); 
+        pipelineStmt_.reset(); 
         // sql::Connection 析构时会自动释放资源，或由 unique_ptr 管理 
         if(conn_) delete conn_; 
     } 
@@ -73,11 +181,80 @@ public:
     } 
     
     std::unique_ptr<IPreparedStatement> prepareStatement(const std::string& sql) override { 
-        return std::make_unique<MySQLPreparedStatement>(conn_->prepareStatement(sql)); 
+        return std::make_unique<MySQLPreparedStatement>(conn_->prepareStatement(sql), sql); 
+    } 
+
+    // 可以内联参数时流水线语句只记录参数，不在服务端预编译 
+    std::unique_ptr<IPreparedStatement> preparePipelineStatement(const std::string& sql) override { 
+        if (!inlineEscaper()) return prepareStatement(sql); 
+        return std::make_unique<MySQLPreparedStatement>(conn_, sql); 
+    } 
+
+    // 开启多语句时把整批语句 (参数内联) 以分号连接一次发送，依次读取各个结果集，整批在同一事务中执行。 
+    // 未开启多语句、无法安全转义时逐条执行 
+    void executePipeline(const std::vector<IPreparedStatement*>& statements, 
+                         std::vector<std::unique_ptr<IResultSet>>& results) override { 
+        auto* escaper = inlineEscaper(); 
+        std::string batch; 
+        for (auto* stmt : statements) { 
+            auto* my = dynamic_cast<MySQLPreparedStatement*>(stmt); 
+            if (!escaper || !my || !my->recording()) { 
+                IConnection::executePipeline(statements, results); 
+                return; 
+            } 
+            if (!batch.empty()) batch += ";\n"; 
+            batch += my->inlinedSql(*escaper); 
+        } 
+        if (batch.empty()) return; 
+
+        const bool autoCommit = conn_->getAutoCommit(); 
+        conn_->setAutoCommit(false); 
+        try { 
+            // 语句对象保留到下一次流水线，期间取出的结果集保持有效 
+            pipelineStmt_.reset(conn_->createStatement()); 
+            sql::Statement* stmt = pipelineStmt_.get(); 
+            bool hasResult = stmt->execute(batch); 
+            for (size_t i = 0; i < statements.size(); ++i) { 
+                if (i > 0) hasResult = stmt->getMoreResults(); 
+                // 非查询语句没有结果集，以空指针占位 
+                results.push_back(hasResult ? std::make_unique<MySQLResultSet>(stmt->getResultSet()) : nullptr); 
+            } 
+            conn_->commit(); 
+        } catch (...) { 
+            try { conn_->rollback(); } catch (...) {} 
+            conn_->setAutoCommit(autoCommit); 
+            throw; 
+        } 
+        conn_->setAutoCommit(autoCommit); 
     } 
     
 private: 
+    // 内联参数使用的转义器。escapeString 不支持 NO_BACKSLASH_ESCAPES，该模式下 (或驱动未提供 
+    // MySQL_Connection 时) 返回 nullptr，流水线逐条执行。sql_mode 在每条连接上首次使用时查询一次 
+    sql::mysql::MySQL_Connection* inlineEscaper() { 
+        if (!multiStatements_) return nullptr; 
+        if (!inlineChecked_) { 
+            inlineChecked_ = true; 
+            escaper_ = dynamic_cast<sql::mysql::MySQL_Connection*>(conn_); 
+            if (escaper_) { 
+                try { 
+                    std::unique_ptr<sql::Statement> stmt(conn_->createStatement()); 
+                    std::unique_ptr<sql::ResultSet> rs(stmt->executeQuery("SELECT @@SESSION.sql_mode AS sql_mode")); 
+                    std::string mode = rs->next() ? std::string(rs->getString("sql_mode")) : std::string(); 
+                    if (mode.find("NO_BACKSLASH_ESCAPES") != std::string::npos) escaper_ = nullptr; 
+                } catch (const std::exception&) { 
+                    escaper_ = nullptr; 
+                } 
+            } 
+        } 
+        return escaper_; 
+    } 
+
     sql::Connection* conn_; // 拥有所有权 
+    bool multiStatements_ = false; 
+    bool inlineChecked_ = false; 
+    sql::mysql::MySQL_Connection* escaper_ = nullptr; 
+    std::unique_ptr<sql::Statement> pipelineStmt_; 
 }; 
 
 } // namespace uORM 
@@ -0,0 +1,966 @@
+#pragma once
+// 文件说明：
+// 基于 libpq 非阻塞接口的 PostgreSQL 驱动。PgEventLoop 用一个线程通过 epoll 驱动任意多条连接，
+// 每条连接 (PgAsyncSession) 按提交顺序发送查询 (PQsendQueryParams)，可读时 PQconsumeInput 收取结果，
+// 发起查询的线程不必为每个在途查询占用一个线程。
+// PgAsyncConnection 实现 IConnection/IPreparedStatement，可由 ConnectionPool 创建 (DataBaseConfig.async = true)；
+// PgAsyncClient 把查询分发到多条会话上，供需要大量并发查询的调用方直接使用。
+// 完成回调在事件循环线程上执行，应尽快返回，且不能在回调中同步等待其他查询。
+
+#ifdef USE_POSTGRESQL
+
+#include "uORM/driver/DBInterfaces.h"
+#include "uORM/driver/postgresql/PgSql.h"
+#include "uORM/orm/Error.h"
+#include "uORM/orm/Logger.h"
+#include <libpq-fe.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace uORM {
+
+class PgAsyncSession;
+
+// epoll 事件循环：一个线程等待所有已注册连接的套接字，并执行其他线程投递的任务
+class PgEventLoop {
+public:
+    // 进程共享的默认事件循环
+    static PgEventLoop& instance() {
+        static PgEventLoop inst;
+        return inst;
+    }
+
+    PgEventLoop() {
+        epfd_ = ::epoll_create1(EPOLL_CLOEXEC);
+        wakefd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epfd_ < 0 || wakefd_ < 0) {
+            closeFds();
+            throw ConnectionError(std::string("Failed to create PostgreSQL event loop: ") + std::strerror(errno));
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr; // data.ptr 为空表示唤醒事件
+        ::epoll_ctl(epfd_, EPOLL_CTL_ADD, wakefd_, &ev);
+        thread_ = std::thread([this] { run(); });
+        threadId_ = thread_.get_id();
+    }
+
+    // 停止循环，仍在途的查询以 ConnectionError 结束
+    ~PgEventLoop() {
+        post([this] { stopping_ = true; });
+        thread_.join();
+        closeFds();
+    }
+
+    // 在事件循环线程上执行 task，按投递顺序执行
+    void post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        uint64_t one = 1;
+        ssize_t n = ::write(wakefd_, &one, sizeof(one));
+        (void)n;
+    }
+
+    bool inLoopThread() const {
+        return std::this_thread::get_id() == threadId_;
+    }
+
+    PgEventLoop(const PgEventLoop&) = delete;
+    PgEventLoop& operator=(const PgEventLoop&) = delete;
+
+private:
+    friend class PgAsyncSession;
+
+    // 以下仅在事件循环线程调用
+    void attach(const std::shared_ptr<PgAsyncSession>& session, int fd) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = session.get();
+        ::epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev);
+        sessions_[session.get()] = session;
+    }
+
+    void watchWrite(PgAsyncSession* session, int fd, bool write) {
+        epoll_event ev{};
+        ev.events = EPOLLIN | (write ? EPOLLOUT : 0);
+        ev.data.ptr = session;
+        ::epoll_ctl(epfd_, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    void detach(PgAsyncSession* session, int fd) {
+        if (fd >= 0) ::epoll_ctl(epfd_, EPOLL_CTL_DEL, fd, nullptr);
+        sessions_.erase(session);
+    }
+
+    void run();
+
+    void runTasks() {
+        std::vector<std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks.swap(tasks_);
+        }
+        for (auto& task : tasks) {
+            try {
+                task();
+            } catch (const std::exception& e) {
+                Logger::error("event loop task error: ", e.what());
+            }
+        }
+    }
+
+    void closeFds() {
+        if (wakefd_ >= 0) ::close(wakefd_);
+        if (epfd_ >= 0) ::close(epfd_);
+        wakefd_ = epfd_ = -1;
+    }
+
+    int epfd_ = -1;
+    int wakefd_ = -1;
+    std::thread thread_;
+    std::thread::id threadId_;
+    bool stopping_ = false;
+
+    std::mutex mutex_;
+    std::vector<std::function<void()>> tasks_;
+
+    // 已注册的会话，注册期间由事件循环持有，保证回调时对象存活
+    std::unordered_map<PgAsyncSession*, std::shared_ptr<PgAsyncSession>> sessions_;
+};
+
+// 持有 PGresult 的结果集 (文本格式)
+class PgAsyncResultSet final : public IResultSet {
+public:
+    explicit PgAsyncResultSet(PGresult* res) : res_(res, &PQclear), rows_(PQntuples(res)) {}
+
+    bool next() override {
+        return ++row_ < rows_;
+    }
+
+    int getInt(const std::string& colName) override {
+        const char* v = value(colName);
+        return v ? static_cast<int>(std::strtol(v, nullptr, 10)) : 0;
+    }
+
+    long long getInt64(const std::string& colName) override {
+        const char* v = value(colName);
+        return v ? std::strtoll(v, nullptr, 10) : 0;
+    }
+
+    unsigned int getUInt(const std::string& colName) override {
+        const char* v = value(colName);
+        return v ? static_cast<unsigned int>(std::strtoul(v, nullptr, 10)) : 0;
+    }
+
+    std::string getString(const std::string& colName) override {
+        int col = column(colName);
+        if (PQgetisnull(res_.get(), row_, col)) return std::string();
+        return std::string(PQgetvalue(res_.get(), row_, col), PQgetlength(res_.get(), row_, col));
+    }
+
+    bool getBoolean(const std::string& colName) override {
+        const char* v = value(colName);
+        return v && (v[0] == 't' || v[0] == '1');
+    }
+
+    double getDouble(const std::string& colName) override {
+        const char* v = value(colName);
+        return v ? std::strtod(v, nullptr) : 0.0;
+    }
+
+    // 受影响的行数 (INSERT/UPDATE/DELETE)
+    long long affectedRows() const {
+        const char* n = PQcmdTuples(res_.get());
+        return (n && *n) ? std::strtoll(n, nullptr, 10) : 0;
+    }
+
+private:
+    // 列下标按列名缓存，避免每行都调用 PQfnumber
+    int column(const std::string& colName) {
+        auto it = columns_.find(colName);
+        if (it == columns_.end()) {
+            int col = PQfnumber(res_.get(), colName.c_str());
+            if (col < 0) throw SqlError("Column not found in result: " + colName);
+            it = columns_.emplace(colName, col).first;
+        }
+        return it->second;
+    }
+
+    const char* value(const std::string& colName) {
+        int col = column(colName);
+        if (PQgetisnull(res_.get(), row_, col)) return nullptr;
+        return PQgetvalue(res_.get(), row_, col);
+    }
+
+    std::unique_ptr<PGresult, void (*)(PGresult*)> res_;
+    int rows_;
+    int row_ = -1;
+    std::unordered_map<std::string, int> columns_;
+};
+
+// 一条非阻塞连接。请求按提交顺序执行，同一时刻只有一个查询在途。
+// submit 可在任意线程调用；发送、收取结果与回调均在事件循环线程进行。
+class PgAsyncSession : public std::enable_shared_from_this<PgAsyncSession> {
+public:
+    using BatchCallback = std::function<void(std::vector<std::unique_ptr<IResultSet>> results, std::exception_ptr error)>;
+
+    struct Request {
+        enum class Kind { Query, Prepare, ExecutePrepared, Pipeline };
+        Kind kind = Kind::Query;
+        std::string sql;  // Query/Prepare: 使用 $n 占位符的 SQL
+        std::string name; // Prepare/ExecutePrepared: 服务端语句名
+        std::vector<std::string> params;
+        QueryCallback done;
+        // Pipeline: 以流水线模式一次发送的 Query/ExecutePrepared 请求，结果经 batchDone 返回
+        std::vector<Request> batch;
+        BatchCallback batchDone;
+    };
+
+    // 建立连接 (阻塞) 并注册到事件循环，失败抛出 ConnectionError
+    static std::shared_ptr<PgAsyncSession> open(const std::string& connStr, PgEventLoop& loop = PgEventLoop::instance()) {
+        PGconn* conn = PQconnectdb(connStr.c_str());
+        if (!conn || PQstatus(conn) != CONNECTION_OK) {
+            std::string msg = conn ? trimmed(PQerrorMessage(conn)) : "out of memory";
+            if (conn) PQfinish(conn);
+            throw ConnectionError("PG Connect Error: " + msg);
+        }
+        if (PQsetnonblocking(conn, 1) != 0) {
+            std::string msg = trimmed(PQerrorMessage(conn));
+            PQfinish(conn);
+            throw ConnectionError("PG Connect Error: " + msg);
+        }
+        std::shared_ptr<PgAsyncSession> session(new PgAsyncSession(conn, loop));
+        loop.post([session] { session->loop_.attach(session, session->fd_); });
+        return session;
+    }
+
+    ~PgAsyncSession() {
+        if (result_) PQclear(result_);
+        if (conn_) PQfinish(conn_);
+    }
+
+    // 提交请求，完成后在事件循环线程调用 request.done。连接已关闭时在当前线程立即以 ConnectionError 回调
+    void submit(Request request) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!closed_) {
+                queue_.push_back(std::move(request));
+                pending_.fetch_add(1, std::memory_order_relaxed);
+                request.done = nullptr;
+                request.batchDone = nullptr;
+            }
+        }
+        if (request.done || request.batchDone) {
+            complete(request, nullptr, std::make_exception_ptr(ConnectionError("PostgreSQL connection is closed")));
+            return;
+        }
+        // 合并唤醒：已安排发送时不再重复投递
+        if (!scheduled_.exchange(true)) {
+            auto self = shared_from_this();
+            loop_.post([self] {
+                self->scheduled_.store(false);
+                self->startNext();
+            });
+        }
+    }
+
+    // 同步执行并等待结果，不能在事件循环线程 (即完成回调中) 调用
+    std::unique_ptr<IResultSet> execute(Request request) {
+        if (loop_.inLoopThread()) {
+            throw OrmError("Blocking PostgreSQL call on the event loop thread would deadlock; use the async variant");
+        }
+        auto promise = std::make_shared<std::promise<std::unique_ptr<IResultSet>>>();
+        auto future = promise->get_future();
+        request.done = [promise](std::unique_ptr<IResultSet> result, std::exception_ptr error) {
+            if (error) promise->set_exception(error);
+            else promise->set_value(std::move(result));
+        };
+        submit(std::move(request));
+        return future.get();
+    }
+
+    // 以流水线模式同步执行一批请求：全部发送后再读取结果，整批在一个隐式事务中执行。
+    // 某条失败时其后的请求不再执行，抛出该错误，results 中保留此前的结果
+    void executeBatch(std::vector<Request> batch, std::vector<std::unique_ptr<IResultSet>>& results) {
+        if (loop_.inLoopThread()) {
+            throw OrmError("Blocking PostgreSQL call on the event loop thread would deadlock; use the async variant");
+        }
+        using Batch = std::pair<std::vector<std::unique_ptr<IResultSet>>, std::exception_ptr>;
+        auto promise = std::make_shared<std::promise<Batch>>();
+        auto future = promise->get_future();
+        Request request;
+        request.kind = Request::Kind::Pipeline;
+        request.batch = std::move(batch);
+        request.batchDone = [promise](std::vector<std::unique_ptr<IResultSet>> rows, std::exception_ptr error) {
+            promise->set_value(Batch(std::move(rows), error));
+        };
+        submit(std::move(request));
+        Batch batchResult = future.get();
+        for (auto& rs : batchResult.first) results.push_back(std::move(rs));
+        if (batchResult.second) std::rethrow_exception(batchResult.second);
+    }
+
+    // 关闭连接，排队和在途的请求以 ConnectionError 结束
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (closed_) return;
+            closed_ = true;
+        }
+        auto self = shared_from_this();
+        loop_.post([self] { self->fail("PostgreSQL connection closed"); });
+    }
+
+    bool isValid() const {
+        return !broken_.load() && !closedFlag();
+    }
+
+    // 排队与在途的请求数
+    size_t pending() const {
+        return pending_.load(std::memory_order_relaxed);
+    }
+
+    PgEventLoop& loop() const {
+        return loop_;
+    }
+
+    PgAsyncSession(const PgAsyncSession&) = delete;
+    PgAsyncSession& operator=(const PgAsyncSession&) = delete;
+
+private:
+    friend class PgEventLoop;
+
+    PgAsyncSession(PGconn* conn, PgEventLoop& loop) : conn_(conn), fd_(PQsocket(conn)), loop_(loop) {}
+
+    bool closedFlag() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_;
+    }
+
+    static std::string trimmed(const char* msg) {
+        std::string s = msg ? msg : "";
+        while (!s.empty() && (s.back() == '\n' || s.back() == ' ')) s.pop_back();
+        return s;
+    }
+
+    static void invoke(QueryCallback& done, std::unique_ptr<IResultSet> result, std::exception_ptr error) {
+        if (!done) return;
+        try {
+            done(std::move(result), error);
+        } catch (const std::exception& e) {
+            Logger::error("async callback error: ", e.what());
+        } catch (...) {
+            Logger::error("async callback error: unknown exception");
+        }
+    }
+
+    static void invokeBatch(BatchCallback& done, std::vector<std::unique_ptr<IResultSet>> results, std::exception_ptr error) {
+        if (!done) return;
+        try {
+            done(std::move(results), error);
+        } catch (const std::exception& e) {
+            Logger::error("async callback error: ", e.what());
+        } catch (...) {
+            Logger::error("async callback error: unknown exception");
+        }
+    }
+
+    // 以错误结束请求，不区分单条与流水线
+    static void complete(Request& request, std::unique_ptr<IResultSet> result, std::exception_ptr error) {
+        if (request.kind == Request::Kind::Pipeline) {
+            invokeBatch(request.batchDone, {}, error);
+        } else {
+            invoke(request.done, std::move(result), error);
+        }
+    }
+
+    // ---- 以下仅在事件循环线程调用 ----
+
+    void onEvent(uint32_t events) {
+        if (broken_) return;
+        if (events & EPOLLOUT) {
+            flush();
+            if (broken_) return;
+        }
+        if (events & (EPOLLIN | EPOLLERR | EPOLLHUP)) readInput();
+    }
+
+    // 空闲时取出下一个请求发送；发送失败的请求直接以 SqlError 结束
+    void startNext() {
+        while (!busy_ && !broken_) {
+            Request request;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (queue_.empty()) return;
+                request = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            if (send(request)) {
+                current_ = std::move(request);
+                busy_ = true;
+                flush();
+                return;
+            }
+            std::string msg = trimmed(PQerrorMessage(conn_));
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            // 流水线发送到一半失败时连接状态无法恢复，按连接失效处理
+            if (PQstatus(conn_) == CONNECTION_BAD || request.kind == Request::Kind::Pipeline) {
+                complete(request, nullptr, std::make_exception_ptr(ConnectionError(msg)));
+                fail(msg);
+                return;
+            }
+            complete(request, nullptr, std::make_exception_ptr(SqlError(msg)));
+        }
+    }
+
+    bool send(const Request& request) {
+        if (request.kind == Request::Kind::Pipeline) {
+            if (PQenterPipelineMode(conn_) != 1) return false;
+            for (const auto& sub : request.batch) {
+                if (!send(sub)) return false;
+            }
+            batchResults_.clear();
+            batchError_ = nullptr;
+            return PQpipelineSync(conn_) == 1;
+        }
+        std::vector<const char*> values(request.params.size());
+        for (size_t i = 0; i < values.size(); ++i) values[i] = request.params[i].c_str();
+        int n = static_cast<int>(values.size());
+        switch (request.kind) {
+            case Request::Kind::Prepare:
+                return PQsendPrepare(conn_, request.name.c_str(), request.sql.c_str(), 0, nullptr) == 1;
+            case Request::Kind::ExecutePrepared:
+                return PQsendQueryPrepared(conn_, request.name.c_str(), n, values.data(), nullptr, nullptr, 0) == 1;
+            case Request::Kind::Query:
+            case Request::Kind::Pipeline:
+            default:
+                return PQsendQueryParams(conn_, request.sql.c_str(), n, nullptr, values.data(), nullptr, nullptr, 0) == 1;
+        }
+    }
+
+    // 发送缓冲区未写完 (返回 1) 时关注可写事件，写完后取消
+    void flush() {
+        int rc = PQflush(conn_);
+        if (rc < 0) {
+            fail(trimmed(PQerrorMessage(conn_)));
+            return;
+        }
+        bool wantWrite = rc == 1;
+        if (wantWrite != wantWrite_) {
+            wantWrite_ = wantWrite;
+            loop_.watchWrite(this, fd_, wantWrite);
+        }
+    }
+
+    void readInput() {
+        if (!PQconsumeInput(conn_)) {
+            fail(trimmed(PQerrorMessage(conn_)));
+            return;
+        }
+        while (PGnotify* notify = PQnotifies(conn_)) PQfreemem(notify);
+
+        while (busy_ && !PQisBusy(conn_)) {
+            PGresult* res = PQgetResult(conn_);
+            if (current_.kind == Request::Kind::Pipeline) {
+                // 流水线模式：每条语句的结果以 NULL 结束，整批以 PGRES_PIPELINE_SYNC 结束
+                if (!res) {
+                    finishBatchItem();
+                    continue;
+                }
+                if (PQresultStatus(res) == PGRES_PIPELINE_SYNC) {
+                    PQclear(res);
+                    finishCurrent();
+                    continue;
+                }
+                if (PQresultStatus(res) == PGRES_PIPELINE_ABORTED) {
+                    if (error_.empty()) error_ = "Statement skipped: an earlier statement in the pipeline failed";
+                    PQclear(res);
+                    continue;
+                }
+            } else if (!res) {
+                finishCurrent();
+                continue;
+            }
+            switch (PQresultStatus(res)) {
+                case PGRES_TUPLES_OK:
+                case PGRES_COMMAND_OK:
+                case PGRES_EMPTY_QUERY:
+                    // 多语句时保留最后一个结果
+                    if (result_) PQclear(result_);
+                    result_ = res;
+                    break;
+                default:
+                    if (error_.empty()) error_ = trimmed(PQresultErrorMessage(res));
+                    PQclear(res);
+                    break;
+            }
+        }
+        if (!busy_ && PQstatus(conn_) == CONNECTION_BAD) {
+            fail("PostgreSQL server closed the connection");
+        }
+    }
+
+    // 流水线中一条语句的结果已收齐。第一个错误之后的结果不再收集
+    void finishBatchItem() {
+        PGresult* res = result_;
+        result_ = nullptr;
+        if (!error_.empty()) {
+            if (!batchError_) batchError_ = std::make_exception_ptr(SqlError(error_));
+            error_.clear();
+            if (res) PQclear(res);
+        } else if (batchError_) {
+            if (res) PQclear(res);
+        } else if (res) {
+            batchResults_.push_back(std::make_unique<PgAsyncResultSet>(res));
+        } else {
+            batchError_ = std::make_exception_ptr(SqlError("PostgreSQL returned no result"));
+        }
+    }
+
+    // 当前查询的结果已收齐：先发送下一个请求再回调，让回调执行期间服务端已在处理下一条
+    void finishCurrent() {
+        Request request = std::move(current_);
+        busy_ = false;
+        if (request.kind == Request::Kind::Pipeline) {
+            if (PQexitPipelineMode(conn_) != 1) {
+                std::string msg = trimmed(PQerrorMessage(conn_));
+                invokeBatch(request.batchDone, {}, std::make_exception_ptr(ConnectionError(msg)));
+                fail(msg);
+                return;
+            }
+            auto results = std::move(batchResults_);
+            batchResults_.clear();
+            std::exception_ptr error = batchError_;
+            batchError_ = nullptr;
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            startNext();
+            invokeBatch(request.batchDone, std::move(results), error);
+            return;
+        }
+        PGresult* res = result_;
+        result_ = nullptr;
+        std::string error = std::move(error_);
+        error_.clear();
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+
+        startNext();
+
+        if (!error.empty()) {
+            if (res) PQclear(res);
+            invoke(request.done, nullptr, std::make_exception_ptr(SqlError(error)));
+        } else if (!res) {
+            invoke(request.done, nullptr, std::make_exception_ptr(SqlError("PostgreSQL returned no result")));
+        } else {
+            invoke(request.done, std::make_unique<PgAsyncResultSet>(res), nullptr);
+        }
+    }
+
+    // 连接失效或关闭：注销并以 ConnectionError 结束所有请求
+    void fail(const std::string& msg) {
+        if (broken_) return;
+        auto self = shared_from_this(); // 注销会释放事件循环持有的引用
+        broken_ = true;
+        std::deque<Request> failed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            failed.swap(queue_);
+        }
+        if (busy_) {
+            failed.push_front(std::move(current_));
+            busy_ = false;
+        }
+        if (result_) {
+            PQclear(result_);
+            result_ = nullptr;
+        }
+        pending_.store(0, std::memory_order_relaxed);
+        loop_.detach(this, fd_);
+        batchResults_.clear();
+        for (auto& request : failed) {
+            complete(request, nullptr, std::make_exception_ptr(ConnectionError(msg)));
+        }
+    }
+
+    PGconn* conn_;
+    int fd_;
+    PgEventLoop& loop_;
+
+    mutable std::mutex mutex_;
+    std::deque<Request> queue_;
+    bool closed_ = false;
+    std::atomic<size_t> pending_{0};
+    std::atomic<bool> scheduled_{false};
+    std::atomic<bool> broken_{false};
+
+    // 事件循环线程独占
+    Request current_;
+    bool busy_ = false;
+    bool wantWrite_ = false;
+    PGresult* result_ = nullptr;
+    std::string error_;
+    std::vector<std::unique_ptr<IResultSet>> batchResults_;
+    std::exception_ptr batchError_;
+};
+
+inline void PgEventLoop::run() {
+    epoll_event events[64];
+    while (!stopping_) {
+        int n = ::epoll_wait(epfd_, events, 64, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            Logger::error("event loop epoll_wait failed: ", std::strerror(errno));
+            break;
+        }
+        for (int i = 0; i < n; ++i) {
+            if (!events[i].data.ptr) {
+                uint64_t count;
+                ssize_t r = ::read(wakefd_, &count, sizeof(count));
+                (void)r;
+                continue;
+            }
+            // 同一批事件中会话可能已被前面的回调注销
+            auto it = sessions_.find(static_cast<PgAsyncSession*>(events[i].data.ptr));
+            if (it == sessions_.end()) continue;
+            auto session = it->second;
+            session->onEvent(events[i].events);
+        }
+        runTasks();
+    }
+
+    auto remaining = sessions_;
+    for (auto& entry : remaining) entry.second->fail("PostgreSQL event loop stopped");
+}
+
+// 非阻塞连接上的预编译语句。参数按下标暂存 (下标从 1 开始)，执行时拷贝进请求
+class PgAsyncPreparedStatement final : public IPreparedStatement {
+    friend class PgAsyncConnection;
+
+public:
+    PgAsyncPreparedStatement(std::shared_ptr<PgAsyncSession> session, const std::string& sql, const std::string& preparedName = "")
+        : session_(std::move(session)), sql_(sql), preparedName_(preparedName) {}
+
+    void executeUpdate() override {
+        checkSession();
+        try {
+            session_->execute(makeRequest());
+        } catch (...) {
+            rethrowPrepareError();
+            throw;
+        }
+    }
+
+    std::unique_ptr<IResultSet> executeQuery() override {
+        checkSession();
+        try {
+            return session_->execute(makeRequest());
+        } catch (...) {
+            rethrowPrepareError();
+            throw;
+        }
+    }
+
+    void executeQueryAsync(QueryCallback done) override {
+        checkSession();
+        auto request = makeRequest();
+        request.done = [prepare = prepare_, done = std::move(done)](std::unique_ptr<IResultSet> result, std::exception_ptr error) {
+            done(std::move(result), PrepareState::cause(prepare, error));
+        };
+        session_->submit(std::move(request));
+    }
+
+    void executeUpdateAsync(UpdateCallback done) override {
+        checkSession();
+        auto request = makeRequest();
+        request.done = [prepare = prepare_, done = std::move(done)](std::unique_ptr<IResultSet>, std::exception_ptr error) {
+            done(PrepareState::cause(prepare, error));
+        };
+        session_->submit(std::move(request));
+    }
+
+    void setInt(int index, int val) override { setParam(index, std::to_string(val)); }
+    void setInt64(int index, long long val) override { setParam(index, std::to_string(val)); }
+    void setUInt(int index, unsigned int val) override { setParam(index, std::to_string(val)); }
+    void setString(int index, const std::string& val) override { setParam(index, val); }
+    void setBoolean(int index, bool val) override { setParam(index, val ? "true" : "false"); }
+    void setDouble(int index, double val) override {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.17g", val);
+        setParam(index, buf);
+    }
+    void clearParameters() override { params_.clear(); }
+
+    const std::string& preparedName() const {
+        return preparedName_;
+    }
+
+private:
+    // 服务端预编译的结果。Prepare 请求不等待完成，失败时由事件循环线程记录错误；
+    // 会话按提交顺序执行，之后的执行请求完成时错误必然已经写入
+    struct PrepareState {
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+
+        // 执行失败且源于预编译失败时，返回预编译的错误 (如语法错误) 而不是 "语句不存在"
+        static std::exception_ptr cause(const std::shared_ptr<PrepareState>& state, std::exception_ptr error) {
+            if (error && state && state->failed.load(std::memory_order_acquire)) return state->error;
+            return error;
+        }
+    };
+
+    bool prepareFailed() const {
+        return prepare_ && prepare_->failed.load(std::memory_order_acquire);
+    }
+
+    void rethrowPrepareError() const {
+        if (prepareFailed()) std::rethrow_exception(prepare_->error);
+    }
+
+    void checkSession() const {
+        if (!session_) throw ConnectionError("PostgreSQL connection is not open");
+    }
+
+    PgAsyncSession::Request makeRequest() const {
+        PgAsyncSession::Request request;
+        if (preparedName_.empty()) {
+            request.kind = PgAsyncSession::Request::Kind::Query;
+            request.sql = sql_;
+        } else {
+            request.kind = PgAsyncSession::Request::Kind::ExecutePrepared;
+            request.name = preparedName_;
+        }
+        request.params = params_;
+        return request;
+    }
+
+    void setParam(int index, std::string val) {
+        if (index < 1) return;
+        if (params_.size() < static_cast<size_t>(index)) {
+            params_.resize(index);
+        }
+        params_[index - 1] = std::move(val);
+    }
+
+    std::shared_ptr<PgAsyncSession> session_;
+    std::string sql_;
+    std::string preparedName_;
+    std::vector<std::string> params_;
+    std::shared_ptr<PrepareState> prepare_; // 只有 prepareCached 创建的语句才有
+};
+
+// 非阻塞连接上的普通语句
+class PgAsyncStatement : public IStatement {
+public:
+    explicit PgAsyncStatement(std::shared_ptr<PgAsyncSession> session) : session_(std::move(session)) {}
+
+    void execute(const std::string& sql) override {
+        executeQuery(sql);
+    }
+
+    std::unique_ptr<IResultSet> executeQuery(const std::string& sql) override {
+        if (!session_) throw ConnectionError("PostgreSQL connection is not open");
+        PgAsyncSession::Request request;
+        request.sql = sql;
+        return session_->execute(std::move(request));
+    }
+
+private:
+    std::shared_ptr<PgAsyncSession> session_;
+};
+
+// 基于非阻塞会话的连接：同步接口在调用线程等待结果，executeQueryAsync/executeUpdateAsync 立即返回
+class PgAsyncConnection : public IConnection {
+public:
+    explicit PgAsyncConnection(const std::string& connStr, PgEventLoop& loop = PgEventLoop::instance()) {
+        try {
+            session_ = PgAsyncSession::open(connStr, loop);
+        } catch (const std::exception& e) {
+            Logger::error("PG async connect error: ", e.what());
+            session_ = nullptr;
+        }
+    }
+
+    ~PgAsyncConnection() override {
+        clearStatementCache();
+        if (session_) session_->close();
+    }
+
+    bool isValid() override {
+        return session_ && session_->isValid();
+    }
+
+    void setSchema(const std::string& db) override {
+        if (!isValid()) return;
+        try {
+            createStatement()->execute("SET search_path TO " + db);
+        } catch (...) {}
+    }
+
+    std::unique_ptr<IStatement> createStatement() override {
+        return std::make_unique<PgAsyncStatement>(session_);
+    }
+
+    std::unique_ptr<IPreparedStatement> prepareStatement(const std::string& sql) override {
+        return std::make_unique<PgAsyncPreparedStatement>(session_, detail::convertPgPlaceholders(sql));
+    }
+
+    // 缓存的语句在服务端预编译一次，之后每次执行只发送参数。
+    // Prepare 请求经会话队列提交后立即返回，不等待服务端应答，之后的执行请求排在它后面；
+    // 预编译失败的语句在执行时报告原始错误，下次取出时重新预编译
+    IPreparedStatement* prepareCached(const std::string& sql) override {
+        if (auto* stmt = findCachedStatement(sql)) {
+            if (!static_cast<PgAsyncPreparedStatement*>(stmt)->prepareFailed()) {
+                stmt->clearParameters();
+                return stmt;
+            }
+            discardCachedStatement(sql);
+        }
+        if (!session_) throw ConnectionError("PostgreSQL connection is not open");
+        PgAsyncSession::Request request;
+        request.kind = PgAsyncSession::Request::Kind::Prepare;
+        request.name = "uorm_stmt_" + std::to_string(++statementSerial_);
+        request.sql = detail::convertPgPlaceholders(sql);
+        auto stmt = std::make_unique<PgAsyncPreparedStatement>(session_, request.sql, request.name);
+        auto prepare = std::make_shared<PgAsyncPreparedStatement::PrepareState>();
+        stmt->prepare_ = prepare;
+        request.done = [prepare](std::unique_ptr<IResultSet>, std::exception_ptr error) {
+            if (!error) return;
+            prepare->error = error;
+            prepare->failed.store(true, std::memory_order_release);
+        };
+        session_->submit(std::move(request));
+        return cacheStatement(sql, std::move(stmt));
+    }
+
+    bool nativeAsync() const override {
+        return true;
+    }
+
+    // 使用 libpq 流水线模式：全部语句连同一个 Sync 一次发送，整批在同一隐式事务中执行
+    void executePipeline(const std::vector<IPreparedStatement*>& statements,
+                         std::vector<std::unique_ptr<IResultSet>>& results) override {
+        if (!session_) throw ConnectionError("PostgreSQL connection is not open");
+        std::vector<PgAsyncSession::Request> batch;
+        batch.reserve(statements.size());
+        for (auto* stmt : statements) {
+            auto* pg = dynamic_cast<PgAsyncPreparedStatement*>(stmt);
+            if (!pg) {
+                IConnection::executePipeline(statements, results);
+                return;
+            }
+            batch.push_back(pg->makeRequest());
+        }
+        if (batch.empty()) return;
+        try {
+            session_->executeBatch(std::move(batch), results);
+        } catch (...) {
+            for (auto* stmt : statements) static_cast<PgAsyncPreparedStatement*>(stmt)->rethrowPrepareError();
+            throw;
+        }
+    }
+
+    std::shared_ptr<PgAsyncSession> session() const {
+        return session_;
+    }
+
+protected:
+    // 淘汰的语句排在已提交的执行请求之后释放，不等待结果
+    void releaseCachedStatement(IPreparedStatement* stmt) override {
+        if (!session_) return;
+        PgAsyncSession::Request request;
+        request.sql = "DEALLOCATE " + static_cast<PgAsyncPreparedStatement*>(stmt)->preparedName();
+        session_->submit(std::move(request));
+    }
+
+private:
+    std::shared_ptr<PgAsyncSession> session_;
+    size_t statementSerial_ = 0;   // 服务端语句名的序号，淘汰后不复用
+};
+
+// 多会话异步客户端：每个查询交给排队最少的会话，失效的会话在下次分发时重连。
+// SQL 使用 ? 占位符，参数为文本格式。
+class PgAsyncClient {
+public:
+    PgAsyncClient(const std::string& connStr, size_t sessions, PgEventLoop& loop = PgEventLoop::instance())
+        : connStr_(connStr), loop_(loop), sessions_(sessions > 0 ? sessions : 1) {
+        for (auto& session : sessions_) session = PgAsyncSession::open(connStr_, loop_);
+    }
+
+    ~PgAsyncClient() {
+        for (auto& session : sessions_) {
+            if (session) session->close();
+        }
+    }
+
+    // 回调形式：完成后在事件循环线程调用 done
+    void query(const std::string& sql, std::vector<std::string> params, QueryCallback done) {
+        PgAsyncSession::Request request;
+        request.sql = detail::convertPgPlaceholders(sql);
+        request.params = std::move(params);
+        request.done = std::move(done);
+        pick()->submit(std::move(request));
+    }
+
+    // future 形式
+    std::future<std::unique_ptr<IResultSet>> query(const std::string& sql, std::vector<std::string> params = {}) {
+        auto promise = std::make_shared<std::promise<std::unique_ptr<IResultSet>>>();
+        auto future = promise->get_future();
+        query(sql, std::move(params), [promise](std::unique_ptr<IResultSet> result, std::exception_ptr error) {
+            if (error) promise->set_exception(error);
+            else promise->set_value(std::move(result));
+        });
+        return future;
+    }
+
+    size_t sessionCount() const {
+        return sessions_.size();
+    }
+
+    PgAsyncClient(const PgAsyncClient&) = delete;
+    PgAsyncClient& operator=(const PgAsyncClient&) = delete;
+
+private:
+    std::shared_ptr<PgAsyncSession> pick() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_ptr<PgAsyncSession> best;
+        for (auto& session : sessions_) {
+            if (!session || !session->isValid()) {
+                try {
+                    session = PgAsyncSession::open(connStr_, loop_);
+                } catch (const std::exception&) {
+                    continue;
+                }
+            }
+            if (!best || session->pending() < best->pending()) best = session;
+            if (best->pending() == 0) break;
+        }
+        if (!best) throw ConnectionError("No PostgreSQL connection available");
+        return best;
+    }
+
+    std::string connStr_;
+    PgEventLoop& loop_;
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<PgAsyncSession>> sessions_;
+};
+
+} // namespace uORM
+
+#endif // USE_POSTGRESQL
@@ -0,0 +1,63 @@
+#pragma once 
+#include <string> 
+#include <vector> 
+
+namespace uORM { 
+namespace detail { 
+
+// 将 ORM 统一使用的 ? 占位符依次替换为 PG 的 $n，跳过字符串字面量和引用标识符中的 ? 
+inline std::string convertPgPlaceholders(const std::string& sql) { 
+    std::string out; 
+    out.reserve(sql.size() + 16); 
+    int index = 0; 
+    char quote = 0; 
+    for (char c : sql) { 
+        if (quote) { 
+            if (c == quote) quote = 0; 
+            out += c; 
+        } else if (c == '\'' || c == '"') { 
+            quote = c; 
+            out += c; 
+        } else if (c == '?') { 
+            out += '$'; 
+            out += std::to_string(++index); 
+        } else { 
+            out += c; 
+        } 
+    } 
+    return out; 
+} 
+
+// 将 $n 占位符替换为 quote 处理后的参数文本，用于只接受完整 SQL 的接口 (如 pqxx::pipeline) 
+template<typename Quote> 
+std::string inlinePgParams(const std::string& sql, const std::vector<std::string>& params, Quote&& quote) { 
+    std::string out; 
+    out.reserve(sql.size() + params.size() * 8); 
+    char quoteChar = 0; 
+    for (size_t i = 0; i < sql.size(); ++i) { 
+        char c = sql[i]; 
+        if (quoteChar) { 
+            if (c == quoteChar) quoteChar = 0; 
+            out += c; 
+        } else if (c == '\'' || c == '"') { 
+            quoteChar = c; 
+            out += c; 
+        } else if (c == '$' && i + 1 < sql.size() && sql[i + 1] >= '0' && sql[i + 1] <= '9') { 
+            size_t index = 0; 
+            while (i + 1 < sql.size() && sql[i + 1] >= '0' && sql[i + 1] <= '9') { 
+                index = index * 10 + static_cast<size_t>(sql[++i] - '0'); 
+            } 
+            if (index == 0 || index > params.size()) { 
+                out += "NULL"; 
+            } else { 
+                out += quote(params[index - 1]); 
+            } 
+        } else { 
+            out += c; 
+        } 
+    } 
+    return out; 
+} 
+
+} // namespace detail 
+} // namespace uORM 
@@ -1,13 +1,14 @@
 #pragma once 
 #include "uORM/driver/DBInterfaces.h" 
+#include "uORM/driver/postgresql/PgSql.h" 
+#include "uORM/orm/Logger.h" 
 #include <pqxx/pqxx> 
 #include <memory> 
-#include <iostream> 
 
 namespace uORM { 
 
 // PostgreSQL 结果集包装 
-class PostgreSQLResultSet : public IResultSet { 
+class PostgreSQLResultSet final : public IResultSet { 
 public: 
     PostgreSQLResultSet(pqxx::result res) : res_(res), currentRow_(-1) {} 
     
@@ -28,8 +29,10 @@ public:
         return res_[currentRow_][colName].as<unsigned int>(); 
     } 
     
+    // NULL 返回空字符串，与 PgAsyncDriver 一致 
     std::string getString(const std::string& colName) override { 
-        return res_[currentRow_][colName].as<std::string>(); 
+        auto field = res_[currentRow_][colName]; 
+        return field.is_null() ? std::string() : field.as<std::string>(); 
     } 
     
     bool getBoolean(const std::string& colName) override { 
@@ -47,39 +50,62 @@ private:
 
 // PostgreSQL 预编译语句包装 (简单模拟，libpqxx 的 prepared statement 需要事务上下文) 
 // 为了适配接口，我们在这里持有 connection 指针，并在 execute 时创建临时事务或使用传入的事务。 
-// 简化起见，我们暂存 SQL 和参数，在 execute 时执行 params。 
-class PostgreSQLPreparedStatement : public IPreparedStatement { 
+// 参数按下标暂存，在 execute 时执行 params。 
+// 指定 preparedName 时语句已在服务端预编译 (见 PostgreSQLConnection::prepareCached)，执行时只传参数。 
+class PostgreSQLPreparedStatement final : public IPreparedStatement { 
 public: 
-    PostgreSQLPreparedStatement(pqxx::connection* conn, const std::string& sql) 
-        : conn_(conn), sql_(sql), params_() {} 
+    PostgreSQLPreparedStatement(pqxx::connection* conn, const std::string& sql, const std::string& preparedName = "") 
+        : conn_(conn), sql_(sql), preparedName_(preparedName), params_() {} 
 
     void executeUpdate() override { 
         pqxx::work w(*conn_); 
-        w.exec_params(sql_, params_); 
+        exec(w); 
         w.commit(); 
     } 
 
     std::unique_ptr<IResultSet> executeQuery() override { 
         pqxx::work w(*conn_); 
-        pqxx::result res = w.exec_params(sql_, params_); 
+        pqxx::result res = exec(w); 
         w.commit(); 
         return std::make_unique<PostgreSQLResultSet>(res); 
     } 
 
-    void setInt(int index, int val) override { addParam(std::to_string(val)); } 
-    void setInt64(int index, long long val) override { addParam(std::to_string(val)); } 
-    void setUInt(int index, unsigned int val) override { addParam(std::to_string(val)); } 
-    void setString(int index, const std::string& val) override { addParam(val); } 
-    void setBoolean(int index, bool val) override { addParam(val ? "true" : "false"); } 
-    void setDouble(int index, double val) override { addParam(std::to_string(val)); } 
+    void setInt(int index, int val) override { setParam(index, std::to_string(val)); } 
+    void setInt64(int index, long long val) override { setParam(index, std::to_string(val)); } 
+    void setUInt(int index, unsigned int val) override { setParam(index, std::to_string(val)); } 
+    void setString(int index, const std::string& val) override { setParam(index, val); } 
+    void setBoolean(int index, bool val) override { setParam(index, val ? "true" : "false"); } 
+    void setDouble(int index, double val) override { setParam(index, std::to_string(val)); } 
+    void clearParameters() override { params_.clear(); } 
+
+    // 服务端语句名，未在服务端预编译时为空 
+    const std::string& preparedName() const { return preparedName_; } 
+
+    // 参数以字面量内联后的完整 SQL，供 pqxx::pipeline 使用 
+    std::string inlinedSql(pqxx::work& w) const { 
+        return detail::inlinePgParams(sql_, params_, [&w](const std::string& v) { return w.quote(v); }); 
+    } 
 
 private: 
-    void addParam(const std::string& val) { 
-        params_.push_back(val); 
+    pqxx::result exec(pqxx::work& w) { 
+        if (!preparedName_.empty()) { 
+            return w.exec_prepared(preparedName_, params_); 
+        } 
+        return w.exec_params(sql_, params_); 
+    } 
+
+    // 下标从 1 开始，与 JDBC 风格的接口保持一致 
+    void setParam(int index, const std::string& val) { 
+        if (index < 1) return; 
+        if (params_.size() < static_cast<size_t>(index)) { 
+            params_.resize(index); 
+        } 
+        params_[index - 1] = val; 
     } 
 
     pqxx::connection* conn_; 
     std::string sql_; 
+    std::string preparedName_; 
     std::vector<std::string> params_; // 简化处理，全转字符串，libpqxx exec_params 支持 
 }; 
 
@@ -112,11 +138,15 @@ public:
         try { 
             conn_ = std::make_unique<pqxx::connection>(connStr); 
         } catch (const std::exception& e) { 
-            std::cerr << "PG Connect Error: " << e.what() << std::endl; 
+            Logger::error("PG Connect Error: ", e.what()); 
             conn_ = nullptr; 
         } 
     } 
     
+    ~PostgreSQLConnection() override { 
+        clearStatementCache(); 
+    } 
+    
     bool isValid() override { 
         return conn_ && conn_->is_open(); 
     } 
@@ -137,14 +167,65 @@ public:
     } 
     
     std::unique_ptr<IPreparedStatement> prepareStatement(const std::string& sql) override { 
-        // 转换 SQL 占位符：MySQL 使用 ?，PG 使用 $1, $2... 
-        // 这是一个复杂的转换，这里简单假设用户如果用 PG 驱动，需要自己写兼容的 SQL 或者我们在 ORM 层统一处理。 
-        // 为了演示，我们暂时不处理占位符转换，假设传入的是 $1 格式或者后续完善转换逻辑。 
-        return std::make_unique<PostgreSQLPreparedStatement>(conn_.get(), sql); 
+        // ORM 层统一使用 ? 占位符，这里转换为 PG 的 $1, $2... 
+        return std::make_unique<PostgreSQLPreparedStatement>(conn_.get(), detail::convertPgPlaceholders(sql)); 
+    } 
+
+    // 缓存的语句在服务端预编译一次，之后每次执行只发送参数 
+    IPreparedStatement* prepareCached(const std::string& sql) override { 
+        if (auto* stmt = findCachedStatement(sql)) { 
+            stmt->clearParameters(); 
+            return stmt; 
+        } 
+        std::string name = "uorm_stmt_" + std::to_string(++statementSerial_); 
+        std::string converted = detail::convertPgPlaceholders(sql); 
+        conn_->prepare(name, converted); 
+        return cacheStatement(sql, std::make_unique<PostgreSQLPreparedStatement>(conn_.get(), converted, name)); 
+    } 
+
+    // pqxx::pipeline 把全部语句一次发出再读取结果，整批在同一事务中执行。 
+    // pipeline 只接受完整 SQL，参数以 quote 转义后内联 
+    void executePipeline(const std::vector<IPreparedStatement*>& statements, 
+                         std::vector<std::unique_ptr<IResultSet>>& results) override { 
+        std::vector<PostgreSQLPreparedStatement*> pgStatements; 
+        pgStatements.reserve(statements.size()); 
+        for (auto* stmt : statements) { 
+            auto* pg = dynamic_cast<PostgreSQLPreparedStatement*>(stmt); 
+            if (!pg) { 
+                IConnection::executePipeline(statements, results); 
+                return; 
+            } 
+            pgStatements.push_back(pg); 
+        } 
+        if (pgStatements.empty()) return; 
+
+        pqxx::work w(*conn_); 
+        pqxx::pipeline pipe(w); 
+        std::vector<pqxx::pipeline::query_id> ids; 
+        ids.reserve(pgStatements.size()); 
+        for (auto* pg : pgStatements) { 
+            ids.push_back(pipe.insert(pg->inlinedSql(w))); 
+        } 
+        pipe.complete(); 
+        for (auto id : ids) { 
+            results.push_back(std::make_unique<PostgreSQLResultSet>(pipe.retrieve(id))); 
+        } 
+        w.commit(); 
+    } 
+
+protected: 
+    // 淘汰的语句同时在服务端释放，连接已断开时忽略 
+    void releaseCachedStatement(IPreparedStatement* stmt) override { 
+        try { 
+            conn_->unprepare(static_cast<PostgreSQLPreparedStatement*>(stmt)->preparedName()); 
+        } catch (const std::exception& e) { 
+            Logger::warn("PG unprepare failed: ", e.what()); 
+        } 
     } 
 
 private: 
     std::unique_ptr<pqxx::connection> conn_; 
+    size_t statementSerial_ = 0;   // 服务端语句名的序号，淘汰后不复用 
 }; 
 
 } // namespace uORM 
@@ -0,0 +1,279 @@
+#pragma once
+// 文件说明：
+// 最小的 Redis 客户端，直接通过 TCP 套接字收发 RESP 协议，不依赖 hiredis。
+// 只实现缓存层需要的功能：单条命令、流水线 (一次发送多条命令后依次读取回复)、AUTH 与 SELECT。
+
+#include "uORM/orm/Error.h"
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace uORM {
+
+// RESP 回复
+struct RedisReply {
+    enum class Type { Status, Error, Integer, String, Nil, Array };
+
+    Type type = Type::Nil;
+    std::string str;           // Status / Error / String
+    long long integer = 0;     // Integer
+    std::vector<RedisReply> elements; // Array
+
+    bool isNil() const { return type == Type::Nil; }
+    bool isError() const { return type == Type::Error; }
+};
+
+// Redis 连接：一个套接字，读写均受超时限制。任何 I/O 或协议错误都会使连接失效，由连接池丢弃
+class RedisConnection {
+public:
+    RedisConnection(const std::string& host, int port, int timeoutSeconds) {
+        connectSocket(host, port, timeoutSeconds);
+    }
+
+    ~RedisConnection() {
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    RedisConnection(const RedisConnection&) = delete;
+    RedisConnection& operator=(const RedisConnection&) = delete;
+
+    bool isValid() const {
+        return fd_ >= 0 && valid_;
+    }
+
+    // 执行单条命令：conn.command({"GET", key})
+    RedisReply command(const std::vector<std::string_view>& args) {
+        std::string out;
+        appendCommand(out, args);
+        writeAll(out);
+        return readReply();
+    }
+
+    // 流水线：一次写出所有命令，再按顺序读取同样数量的回复
+    std::vector<RedisReply> pipeline(const std::vector<std::vector<std::string_view>>& commands) {
+        std::string out;
+        for (const auto& args : commands) appendCommand(out, args);
+        writeAll(out);
+
+        std::vector<RedisReply> replies;
+        replies.reserve(commands.size());
+        for (size_t i = 0; i < commands.size(); ++i) replies.push_back(readReply());
+        return replies;
+    }
+
+    // 连接建立后的认证与选库，失败时抛出 ConnectionError
+    void authenticate(const std::string& password, int databaseIndex) {
+        if (!password.empty()) {
+            auto reply = command({"AUTH", password});
+            if (reply.isError()) throw ConnectionError("Redis AUTH failed: " + reply.str);
+        }
+        if (databaseIndex != 0) {
+            std::string index = std::to_string(databaseIndex);
+            auto reply = command({"SELECT", index});
+            if (reply.isError()) throw ConnectionError("Redis SELECT failed: " + reply.str);
+        }
+    }
+
+private:
+    void connectSocket(const std::string& host, int port, int timeoutSeconds) {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = nullptr;
+        std::string service = std::to_string(port);
+        int rc = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &result);
+        if (rc != 0) {
+            throw ConnectionError("Redis: cannot resolve " + host + ": " + gai_strerror(rc));
+        }
+
+        std::string lastError = "no address";
+        for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+            int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0) continue;
+            if (connectWithTimeout(fd, ai->ai_addr, ai->ai_addrlen, timeoutSeconds, lastError)) {
+                fd_ = fd;
+                break;
+            }
+            ::close(fd);
+        }
+        ::freeaddrinfo(result);
+
+        if (fd_ < 0) {
+            throw ConnectionError("Redis: cannot connect to " + host + ":" + service + ": " + lastError);
+        }
+
+        int one = 1;
+        ::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (timeoutSeconds > 0) {
+            timeval tv{};
+            tv.tv_sec = timeoutSeconds;
+            ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+            ::setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        }
+    }
+
+    // 非阻塞 connect + poll 实现连接超时，成功后恢复为阻塞模式
+    static bool connectWithTimeout(int fd, const sockaddr* addr, socklen_t len, int timeoutSeconds, std::string& error) {
+        int flags = ::fcntl(fd, F_GETFL, 0);
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+        int rc = ::connect(fd, addr, len);
+        if (rc != 0 && errno != EINPROGRESS) {
+            error = std::strerror(errno);
+            return false;
+        }
+        if (rc != 0) {
+            pollfd pfd{fd, POLLOUT, 0};
+            int ready = ::poll(&pfd, 1, timeoutSeconds > 0 ? timeoutSeconds * 1000 : -1);
+            if (ready <= 0) {
+                error = ready == 0 ? "connect timeout" : std::strerror(errno);
+                return false;
+            }
+            int soError = 0;
+            socklen_t soLen = sizeof(soError);
+            ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &soError, &soLen);
+            if (soError != 0) {
+                error = std::strerror(soError);
+                return false;
+            }
+        }
+
+        ::fcntl(fd, F_SETFL, flags);
+        return true;
+    }
+
+    static void appendCommand(std::string& out, const std::vector<std::string_view>& args) {
+        out += '*';
+        out += std::to_string(args.size());
+        out += "\r\n";
+        for (const auto& arg : args) {
+            out += '$';
+            out += std::to_string(arg.size());
+            out += "\r\n";
+            out += arg;
+            out += "\r\n";
+        }
+    }
+
+    void writeAll(const std::string& data) {
+        ensureValid();
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) fail(std::string("Redis write failed: ") + std::strerror(errno));
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    // 保证缓冲区中至少有 count 字节未读数据
+    void fill(size_t count) {
+        while (buffer_.size() - pos_ < count) {
+            if (pos_ > 0 && pos_ == buffer_.size()) {
+                buffer_.clear();
+                pos_ = 0;
+            }
+            char chunk[16 * 1024];
+            ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n == 0) fail("Redis connection closed by server");
+            if (n < 0) fail(std::string("Redis read failed: ") + std::strerror(errno));
+            buffer_.append(chunk, static_cast<size_t>(n));
+        }
+    }
+
+    std::string readLine() {
+        for (;;) {
+            size_t end = buffer_.find("\r\n", pos_);
+            if (end != std::string::npos) {
+                std::string line = buffer_.substr(pos_, end - pos_);
+                pos_ = end + 2;
+                return line;
+            }
+            fill(buffer_.size() - pos_ + 1);
+        }
+    }
+
+    static long long parseInteger(const std::string& s) {
+        try {
+            return std::stoll(s);
+        } catch (const std::exception&) {
+            return 0;
+        }
+    }
+
+    RedisReply readReply() {
+        ensureValid();
+        fill(1);
+        char type = buffer_[pos_++];
+        std::string line = readLine();
+
+        RedisReply reply;
+        switch (type) {
+            case '+':
+                reply.type = RedisReply::Type::Status;
+                reply.str = std::move(line);
+                break;
+            case '-':
+                reply.type = RedisReply::Type::Error;
+                reply.str = std::move(line);
+                break;
+            case ':':
+                reply.type = RedisReply::Type::Integer;
+                reply.integer = parseInteger(line);
+                break;
+            case '$': {
+                long long len = parseInteger(line);
+                if (len < 0) break; // Nil
+                fill(static_cast<size_t>(len) + 2);
+                reply.type = RedisReply::Type::String;
+                reply.str.assign(buffer_, pos_, static_cast<size_t>(len));
+                pos_ += static_cast<size_t>(len) + 2;
+                break;
+            }
+            case '*': {
+                long long count = parseInteger(line);
+                if (count < 0) break; // Nil
+                reply.type = RedisReply::Type::Array;
+                reply.elements.reserve(static_cast<size_t>(count));
+                for (long long i = 0; i < count; ++i) reply.elements.push_back(readReply());
+                break;
+            }
+            default:
+                fail(std::string("Redis protocol error: unexpected reply type '") + type + "'");
+        }
+
+        if (pos_ == buffer_.size()) {
+            buffer_.clear();
+            pos_ = 0;
+        }
+        return reply;
+    }
+
+    void ensureValid() const {
+        if (!isValid()) throw ConnectionError("Redis connection is not usable");
+    }
+
+    [[noreturn]] void fail(const std::string& message) {
+        valid_ = false;
+        throw ConnectionError(message);
+    }
+
+    int fd_ = -1;
+    bool valid_ = true;
+    std::string buffer_;
+    size_t pos_ = 0;
+};
+
+} // namespace uORM
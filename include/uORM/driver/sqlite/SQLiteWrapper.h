@@ -0,0 +1,317 @@
+#pragma once
+// 文件说明：
+// 嵌入式 SQLite 驱动，不需要数据库服务器，适合单元测试、本地开发与读多写少的本地缓存。
+// 配置 "driver": "sqlite"，"dataname" 为数据库文件路径；":memory:" 表示进程内的内存数据库，
+// 每个连接池有自己的内存数据库 (memdb VFS)，池内的连接共享，最后一条连接关闭时释放。
+//
+// 文件数据库以 WAL 模式打开 (synchronous=NORMAL)，读写互不阻塞；写冲突时按 busy_timeout 等待。
+// 每条连接维护一个预编译语句缓存：prepareStatement 对相同的 SQL 复用已编译的 sqlite3_stmt，
+// 语句与结果集释放后归还缓存，Mapper 的每次调用都不再重新解析 SQL。
+
+#include "uORM/driver/DBInterfaces.h"
+#include "uORM/orm/Error.h"
+#include "uORM/orm/Logger.h"
+#include <sqlite3.h>
+#include <cstring>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace uORM {
+
+namespace detail {
+
+class SQLiteStatementCache;
+
+// 一条已编译的语句。析构时重置并归还缓存，缓存已满或已随连接销毁时直接释放
+class SQLiteStmt {
+public:
+    SQLiteStmt(sqlite3_stmt* stmt, std::string sql, std::weak_ptr<SQLiteStatementCache> cache)
+        : stmt_(stmt), sql_(std::move(sql)), cache_(std::move(cache)) {}
+    ~SQLiteStmt();
+
+    sqlite3_stmt* get() const { return stmt_; }
+    const std::string& sql() const { return sql_; }
+
+    SQLiteStmt(const SQLiteStmt&) = delete;
+    SQLiteStmt& operator=(const SQLiteStmt&) = delete;
+
+private:
+    sqlite3_stmt* stmt_;
+    std::string sql_;
+    std::weak_ptr<SQLiteStatementCache> cache_;
+};
+
+// 连接级的语句缓存，按 SQL 保存空闲的语句，超出容量时释放最久未使用的语句。
+// 连接同一时间只被一个线程使用，缓存不加锁
+class SQLiteStatementCache : public std::enable_shared_from_this<SQLiteStatementCache> {
+public:
+    SQLiteStatementCache(sqlite3* db, size_t capacity) : db_(db), capacity_(capacity) {}
+
+    ~SQLiteStatementCache() {
+        for (auto& entry : idle_) sqlite3_finalize(entry.second.stmt);
+    }
+
+    // 取出 SQL 对应的语句：有空闲的已编译语句时直接复用，否则重新编译
+    std::shared_ptr<SQLiteStmt> acquire(const std::string& sql) {
+        sqlite3_stmt* stmt = nullptr;
+        auto it = idle_.find(sql);
+        if (it != idle_.end()) {
+            stmt = it->second.stmt;
+            lru_.erase(it->second.position);
+            idle_.erase(it);
+        } else {
+            int rc = sqlite3_prepare_v3(db_, sql.c_str(), static_cast<int>(sql.size() + 1),
+                                        capacity_ > 0 ? SQLITE_PREPARE_PERSISTENT : 0, &stmt, nullptr);
+            if (rc != SQLITE_OK) {
+                sqlite3_finalize(stmt);
+                throw SqlError(std::string("SQLite prepare error: ") + sqlite3_errmsg(db_) + " [" + sql + "]");
+            }
+        }
+        return std::make_shared<SQLiteStmt>(stmt, sql, weak_from_this());
+    }
+
+    void release(const std::string& sql, sqlite3_stmt* stmt) {
+        // 同一 SQL 同时被多处使用时只保留一条空闲语句
+        if (capacity_ == 0 || idle_.count(sql)) {
+            sqlite3_finalize(stmt);
+            return;
+        }
+        if (idle_.size() >= capacity_) {
+            auto oldest = idle_.find(lru_.back());
+            sqlite3_finalize(oldest->second.stmt);
+            idle_.erase(oldest);
+            lru_.pop_back();
+        }
+        lru_.push_front(sql);
+        idle_.emplace(sql, Idle{stmt, lru_.begin()});
+    }
+
+private:
+    struct Idle {
+        sqlite3_stmt* stmt;
+        std::list<std::string>::iterator position;
+    };
+
+    sqlite3* db_;
+    size_t capacity_;
+    std::list<std::string> lru_;   // 最近归还的在前
+    std::unordered_map<std::string, Idle> idle_;
+};
+
+inline SQLiteStmt::~SQLiteStmt() {
+    sqlite3_reset(stmt_);
+    sqlite3_clear_bindings(stmt_);
+    if (auto cache = cache_.lock()) {
+        cache->release(sql_, stmt_);
+    } else {
+        sqlite3_finalize(stmt_);
+    }
+}
+
+[[noreturn]] inline void throwSQLiteError(sqlite3* db, const char* what) {
+    throw SqlError(std::string(what) + ": " + sqlite3_errmsg(db));
+}
+
+} // namespace detail
+
+// SQLite 结果集：按需逐行 sqlite3_step，不缓存整个结果。持有语句直到结果集释放
+class SQLiteResultSet final : public IResultSet {
+public:
+    explicit SQLiteResultSet(std::shared_ptr<detail::SQLiteStmt> stmt)
+        : stmt_(std::move(stmt)), columnCount_(sqlite3_column_count(stmt_->get())) {}
+
+    bool next() override {
+        if (done_) return false;
+        int rc = sqlite3_step(stmt_->get());
+        if (rc == SQLITE_ROW) return true;
+        done_ = true;
+        if (rc != SQLITE_DONE) detail::throwSQLiteError(sqlite3_db_handle(stmt_->get()), "SQLite step error");
+        return false;
+    }
+
+    int getInt(const std::string& colName) override {
+        return sqlite3_column_int(stmt_->get(), column(colName));
+    }
+
+    long long getInt64(const std::string& colName) override {
+        return sqlite3_column_int64(stmt_->get(), column(colName));
+    }
+
+    unsigned int getUInt(const std::string& colName) override {
+        return static_cast<unsigned int>(sqlite3_column_int64(stmt_->get(), column(colName)));
+    }
+
+    std::string getString(const std::string& colName) override {
+        int col = column(colName);
+        auto text = reinterpret_cast<const char*>(sqlite3_column_text(stmt_->get(), col));
+        if (!text) return std::string();
+        return std::string(text, static_cast<size_t>(sqlite3_column_bytes(stmt_->get(), col)));
+    }
+
+    bool getBoolean(const std::string& colName) override {
+        return sqlite3_column_int64(stmt_->get(), column(colName)) != 0;
+    }
+
+    double getDouble(const std::string& colName) override {
+        return sqlite3_column_double(stmt_->get(), column(colName));
+    }
+
+private:
+    // Mapper 按列定义的顺序取值，先检查上次命中的下一列，通常一次比较即可找到
+    int column(const std::string& colName) {
+        for (int n = 0; n < columnCount_; ++n) {
+            int col = (lastColumn_ + 1 + n) % columnCount_;
+            const char* name = sqlite3_column_name(stmt_->get(), col);
+            if (name && std::strcmp(name, colName.c_str()) == 0) {
+                lastColumn_ = col;
+                return col;
+            }
+        }
+        throw SqlError("Column not found in result: " + colName);
+    }
+
+    std::shared_ptr<detail::SQLiteStmt> stmt_;
+    int columnCount_;
+    int lastColumn_ = -1;
+    bool done_ = false;
+};
+
+// SQLite 预编译语句：参数直接绑定到 sqlite3_stmt
+class SQLitePreparedStatement final : public IPreparedStatement {
+public:
+    explicit SQLitePreparedStatement(std::shared_ptr<detail::SQLiteStmt> stmt) : stmt_(std::move(stmt)) {}
+
+    void executeUpdate() override {
+        sqlite3_stmt* stmt = stmt_->get();
+        sqlite3_reset(stmt);
+        int rc;
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        }
+        sqlite3_reset(stmt);
+        if (rc != SQLITE_DONE) detail::throwSQLiteError(sqlite3_db_handle(stmt), "SQLite execute error");
+    }
+
+    // 结果集与语句共享 sqlite3_stmt，读取结果期间不要重新执行同一语句
+    std::unique_ptr<IResultSet> executeQuery() override {
+        sqlite3_reset(stmt_->get());
+        return std::make_unique<SQLiteResultSet>(stmt_);
+    }
+
+    void setInt(int index, int val) override { check(sqlite3_bind_int(stmt_->get(), index, val)); }
+    void setInt64(int index, long long val) override { check(sqlite3_bind_int64(stmt_->get(), index, val)); }
+    void setUInt(int index, unsigned int val) override { check(sqlite3_bind_int64(stmt_->get(), index, val)); }
+    void setString(int index, const std::string& val) override {
+        check(sqlite3_bind_text(stmt_->get(), index, val.data(), static_cast<int>(val.size()), SQLITE_TRANSIENT));
+    }
+    void setBoolean(int index, bool val) override { check(sqlite3_bind_int(stmt_->get(), index, val ? 1 : 0)); }
+    void setDouble(int index, double val) override { check(sqlite3_bind_double(stmt_->get(), index, val)); }
+
+    void clearParameters() override {
+        sqlite3_reset(stmt_->get());
+        sqlite3_clear_bindings(stmt_->get());
+    }
+
+private:
+    void check(int rc) {
+        if (rc != SQLITE_OK) detail::throwSQLiteError(sqlite3_db_handle(stmt_->get()), "SQLite bind error");
+    }
+
+    std::shared_ptr<detail::SQLiteStmt> stmt_;
+};
+
+// SQLite 语句包装：execute 可以包含多条以分号分隔的语句 (如建表脚本)
+class SQLiteStatement : public IStatement {
+public:
+    SQLiteStatement(sqlite3* db, std::shared_ptr<detail::SQLiteStatementCache> cache)
+        : db_(db), cache_(std::move(cache)) {}
+
+    void execute(const std::string& sql) override {
+        char* error = nullptr;
+        if (sqlite3_exec(db_, sql.c_str(), nullptr, nullptr, &error) != SQLITE_OK) {
+            std::string message = error ? error : sqlite3_errmsg(db_);
+            sqlite3_free(error);
+            throw SqlError("SQLite execute error: " + message);
+        }
+    }
+
+    std::unique_ptr<IResultSet> executeQuery(const std::string& sql) override {
+        return std::make_unique<SQLiteResultSet>(cache_->acquire(sql));
+    }
+
+private:
+    sqlite3* db_;
+    std::shared_ptr<detail::SQLiteStatementCache> cache_;
+};
+
+// SQLite 连接包装
+class SQLiteConnection : public IConnection {
+public:
+    // path 为数据库文件路径、":memory:" (直接构造的连接之间共享的内存数据库)、newMemoryDatabase() 的结果或 file: URI
+    SQLiteConnection(const std::string& path, int busyTimeoutMs = 5000, size_t statementCacheSize = 64) {
+        bool memory = path == ":memory:" || path.find("vfs=memdb") != std::string::npos;
+        std::string target = path == ":memory:" ? std::string("file:/uorm_memory?vfs=memdb") : path;
+        int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_URI | SQLITE_OPEN_NOMUTEX;
+        if (sqlite3_open_v2(target.c_str(), &db_, flags, nullptr) != SQLITE_OK) {
+            Logger::error("SQLite Connect Error: ", db_ ? sqlite3_errmsg(db_) : "out of memory", " (", path, ")");
+            sqlite3_close_v2(db_);
+            db_ = nullptr;
+            return;
+        }
+        sqlite3_busy_timeout(db_, busyTimeoutMs);
+        sqlite3_extended_result_codes(db_, 1);
+        if (!memory) {
+            // WAL 下读不阻塞写；synchronous=NORMAL 在 WAL 模式下不会损坏数据库，只可能丢失最后提交的事务
+            char* error = nullptr;
+            if (sqlite3_exec(db_, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;", nullptr, nullptr, &error) != SQLITE_OK) {
+                Logger::warn("SQLite failed to enable WAL: ", error ? error : sqlite3_errmsg(db_));
+                sqlite3_free(error);
+            }
+        }
+        cache_ = std::make_shared<detail::SQLiteStatementCache>(db_, statementCacheSize);
+    }
+
+    // 新的内存数据库路径，每次调用得到不同的名称；使用同一路径的连接共享数据。
+    // 连接池为配置为 ":memory:" 的每个池各取一个，不同连接池的数据互不可见
+    static std::string newMemoryDatabase() {
+        static std::atomic<unsigned> serial{0};
+        return "file:/uorm_memory_" + std::to_string(serial.fetch_add(1, std::memory_order_relaxed) + 1) + "?vfs=memdb";
+    }
+
+    ~SQLiteConnection() override {
+        clearStatementCache();
+        cache_.reset();
+        // 仍被持有的语句释放后才真正关闭
+        if (db_) sqlite3_close_v2(db_);
+    }
+
+    bool isValid() override {
+        return db_ != nullptr;
+    }
+
+    // SQLite 没有 schema 切换，数据库由文件决定
+    void setSchema(const std::string&) override {}
+
+    std::unique_ptr<IStatement> createStatement() override {
+        if (!db_) throw ConnectionError("SQLite connection is not open");
+        return std::make_unique<SQLiteStatement>(db_, cache_);
+    }
+
+    std::unique_ptr<IPreparedStatement> prepareStatement(const std::string& sql) override {
+        if (!db_) throw ConnectionError("SQLite connection is not open");
+        return std::make_unique<SQLitePreparedStatement>(cache_->acquire(sql));
+    }
+
+    sqlite3* handle() const {
+        return db_;
+    }
+
+private:
+    sqlite3* db_ = nullptr;
+    std::shared_ptr<detail::SQLiteStatementCache> cache_;
+};
+
+} // namespace uORM
@@ -0,0 +1,143 @@
+#pragma once
+#include "uORM/driver/ConfigManager.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace uORM {
+
+// 执行器接口：异步 Mapper 调用通过 post 投递任务，可替换为应用自己的线程池
+class Executor {
+public:
+    virtual ~Executor() = default;
+    virtual void post(std::function<void()> task) = 0;
+};
+
+// 固定线程数的执行器
+class ThreadPoolExecutor : public Executor {
+public:
+    explicit ThreadPoolExecutor(size_t threads) {
+        if (threads == 0) threads = 1;
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    // 等待已投递的任务执行完毕后退出
+    ~ThreadPoolExecutor() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cond_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    void post(std::function<void()> task) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        cond_.notify_one();
+    }
+
+    size_t threadCount() const {
+        return workers_.size();
+    }
+
+private:
+    void work() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cond_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) return;
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+    bool stopping_ = false;
+};
+
+// 异步 Mapper 调用使用的执行器。
+// 默认在第一次使用时创建线程数等于连接池大小 (DataBaseConfig.poolsize) 的 ThreadPoolExecutor，
+// 使并发的任务各自拿到一条连接而不必排队等待归还。
+// 注意：不要在执行器的任务中同步等待另一个异步调用的结果，线程耗尽时会死锁。
+class AsyncExecutor {
+public:
+    static AsyncExecutor& instance() {
+        static AsyncExecutor inst;
+        return inst;
+    }
+
+    // 替换执行器，已投递的任务仍在原执行器上完成
+    void setExecutor(std::shared_ptr<Executor> executor) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        executor_ = std::move(executor);
+    }
+
+    std::shared_ptr<Executor> executor() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!executor_) {
+            int poolsize = ConfigManager::getInstance().databaseconfigdata_.poolsize;
+            executor_ = std::make_shared<ThreadPoolExecutor>(poolsize > 0 ? static_cast<size_t>(poolsize) : 4);
+        }
+        return executor_;
+    }
+
+    // 投递任务并返回其结果的 future，任务抛出的异常在 get() 时重新抛出
+    template<typename Fn>
+    std::future<std::invoke_result_t<Fn>> submit(Fn&& fn) {
+        using R = std::invoke_result_t<Fn>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<Fn>(fn));
+        std::future<R> result = task->get_future();
+        executor()->post([task] { (*task)(); });
+        return result;
+    }
+
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+private:
+    AsyncExecutor() = default;
+
+    std::mutex mutex_;
+    std::shared_ptr<Executor> executor_;
+};
+
+// 等待所有 future 完成后依次取出结果：
+// auto [products, total] = uORM::whenAll(Mapper<Product>::selectAsync(q), Mapper<Product>::countAsync(q));
+// 先等待全部完成再取结果，某个任务失败时其余任务也已结束，随后抛出第一个失败任务的异常
+template<typename... Ts>
+std::tuple<Ts...> whenAll(std::future<Ts>&&... futures) {
+    (futures.wait(), ...);
+    return std::tuple<Ts...>{futures.get()...};
+}
+
+template<typename T>
+std::vector<T> whenAll(std::vector<std::future<T>>& futures) {
+    for (auto& future : futures) future.wait();
+    std::vector<T> results;
+    results.reserve(futures.size());
+    for (auto& future : futures) results.push_back(future.get());
+    return results;
+}
+
+} // namespace uORM
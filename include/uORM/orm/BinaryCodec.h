@@ -0,0 +1,167 @@
+#pragma once
+#include "uORM/orm/Reflection.h"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace uORM {
+
+// 紧凑二进制序列化，字段顺序与编码由 TableMeta<T> 决定：
+// 整数按声明宽度小端存放，浮点数按位存放，bool 占 1 字节，字符串为 varint 长度 + 内容。
+// 编码中不含列名，schemaHash() 随字段名和类型变化，用于拒绝旧版本程序写入的数据。
+template<typename T>
+class BinaryCodec {
+public:
+    static void encode(const T& entity, std::string& out) {
+        std::apply([&](const auto&... field) {
+            (writeValue(out, entity.*(field.member_ptr)), ...);
+        }, TableMeta<T>::get_fields());
+    }
+
+    static void encodeList(const std::vector<T>& entities, std::string& out) {
+        writeVarint(out, entities.size());
+        for (const auto& entity : entities) encode(entity, out);
+    }
+
+    // 从 in 的开头解码一个实体并前移 in；数据不完整时返回 false
+    static bool decode(std::string_view& in, T& entity) {
+        bool ok = true;
+        std::apply([&](const auto&... field) {
+            ((ok = ok && readValue(in, entity.*(field.member_ptr))), ...);
+        }, TableMeta<T>::get_fields());
+        return ok;
+    }
+
+    static bool decodeList(std::string_view& in, std::vector<T>& entities) {
+        uint64_t count = 0;
+        if (!readVarint(in, count)) return false;
+        // 每个实体至少占 1 字节，防止损坏的数据触发超大 reserve
+        if (count > in.size()) return false;
+        entities.resize(static_cast<size_t>(count));
+        for (auto& entity : entities) {
+            if (!decode(in, entity)) return false;
+        }
+        return true;
+    }
+
+    // 字段布局指纹 (FNV-1a)：列名、C++ 类型类别与宽度
+    static uint32_t schemaHash() {
+        static const uint32_t hash = [] {
+            uint32_t h = 2166136261u;
+            auto mix = [&h](std::string_view s) {
+                for (char c : s) {
+                    h ^= static_cast<unsigned char>(c);
+                    h *= 16777619u;
+                }
+            };
+            std::apply([&](const auto&... field) {
+                ((mix(field.column_name), mix(typeTag<typename std::decay_t<decltype(field)>::Type>())), ...);
+            }, TableMeta<T>::get_fields());
+            return h;
+        }();
+        return hash;
+    }
+
+    static void writeVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    static bool readVarint(std::string_view& in, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (in.empty()) return false;
+            auto byte = static_cast<unsigned char>(in.front());
+            in.remove_prefix(1);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+private:
+    template<typename V>
+    static std::string_view typeTag() {
+        if constexpr (std::is_same_v<V, std::string>) return "s";
+        else if constexpr (std::is_same_v<V, bool>) return "b";
+        else {
+            // 类别字母加字节宽度，例如 i2、u1、f8；宽度不同的整数编码长度不同，指纹必须区分
+            static constexpr char tag[] = {std::is_floating_point_v<V> ? 'f' : std::is_signed_v<V> ? 'i' : 'u',
+                                           static_cast<char>('0' + sizeof(V)), '\0'};
+            return tag;
+        }
+    }
+
+    template<typename U>
+    static void writeFixed(std::string& out, U bits) {
+        for (size_t i = 0; i < sizeof(U); ++i) {
+            out += static_cast<char>((bits >> (8 * i)) & 0xff);
+        }
+    }
+
+    template<typename U>
+    static bool readFixed(std::string_view& in, U& bits) {
+        if (in.size() < sizeof(U)) return false;
+        bits = 0;
+        for (size_t i = 0; i < sizeof(U); ++i) {
+            bits |= static_cast<U>(static_cast<unsigned char>(in[i])) << (8 * i);
+        }
+        in.remove_prefix(sizeof(U));
+        return true;
+    }
+
+    template<typename V>
+    static void writeValue(std::string& out, const V& value) {
+        if constexpr (std::is_same_v<V, std::string>) {
+            writeVarint(out, value.size());
+            out += value;
+        } else if constexpr (std::is_same_v<V, bool>) {
+            out += value ? '\1' : '\0';
+        } else if constexpr (std::is_floating_point_v<V>) {
+            using Bits = std::conditional_t<sizeof(V) == 4, uint32_t, uint64_t>;
+            Bits bits;
+            std::memcpy(&bits, &value, sizeof(V));
+            writeFixed(out, bits);
+        } else if constexpr (std::is_integral_v<V>) {
+            writeFixed(out, static_cast<std::make_unsigned_t<V>>(value));
+        } else {
+            static_assert(sizeof(V) == 0, "BinaryCodec 不支持该字段类型");
+        }
+    }
+
+    template<typename V>
+    static bool readValue(std::string_view& in, V& value) {
+        if constexpr (std::is_same_v<V, std::string>) {
+            uint64_t len = 0;
+            if (!readVarint(in, len) || in.size() < len) return false;
+            value.assign(in.data(), static_cast<size_t>(len));
+            in.remove_prefix(static_cast<size_t>(len));
+            return true;
+        } else if constexpr (std::is_same_v<V, bool>) {
+            if (in.empty()) return false;
+            value = in.front() != '\0';
+            in.remove_prefix(1);
+            return true;
+        } else if constexpr (std::is_floating_point_v<V>) {
+            using Bits = std::conditional_t<sizeof(V) == 4, uint32_t, uint64_t>;
+            Bits bits;
+            if (!readFixed(in, bits)) return false;
+            std::memcpy(&value, &bits, sizeof(V));
+            return true;
+        } else {
+            std::make_unsigned_t<V> bits;
+            if (!readFixed(in, bits)) return false;
+            value = static_cast<V>(bits);
+            return true;
+        }
+    }
+};
+
+} // namespace uORM
@@ -0,0 +1,213 @@
+#pragma once
+// 文件说明：
+// CacheInvalidationListener 在独立的 PostgreSQL 连接上 LISTEN 各表的通知通道，
+// 收到其他服务/实例写入产生的通知后驱逐本进程的 EntityCache 与 QueryCache。
+// 通知由 Schema::installNotifyTrigger<T>() 安装的触发器发出，只在 PostgreSQL 下可用。
+
+#ifdef USE_POSTGRESQL
+
+#include "uORM/driver/ConfigManager.h"
+#include "uORM/orm/Column.h"
+#include "uORM/orm/EntityCache.h"
+#include "uORM/orm/Logger.h"
+#include "uORM/orm/QueryCache.h"
+#include "uORM/orm/Reflection.h"
+#include "uORM/orm/Schema.h"
+#include <pqxx/pqxx>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace uORM {
+
+class CacheInvalidationListener {
+public:
+    // 通知负载为 "<操作>:<主键文本>"，TRUNCATE 或没有单列主键的表主键部分为空
+    using Handler = std::function<void(const std::string& operation, const std::string& key)>;
+
+    static CacheInvalidationListener& instance() {
+        static CacheInvalidationListener inst;
+        return inst;
+    }
+
+    // 订阅表 T 的变更通知。start() 之后订阅的表由监听线程在下一次等待返回后 (至多 1 秒) 开始监听
+    template<typename T>
+    void subscribe() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool added = channels_.insert_or_assign(notifyChannel<T>(), Channel{
+            [this](const std::string& operation, const std::string& key) { evict<T>(database_, operation, key); },
+            [this] { evictAll<T>(database_); }
+        }).second;
+        if (added) pending_.push_back(notifyChannel<T>());
+    }
+
+    // 启动后台线程，按 database 的配置建立专用连接，默认为 DataBaseConfig；
+    // 订阅的表应位于该数据库 (UORM_TABLE_POOL 绑定到同一个名字)
+    void start(const std::string& database = DefaultDataBase) {
+        const auto& config = ConfigManager::getInstance().databaseConfig(database);
+        if (running_.exchange(true)) return;
+        database_ = database.empty() ? std::string(DefaultDataBase) : database;
+        connStr_ = config.postgresConnectionString();
+        thread_ = std::thread([this] { run(); });
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+        if (thread_.joinable()) thread_.join();
+    }
+
+    // 已处理的通知数量
+    uint64_t notificationsReceived() const {
+        return received_.load(std::memory_order_relaxed);
+    }
+
+    ~CacheInvalidationListener() {
+        stop();
+    }
+
+    CacheInvalidationListener(const CacheInvalidationListener&) = delete;
+    CacheInvalidationListener& operator=(const CacheInvalidationListener&) = delete;
+
+private:
+    struct Channel {
+        Handler onNotify;
+        std::function<void()> onReset; // 连接重建期间可能漏掉通知，整表驱逐
+    };
+
+    class Receiver : public pqxx::notification_receiver {
+    public:
+        Receiver(pqxx::connection& conn, const std::string& channel, CacheInvalidationListener& owner)
+            : pqxx::notification_receiver(conn, channel), owner_(owner), name_(channel) {}
+
+        void operator()(const std::string& payload, int) override {
+            owner_.dispatch(name_, payload);
+        }
+
+    private:
+        CacheInvalidationListener& owner_;
+        std::string name_;
+    };
+
+    CacheInvalidationListener() = default;
+
+    void run() {
+        std::unique_ptr<pqxx::connection> conn;
+        std::vector<std::unique_ptr<Receiver>> receivers;
+        bool connectedBefore = false;
+
+        while (running_.load()) {
+            try {
+                if (!conn) {
+                    conn = std::make_unique<pqxx::connection>(connStr_);
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    pending_.clear();
+                    for (const auto& entry : channels_) {
+                        receivers.push_back(std::make_unique<Receiver>(*conn, entry.first, *this));
+                    }
+                    // 断线期间的写入没有通知，重连成功后整表驱逐一次
+                    if (connectedBefore) {
+                        for (const auto& entry : channels_) entry.second.onReset();
+                    }
+                    connectedBefore = true;
+                } else {
+                    listenPending(*conn, receivers);
+                }
+                // 最多等待 1 秒，以便及时响应 stop()
+                conn->await_notification(1, 0);
+            } catch (const std::exception& e) {
+                Logger::error("cache listener error: ", e.what());
+                receivers.clear();
+                conn.reset();
+                for (int i = 0; i < 10 && running_.load(); ++i) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+            }
+        }
+
+        receivers.clear();
+        conn.reset();
+    }
+
+    // 注册 start() 之后订阅的通道。开始监听之前的写入没有通知，注册后整表驱逐一次
+    void listenPending(pqxx::connection& conn, std::vector<std::unique_ptr<Receiver>>& receivers) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!pending_.empty()) {
+            receivers.push_back(std::make_unique<Receiver>(conn, pending_.back(), *this));
+            channels_.at(pending_.back()).onReset();
+            pending_.pop_back();
+        }
+    }
+
+    void dispatch(const std::string& channel, const std::string& payload) {
+        received_.fetch_add(1, std::memory_order_relaxed);
+        Handler handler;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = channels_.find(channel);
+            if (it == channels_.end()) return;
+            handler = it->second.onNotify;
+        }
+        auto colon = payload.find(':');
+        if (colon == std::string::npos) {
+            handler(payload, std::string());
+        } else {
+            handler(payload.substr(0, colon), payload.substr(colon + 1));
+        }
+    }
+
+    // 缓存按连接池区分，通知只驱逐监听的数据库 (start 的 database) 对应的条目
+    template<typename T>
+    static void evict(const std::string& pool, const std::string& operation, const std::string& key) {
+        TableVersions::instance().bump(pool, TableMeta<T>::name);
+        if constexpr (detail::primaryKeyCount<T>() == 1) {
+            auto& cache = EntityCache<T>::instance();
+            if (!cache.enabled()) return;
+            if (operation == "TRUNCATE" || key.empty()) {
+                cache.clear(pool);
+                return;
+            }
+            using Key = typename PrimaryKey<T>::Type;
+            try {
+                if constexpr (std::is_same_v<Key, std::string>) {
+                    cache.invalidate(pool, key);
+                } else if constexpr (std::is_integral_v<Key> && std::is_signed_v<Key>) {
+                    cache.invalidate(pool, static_cast<Key>(std::stoll(key)));
+                } else if constexpr (std::is_integral_v<Key>) {
+                    cache.invalidate(pool, static_cast<Key>(std::stoull(key)));
+                } else {
+                    cache.clear(pool);
+                }
+            } catch (const std::exception&) {
+                cache.clear(pool);
+            }
+        }
+    }
+
+    template<typename T>
+    static void evictAll(const std::string& pool) {
+        TableVersions::instance().bump(pool, TableMeta<T>::name);
+        if constexpr (detail::primaryKeyCount<T>() == 1) {
+            auto& cache = EntityCache<T>::instance();
+            if (cache.enabled()) cache.clear(pool);
+        }
+    }
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Channel> channels_;
+    std::vector<std::string> pending_; // 尚未在监听连接上注册的通道
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> received_{0};
+    std::string database_ = DefaultDataBase; // 监听的数据库，即缓存条目所属的连接池名
+    std::string connStr_;
+    std::thread thread_;
+};
+
+} // namespace uORM
+
+#endif // USE_POSTGRESQL
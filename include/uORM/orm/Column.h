@@ -0,0 +1,191 @@
+#pragma once
+#include "uORM/orm/Reflection.h"
+#include <array>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace uORM {
+
+// 成员指针特性：提取所属类和成员类型
+template<auto MemberPtr>
+struct MemberTraits;
+
+template<typename Class, typename T, T Class::* MemberPtr>
+struct MemberTraits<MemberPtr> {
+    using ClassType = Class;
+    using Type = T;
+};
+
+namespace detail {
+
+constexpr size_t constLength(const char* s) {
+    size_t n = 0;
+    while (s[n] != '\0') ++n;
+    return n;
+}
+
+template<typename Field, typename Class, typename T>
+constexpr bool matchesMember(const Field& field, T Class::* member) {
+    if constexpr (std::is_same_v<typename Field::Type, T> && std::is_same_v<typename Field::ClassType, Class>) {
+        return field.member_ptr == member;
+    } else {
+        return false;
+    }
+}
+
+// 在 TableMeta<Class>::get_fields() 中查找成员对应字段的下标，未注册时返回字段数量
+template<typename Class, typename T>
+constexpr size_t fieldIndexOf(T Class::* member) {
+    constexpr auto fields = TableMeta<Class>::get_fields();
+    size_t index = std::tuple_size_v<decltype(fields)>;
+    size_t i = 0;
+    std::apply([&](const auto&... field) {
+        ((index = (index == std::tuple_size_v<decltype(fields)> && matchesMember(field, member)) ? i : index, ++i), ...);
+    }, fields);
+    return index;
+}
+
+// 整数之间的转换是否保持所有取值：同符号时目标不窄于来源，无符号到有符号时目标严格更宽
+template<typename Member, typename V>
+constexpr bool isLosslessIntegral() {
+    if constexpr (std::is_signed_v<Member> == std::is_signed_v<V>) {
+        return sizeof(V) <= sizeof(Member);
+    } else {
+        return std::is_signed_v<Member> && sizeof(V) < sizeof(Member);
+    }
+}
+
+// 绑定值的类型检查：字符串列只接受可构造为字符串的值；bool 列只接受 bool；
+// 整数列只接受不丢失取值的整数，浮点列只接受不丢失精度的浮点数
+template<typename Member, typename Value>
+constexpr bool isBindable() {
+    using V = std::decay_t<Value>;
+    if constexpr (std::is_same_v<Member, V>) {
+        return true;
+    } else if constexpr (std::is_same_v<Member, std::string>) {
+        return std::is_constructible_v<std::string, const V&>;
+    } else if constexpr (std::is_same_v<Member, bool> || std::is_same_v<V, bool>) {
+        return false;
+    } else if constexpr (std::is_integral_v<Member>) {
+        if constexpr (std::is_integral_v<V>) return isLosslessIntegral<Member, V>();
+        else return false;
+    } else if constexpr (std::is_floating_point_v<Member>) {
+        return std::is_floating_point_v<V> && sizeof(V) <= sizeof(Member);
+    } else {
+        return std::is_convertible_v<const V&, Member>;
+    }
+}
+
+// SQL 片段后缀，作为非类型模板参数拼接列名
+inline constexpr char kEqSuffix[] = " = ?";
+inline constexpr char kNeSuffix[] = " != ?";
+inline constexpr char kGtSuffix[] = " > ?";
+inline constexpr char kLtSuffix[] = " < ?";
+inline constexpr char kGeSuffix[] = " >= ?";
+inline constexpr char kLeSuffix[] = " <= ?";
+inline constexpr char kLikeSuffix[] = " LIKE ?";
+inline constexpr char kIsNullSuffix[] = " IS NULL";
+inline constexpr char kIsNotNullSuffix[] = " IS NOT NULL";
+inline constexpr char kBetweenSuffix[] = " BETWEEN ? AND ?";
+
+} // namespace detail
+
+// 编译期列引用：Column<&Product::category>::name 为注册的列名，未注册的成员无法通过编译
+template<auto MemberPtr>
+struct Column {
+    using ClassType = typename MemberTraits<MemberPtr>::ClassType;
+    using Type = typename MemberTraits<MemberPtr>::Type;
+
+    static_assert(is_registered_v<ClassType>, "类型必须使用 UORM_TABLE 宏进行注册");
+
+    static constexpr size_t index = detail::fieldIndexOf(MemberPtr);
+    static_assert(index < std::tuple_size_v<decltype(TableMeta<ClassType>::get_fields())>, "成员未在 UORM_TABLE 中注册为字段");
+
+    static constexpr const char* name = std::get<index>(TableMeta<ClassType>::get_fields()).column_name;
+    static constexpr const char* sql_type = std::get<index>(TableMeta<ClassType>::get_fields()).sql_type_override
+                                                ? std::get<index>(TableMeta<ClassType>::get_fields()).sql_type_override
+                                                : TypeMapping<Type>::type;
+};
+
+// 编译期拼接的条件片段，例如 "category = ?"
+template<auto MemberPtr, const char* Suffix>
+struct ColumnFragment {
+    static constexpr size_t name_length = detail::constLength(Column<MemberPtr>::name);
+    static constexpr size_t suffix_length = detail::constLength(Suffix);
+
+    static constexpr std::array<char, name_length + suffix_length + 1> build() {
+        std::array<char, name_length + suffix_length + 1> buf{};
+        for (size_t i = 0; i < name_length; ++i) buf[i] = Column<MemberPtr>::name[i];
+        for (size_t i = 0; i < suffix_length; ++i) buf[name_length + i] = Suffix[i];
+        return buf;
+    }
+
+    static constexpr std::array<char, name_length + suffix_length + 1> value = build();
+
+    static constexpr std::string_view view() {
+        return std::string_view(value.data(), name_length + suffix_length);
+    }
+};
+
+namespace detail {
+
+constexpr bool constContains(const char* s, const char* needle) {
+    for (size_t i = 0; s[i] != '\0'; ++i) {
+        size_t j = 0;
+        while (needle[j] != '\0' && s[i + j] == needle[j]) ++j;
+        if (needle[j] == '\0') return true;
+    }
+    return false;
+}
+
+template<typename T>
+constexpr size_t primaryKeyIndex() {
+    constexpr auto fields = TableMeta<T>::get_fields();
+    size_t index = std::tuple_size_v<decltype(fields)>;
+    size_t i = 0;
+    std::apply([&](const auto&... field) {
+        ((index = (index == std::tuple_size_v<decltype(fields)> && constContains(field.constraint_sql, "PRIMARY KEY")) ? i : index, ++i), ...);
+    }, fields);
+    return index;
+}
+
+template<typename T>
+constexpr size_t primaryKeyCount() {
+    size_t count = 0;
+    std::apply([&](const auto&... field) {
+        ((count += constContains(field.constraint_sql, "PRIMARY KEY") ? 1 : 0), ...);
+    }, TableMeta<T>::get_fields());
+    return count;
+}
+
+} // namespace detail
+
+// 单列主键的编译期信息：PrimaryKey<Product>::name / ::Type / ::get(entity)
+template<typename T>
+struct PrimaryKey {
+    static_assert(is_registered_v<T>, "类型必须使用 UORM_TABLE 宏进行注册");
+    static_assert(detail::primaryKeyCount<T>() == 1, "该操作要求表有且只有一个 PRIMARY KEY 字段");
+
+    static constexpr size_t index = detail::primaryKeyIndex<T>();
+    using Type = typename std::decay_t<decltype(std::get<index>(TableMeta<T>::get_fields()))>::Type;
+    static constexpr const char* name = std::get<index>(TableMeta<T>::get_fields()).column_name;
+
+    static const Type& get(const T& entity) {
+        return entity.*(std::get<index>(TableMeta<T>::get_fields()).member_ptr);
+    }
+};
+
+// 运行期列名查找：遍历已注册字段比较成员指针，不分配内存；成员未注册时返回 nullptr
+template<typename Class, typename T>
+constexpr const char* columnNameOf(T Class::* member) {
+    static_assert(is_registered_v<Class>, "类型必须使用 UORM_TABLE 宏进行注册");
+    const char* name = nullptr;
+    std::apply([&](const auto&... field) {
+        ((name = (name == nullptr && detail::matchesMember(field, member)) ? field.column_name : name), ...);
+    }, TableMeta<Class>::get_fields());
+    return name;
+}
+
+} // namespace uORM
@@ -0,0 +1,116 @@
+#pragma once
+#include "uORM/orm/Mapper.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace uORM {
+
+// CompiledQuery 由含占位符的 Query 构造一次，保存最终 SQL 与参数槽位。
+// 每次 execute 只取出连接上缓存的预编译语句并重新绑定参数，
+// 不再拼接 WHERE 子句、复制参数列表或组装 SELECT 语句。Driver 为驱动策略，与 Mapper<T, Driver> 一致。
+// 连接池在编译时按 ConnectionPool::forType<T>() 确定，之后的 execute 都在该池上执行；
+// 该池配置了只读副本时每次 execute 选择一个副本，Query::fromPrimary() 编译的查询固定在主库。
+template<typename T, typename Driver>
+class CompiledQuery {
+    using Base = Mapper<T, Driver>;
+
+public:
+    explicit CompiledQuery(const Query& query) : pool_(&ConnectionPool::forType<T>()), primary_(query.readsPrimary()) {
+        auto dialect = Driver::dialect(*pool_);
+        if (!dialect) {
+            throw OrmError("SQL 方言未初始化，无法编译查询");
+        }
+
+        // IN 列表在编译时按方言展开为固定的语句形状，不拆分为多条语句
+        auto statements = Base::expandInLists(Base::buildSelectSql(*dialect, query), query.getParams(), *dialect, false);
+        if (!statements[0].tables.empty()) {
+            throw OrmError("CompiledQuery 不支持超过 " + std::to_string(dialect->maxInListSize()) +
+                           " 个值的 IN 列表 (需要临时表)，请改用 Mapper::select");
+        }
+        sql_ = std::move(statements[0].sql);
+        // 固定参数可能是借用的 string_view / const char*，转为自有副本后才能在 Query 之外长期保存
+        params_.reserve(statements[0].params.size());
+        for (const auto& param : statements[0].params) {
+            params_.push_back(detail::ownedSqlValue(param));
+        }
+        fingerprint_ = detail::fingerprint(sql_);
+
+        for (const auto& param : params_) {
+            if (std::holds_alternative<SqlPlaceholder>(param)) ++placeholderCount_;
+        }
+    }
+
+    // 最终执行的 SQL
+    const std::string& sql() const {
+        return sql_;
+    }
+
+    // execute 需要的参数数量
+    size_t placeholderCount() const {
+        return placeholderCount_;
+    }
+
+    // 按占位符出现的顺序绑定参数并执行
+    template<typename... Args>
+    std::vector<T> execute(const Args&... args) const {
+        if (sizeof...(Args) != placeholderCount_) {
+            throw OrmError("参数数量与占位符数量不匹配: 需要 " + std::to_string(placeholderCount_) +
+                           " 个，实际 " + std::to_string(sizeof...(Args)) + " 个");
+        }
+
+        std::vector<T> results;
+        try {
+            auto& pool = primary_ ? *pool_ : pool_->readPool();
+            auto connPtr = pool.getConnection();
+            StatementTimer timer(fingerprint_, sql_, TableMeta<T>::name, &pool);
+            IPreparedStatement* pstmt = connPtr->prepareCached(sql_);
+            bind(pstmt, timer, args...);
+
+            auto res = Driver::statement(pstmt)->executeQuery();
+            auto* rs = Driver::resultSet(res.get());
+            while (rs->next()) {
+                results.push_back(Base::mapRow(rs));
+            }
+            timer.rows(results.size());
+        } catch (const uORM::Exception& e) {
+            throw; // Re-throw uORM exceptions
+        } catch (const std::exception& e) {
+            throw SqlError(std::string("查询失败: ") + e.what());
+        }
+        return results;
+    }
+
+    template<typename... Args>
+    std::optional<T> executeOne(const Args&... args) const {
+        auto results = execute(args...);
+        if (results.empty()) return std::nullopt;
+        return std::move(results[0]);
+    }
+
+private:
+    // 固定值直接从槽位绑定，遇到占位符时依次取用调用参数，参数无需先转换为 SqlValue
+    template<typename... Args>
+    void bind(IPreparedStatement* pstmt, StatementTimer& timer, const Args&... args) const {
+        size_t slot = 0;
+        auto bindFixed = [&] {
+            while (slot < params_.size() && !std::holds_alternative<SqlPlaceholder>(params_[slot])) {
+                Base::bindSqlValue(pstmt, static_cast<int>(slot + 1), params_[slot]);
+                timer.bound(params_[slot]);
+                ++slot;
+            }
+        };
+
+        bindFixed();
+        ((Base::bindValue(pstmt, static_cast<int>(slot + 1), args), timer.bound(args), ++slot, bindFixed()), ...);
+    }
+
+    ConnectionPool* pool_;
+    bool primary_;
+    std::string sql_;
+    std::vector<SqlValue> params_;
+    size_t placeholderCount_ = 0;
+    uint64_t fingerprint_ = 0;
+};
+
+} // namespace uORM
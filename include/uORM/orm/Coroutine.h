@@ -0,0 +1,498 @@
+#pragma once
+// 文件说明：
+// C++20 协程接口 (可选)。只在编译器支持协程时生效，C++17 下包含本文件不产生任何定义。
+//
+//   uORM::co::Task<std::vector<Product>> loadHome() {
+//       auto list = co_await uORM::co::Mapper<Product>::select(Query().eq(&Product::category, "Home"));
+//       auto total = co_await uORM::co::Mapper<Product>::count();
+//       co_return list;
+//   }
+//
+// 连接支持非阻塞执行 (nativeAsync，如 PostgreSQL 的 PgAsyncConnection) 时，select/count 在 AsyncExecutor 上取得连接、
+// 提交查询后挂起协程，等待结果期间不占用任何线程；其他驱动以及写操作在 AsyncExecutor 上同步执行。
+// 两种情况下协程都在 AsyncExecutor 的线程上恢复，连接池与查询缓存与同步接口相同。
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include "uORM/orm/Mapper.h"
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace uORM::co {
+
+namespace detail {
+
+// 一次挂起的结果槽。完成方与 await_suspend 通过 done_ 协调：
+// 先到的一方只做标记，后到的一方负责恢复协程 (await_suspend 中直接返回 false 继续执行)
+template<typename R>
+class AwaitState {
+public:
+    void setValue(R value) {
+        value_.emplace(std::move(value));
+        complete();
+    }
+
+    void setError(std::exception_ptr error) {
+        error_ = error;
+        complete();
+    }
+
+    // 在启动操作之前调用
+    void setHandle(std::coroutine_handle<> handle) {
+        handle_ = handle;
+    }
+
+    // 操作已启动后调用，返回 true 表示保持挂起
+    bool suspend() {
+        return !done_.exchange(true, std::memory_order_acq_rel);
+    }
+
+    R take() {
+        if (error_) std::rethrow_exception(error_);
+        return std::move(*value_);
+    }
+
+private:
+    void complete() {
+        if (done_.exchange(true, std::memory_order_acq_rel)) handle_.resume();
+    }
+
+    std::optional<R> value_;
+    std::exception_ptr error_;
+    std::coroutine_handle<> handle_;
+    std::atomic<bool> done_{false};
+};
+
+} // namespace detail
+
+// co_await 的结果：可能已就绪 (如命中缓存)，否则在 await_suspend 中启动操作
+template<typename R>
+class Awaitable {
+public:
+    using State = std::shared_ptr<detail::AwaitState<R>>;
+    using Start = std::function<void(State)>;
+
+    explicit Awaitable(R ready) : ready_(std::move(ready)) {}
+    explicit Awaitable(Start start) : start_(std::move(start)) {}
+
+    bool await_ready() const noexcept {
+        return ready_.has_value();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        state_ = std::make_shared<detail::AwaitState<R>>();
+        state_->setHandle(handle);
+        start_(state_);
+        return state_->suspend();
+    }
+
+    R await_resume() {
+        if (ready_) return std::move(*ready_);
+        return state_->take();
+    }
+
+private:
+    std::optional<R> ready_;
+    Start start_;
+    State state_;
+};
+
+// 在 AsyncExecutor 上执行阻塞调用，完成后在同一线程恢复协程
+template<typename Fn>
+Awaitable<std::invoke_result_t<Fn>> onExecutor(Fn fn) {
+    using R = std::invoke_result_t<Fn>;
+    return Awaitable<R>([fn = std::move(fn)](typename Awaitable<R>::State state) {
+        AsyncExecutor::instance().executor()->post([fn, state] {
+            std::optional<R> result;
+            try {
+                result.emplace(fn());
+            } catch (...) {
+                state->setError(std::current_exception());
+                return;
+            }
+            state->setValue(std::move(*result));
+        });
+    });
+}
+
+// 惰性协程任务：被 co_await 时才开始执行，结束后恢复等待它的协程
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template<typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> handle) noexcept {
+            return handle.promise().continuation;
+        }
+        void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() { error = std::current_exception(); }
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+
+    template<typename U>
+    void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+
+    T result() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+
+    void return_void() {}
+
+    void result() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+} // namespace detail
+
+template<typename T>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle handle) : handle_(handle) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        if (handle_) handle_.destroy();
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+
+    T await_resume() {
+        return handle_.promise().result();
+    }
+
+private:
+    Handle handle_;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// 立即开始且结束时自行销毁的协程，供 syncWait 使用
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+template<typename T>
+Detached runInto(Task<T> task, std::shared_ptr<std::promise<T>> result) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+            result->set_value();
+        } else {
+            result->set_value(co_await task);
+        }
+    } catch (...) {
+        result->set_exception(std::current_exception());
+    }
+}
+
+} // namespace detail
+
+// 在当前线程阻塞等待任务完成，用于 main 或测试等非协程上下文
+template<typename T>
+T syncWait(Task<T> task) {
+    auto result = std::make_shared<std::promise<T>>();
+    auto future = result->get_future();
+    detail::runInto(std::move(task), result);
+    return future.get();
+}
+
+// Mapper<T> 的协程版本，接口与同步版本同名
+template<typename T>
+class Mapper {
+    using Base = uORM::Mapper<T>;
+
+public:
+    static Awaitable<EntityList<T>> select(Query query) {
+        auto& pool = ConnectionPool::forRead<T>(query.readsPrimary() || fillsQueryCache());
+        auto dialect = DefaultDriver::dialect(pool);
+        if (!dialect) return Awaitable<EntityList<T>>(EntityList<T>{});
+        std::string sql = Base::buildSelectSql(*dialect, query);
+        return query_<EntityList<T>>('S', pool, *dialect, std::move(sql), std::move(query), [](IResultSet* res) {
+            std::vector<T> rows;
+            auto* rs = DefaultDriver::resultSet(res);
+            while (rs->next()) rows.push_back(Base::mapRow(rs));
+            return EntityList<T>(std::move(rows));
+        });
+    }
+
+    static Awaitable<long long> count(Query query = Query()) {
+        auto& pool = ConnectionPool::forRead<T>(query.readsPrimary() || fillsQueryCache());
+        auto dialect = DefaultDriver::dialect(pool);
+        if (!dialect) return Awaitable<long long>(0);
+        std::string sql = Base::buildCountSql(*dialect, query);
+        return query_<long long>('C', pool, *dialect, std::move(sql), std::move(query), [](IResultSet* res) {
+            return res->next() ? res->getInt64("count_val") : 0LL;
+        });
+    }
+
+    template<typename K>
+    static Awaitable<std::optional<T>> findById(K id) {
+        if constexpr (uORM::detail::primaryKeyCount<T>() == 1) {
+            auto& cache = EntityCache<T>::instance();
+            if (cache.enabled()) {
+                const std::string& pool = ConnectionPool::forType<T>().name();
+                if (auto hit = cache.get(pool, typename PrimaryKey<T>::Type(id))) return Awaitable<std::optional<T>>(std::optional<T>(*hit));
+            }
+        }
+        return onExecutor(inPool(ConnectionPool::forType<T>(), [id = std::move(id)] { return Base::findById(id); }));
+    }
+
+    static Awaitable<bool> save(T entity) {
+        return onExecutor(inPool(ConnectionPool::forType<T>(), [entity = std::move(entity)] { return Base::save(entity); }));
+    }
+
+    static Awaitable<bool> update(T entity) {
+        return onExecutor(inPool(ConnectionPool::forType<T>(), [entity = std::move(entity)] { return Base::update(entity); }));
+    }
+
+    static Awaitable<bool> remove(T entity) {
+        return onExecutor(inPool(ConnectionPool::forType<T>(), [entity = std::move(entity)] { return Base::remove(entity); }));
+    }
+
+private:
+    // 结果要写入查询缓存时与同步接口一样在主库上执行，副本上滞后的数据不能以当前版本缓存
+    static bool fillsQueryCache() {
+#ifdef USE_REDIS
+        if (RedisCache<T>::instance().cachesQueries()) return true;
+#endif
+        return QueryCache<T>::instance().enabled();
+    }
+
+    // 在调用协程的线程上确定的连接池与 PrimaryReadScope，在执行器线程上通过 PoolScope 继续生效
+    template<typename Fn>
+    static auto inPool(ConnectionPool& pool, Fn fn) {
+        return [pool = &pool, primary = PrimaryReadScope::active(), fn = std::move(fn)] {
+            PoolScope scope(*pool, primary);
+            return fn();
+        };
+    }
+
+    // 慢查询日志与追踪在异步回调中需要的语句、参数副本与 span
+    struct Trace {
+        bool slow = false;
+        bool traced = false;
+        std::string sql;
+        std::vector<SqlValue> params;
+        SpanInfo span;
+    };
+
+    // select/count 共用：命中 QueryCache 时直接就绪；否则在连接上异步执行，
+    // 结果在 AsyncExecutor 上映射后写入缓存并恢复协程。
+    // IN 列表需要拆分成多条语句或写入临时表、开启 Redis 查询缓存时退回同步实现。
+    template<typename R, typename Map>
+    static Awaitable<R> query_(char kind, ConnectionPool& pool, const ISqlDialect& dialect, std::string sql, Query query, Map map) {
+        auto fallback = inPool(pool, [query] {
+            if constexpr (std::is_same_v<R, long long>) return Base::count(query);
+            else return Base::select(query);
+        });
+#ifdef USE_REDIS
+        if (RedisCache<T>::instance().cachesQueries()) return onExecutor(fallback);
+#endif
+
+        // 缓存键与同步接口一致 (IN 列表展开前的 SQL)，两者共享缓存
+        auto& cache = QueryCache<T>::instance();
+        const std::string& cachePool = ConnectionPool::forType<T>().name();
+        std::string key;
+        uint64_t version = 0;
+        if (cache.enabled()) {
+            key = QueryCache<T>::makeKey(cachePool, kind, sql, query.getParams());
+            version = cache.version(cachePool);
+            if constexpr (std::is_same_v<R, long long>) {
+                long long total = 0;
+                if (cache.getCount(key, total)) return Awaitable<R>(total);
+            } else {
+                if (auto rows = cache.getRows(key)) return Awaitable<R>(R(std::vector<T>(*rows)));
+            }
+        }
+
+        std::vector<SqlValue> params;
+        if (Base::hasInList(query.getParams())) {
+            bool allowChunk = kind != 'S' || (query.getOrderBy().empty() && query.getLimit().empty() && query.getOffset().empty());
+            auto statements = Base::expandInLists(sql, query.getParams(), dialect, allowChunk, query.getWhere());
+            if (statements.size() != 1 || !statements[0].tables.empty()) return onExecutor(fallback);
+            sql = std::move(statements[0].sql);
+            params = std::move(statements[0].params);
+        } else {
+            params.assign(query.getParams().begin(), query.getParams().end());
+        }
+
+        // 参数在执行器线程上绑定，借用调用方内存的字符串先复制
+        for (auto& param : params) {
+            if (uORM::detail::borrowsMemory(param)) param = uORM::detail::ownedSqlValue(param);
+        }
+
+        // 连接池耗尽时 getConnection 会阻塞，因此在执行器线程上获取连接，发起 co_await 的线程不等待
+        return Awaitable<R>([pool = &pool, sql = std::move(sql), params = std::move(params), cachePool = &cachePool, key = std::move(key), version, map, fallback](
+                                typename Awaitable<R>::State state) {
+            AsyncExecutor::instance().executor()->post([pool, sql, params, cachePool, key, version, map, fallback, state] {
+                submitQuery<R>(state, *pool, sql, params, *cachePool, key, version, map, fallback);
+            });
+        });
+    }
+
+    // 在执行器线程上获取连接并提交查询；连接不支持非阻塞执行时直接在当前线程同步执行。
+    // key 非空时结果按 cachePool 与 version 写入查询缓存 (cachePool 为连接池的名字，随连接池存活)
+    template<typename R, typename Map, typename Fallback>
+    static void submitQuery(const typename Awaitable<R>::State& state, ConnectionPool& poolRef, const std::string& sql,
+                      const std::vector<SqlValue>& params, const std::string& cachePool, const std::string& key,
+                      uint64_t version, const Map& map, const Fallback& fallback) {
+        auto* pool = &poolRef;
+        auto* cachePoolName = &cachePool;
+        std::shared_ptr<ConnectionPool::Handle> conn;
+        std::optional<R> fallbackResult;
+        try {
+            conn = std::make_shared<ConnectionPool::Handle>(pool->getConnection());
+            if (!(*conn)->nativeAsync()) {
+                conn->reset();
+                fallbackResult.emplace(fallback());
+            }
+        } catch (...) {
+            state->setError(std::current_exception());
+            return;
+        }
+        if (fallbackResult) {
+            state->setValue(std::move(*fallbackResult));
+            return;
+        }
+
+        // 耗时记录到回调为止，行数在映射完成后得到。
+        // 追踪 span 在此开始，在执行器线程上结束
+        auto* stats = statementStats(sql, TableMeta<T>::name);
+        auto trace = std::make_shared<Trace>();
+        trace->slow = SlowQueryLog::instance().enabled();
+        trace->traced = Tracer::active();
+        auto start = std::chrono::steady_clock::now();
+        uint64_t bytes = 0;
+        if (stats) {
+            for (const auto& param : params) bytes += uORM::detail::boundBytes(param);
+        }
+        if (trace->slow) trace->params = params;
+        if (trace->slow || trace->traced) trace->sql = sql;
+        if (trace->traced) {
+            trace->span = Tracer::instance().begin(SpanKind::Statement, trace->sql, TableMeta<T>::name,
+                                                   uORM::detail::fingerprint(trace->sql));
+            trace->span.async = true;
+        }
+        auto record = [stats, trace, bytes, pool](uint64_t micros, bool failed, uint64_t rows) {
+            if (stats) stats->record(micros, failed, rows, bytes);
+            auto& slowLog = SlowQueryLog::instance();
+            if (trace->slow && static_cast<long long>(micros) >= slowLog.thresholdMicros()) {
+                slowLog.report(uORM::detail::fingerprint(trace->sql), trace->sql, TableMeta<T>::name, std::move(trace->params),
+                               micros, rows, failed, pool);
+            }
+            if (trace->traced) Tracer::instance().end(trace->span, !failed, rows);
+        };
+
+        // 使用连接上缓存的预编译语句：预编译请求与执行请求按顺序经同一会话发送，不等待预编译完成
+        IPreparedStatement* pstmt = nullptr;
+        try {
+            pstmt = (*conn)->prepareCached(sql);
+            for (size_t i = 0; i < params.size(); ++i) {
+                Base::bindSqlValue(pstmt, static_cast<int>(i + 1), params[i]);
+            }
+        } catch (...) {
+            conn->reset();
+            record(0, true, 0);
+            state->setError(std::current_exception());
+            return;
+        }
+        pstmt->executeQueryAsync([state, conn, cachePoolName, key, version, map, start, record](std::unique_ptr<IResultSet> res, std::exception_ptr error) {
+            // 结果集不依赖连接，先归还连接再切换到执行器映射结果
+            conn->reset();
+            uint64_t micros = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+            std::shared_ptr<IResultSet> rs(std::move(res));
+            AsyncExecutor::instance().executor()->post([state, rs, error, cachePoolName, key, version, map, micros, record] {
+                if (error) {
+                    record(micros, true, 0);
+                    state->setError(error);
+                    return;
+                }
+                std::optional<R> result;
+                try {
+                    result.emplace(map(rs.get()));
+                } catch (...) {
+                    record(micros, true, 0);
+                    state->setError(std::current_exception());
+                    return;
+                }
+                if constexpr (std::is_same_v<R, long long>) record(micros, false, 1);
+                else record(micros, false, result->size());
+                if (!key.empty()) {
+                    if constexpr (std::is_same_v<R, long long>) QueryCache<T>::instance().putCount(*cachePoolName, key, version, *result);
+                    else QueryCache<T>::instance().putRows(*cachePoolName, key, version, *result);
+                }
+                state->setValue(std::move(*result));
+            });
+        });
+    }
+};
+
+} // namespace uORM::co
+
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,163 @@
+#pragma once
+#include "uORM/orm/Reflection.h"
+#include "uORM/orm/Column.h"
+#include "uORM/orm/ShardedLru.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+
+namespace uORM {
+
+// 实体缓存配置
+struct EntityCacheOptions {
+    size_t shards = 16;                       // 分片数量，向上取整为 2 的幂
+    std::chrono::milliseconds ttl{0};         // 条目存活时间，0 表示不过期
+    size_t max_bytes = 64 * 1024 * 1024;      // 内存预算 (估算值)，平均分配到各分片；每个连接池分别计算
+};
+
+// 实体缓存统计
+struct EntityCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;   // 超出内存预算被淘汰的条目
+    uint64_t expirations = 0; // 超过 TTL 被丢弃的条目
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+namespace detail {
+
+template<typename V>
+size_t heapBytes(const V& value) {
+    if constexpr (std::is_same_v<V, std::string>) return value.capacity();
+    else return 0;
+}
+
+// 估算一个实体占用的内存：对象本身加上字符串字段的堆内存
+template<typename T>
+size_t estimateEntityBytes(const T& entity) {
+    size_t bytes = sizeof(T);
+    std::apply([&](const auto&... field) {
+        ((bytes += heapBytes(entity.*(field.member_ptr))), ...);
+    }, TableMeta<T>::get_fields());
+    return bytes;
+}
+
+} // namespace detail
+
+// 进程级实体缓存：以主键为键的分片 LRU，每个表类型独立开启。
+// 条目按连接池 (ConnectionPool::forType<T>() 的名字) 分开存放，PoolScope 切换数据库后不会读到其他库的实体。
+// Mapper<T>::findById 命中时直接返回，不获取数据库连接；
+// Mapper<T>::save / update / remove / truncate 成功后使对应条目失效。
+// 绕过 Mapper 的写入 (原生 SQL、其他进程) 不会被感知，只能依靠 TTL 过期。
+//
+// uORM::EntityCache<Product>::instance().enable({16, std::chrono::seconds(30), 32 << 20});
+template<typename T>
+class EntityCache {
+public:
+    using Key = typename PrimaryKey<T>::Type;
+
+    static EntityCache& instance() {
+        static EntityCache inst;
+        return inst;
+    }
+
+    // 开启缓存。应在初始化阶段、并发访问之前调用；重复调用会清空现有条目并应用新配置
+    void enable(const EntityCacheOptions& options = EntityCacheOptions()) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        options_ = options;
+        pools_.clear();
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    // 关闭缓存并释放所有条目
+    void disable() {
+        enabled_.store(false, std::memory_order_release);
+        clear();
+    }
+
+    bool enabled() const {
+        return enabled_.load(std::memory_order_acquire);
+    }
+
+    // 查找连接池 pool 中的条目。未命中时通过 stamp 返回分片的失效版本号，回填时据此丢弃过期的读取结果
+    std::shared_ptr<const T> get(const std::string& pool, const Key& key, uint64_t* stamp = nullptr) {
+        std::shared_ptr<const T> value;
+        lruFor(pool).get(key, [](const auto&) { return true; }, [&](const auto& entity) { value = entity; }, stamp);
+        return value;
+    }
+
+    // 回填从数据库读取的实体；若读取期间该分片发生过失效 (并发写入)，则放弃回填
+    void fill(const std::string& pool, const T& entity, uint64_t stamp) {
+        lruFor(pool).put(PrimaryKey<T>::get(entity), std::make_shared<const T>(entity), detail::estimateEntityBytes(entity), &stamp);
+    }
+
+    // 使连接池 pool 中的单个主键失效
+    void invalidate(const std::string& pool, const Key& key) {
+        lruFor(pool).invalidate(key);
+    }
+
+    // 清空连接池 pool 的条目
+    void clear(const std::string& pool) {
+        lruFor(pool).clear();
+    }
+
+    // 清空所有连接池的条目
+    void clear() {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (auto& [name, lru] : pools_) lru->clear();
+    }
+
+    EntityCacheStats stats() const {
+        EntityCacheStats total;
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& [name, lru] : pools_) {
+            auto s = lru->stats();
+            total.hits += s.hits;
+            total.misses += s.misses;
+            total.evictions += s.evictions;
+            total.expirations += s.expirations;
+            total.entries += s.entries;
+            total.bytes += s.bytes;
+        }
+        return total;
+    }
+
+    EntityCache(const EntityCache&) = delete;
+    EntityCache& operator=(const EntityCache&) = delete;
+
+private:
+    using Lru = detail::ShardedLru<Key, std::shared_ptr<const T>>;
+
+    EntityCache() = default;
+
+    // 连接池对应的 LRU，首次访问时按 enable 的配置创建。失效也会创建，保证之后的回填能看到 generation 的变化
+    Lru& lruFor(const std::string& pool) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = pools_.find(pool);
+            if (it != pools_.end()) return *it->second;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto& slot = pools_[pool];
+        if (!slot) {
+            slot = std::make_unique<Lru>();
+            slot->enable(options_.shards, options_.ttl, options_.max_bytes);
+        }
+        return *slot;
+    }
+
+    mutable std::shared_mutex mutex_;
+    EntityCacheOptions options_;
+    std::unordered_map<std::string, std::unique_ptr<Lru>> pools_;
+    std::atomic<bool> enabled_{false};
+};
+
+} // namespace uORM
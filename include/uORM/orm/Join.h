@@ -0,0 +1,35 @@
+#pragma once
+#include "uORM/orm/Column.h"
+#include "uORM/orm/Error.h"
+#include "uORM/driver/SqlDialect.h"
+#include <string>
+
+namespace uORM {
+
+// JOIN 条件：两端分别为左表和右表已注册的列
+struct JoinOn {
+    const char* left_table;
+    const char* left_column;
+    const char* right_table;
+    const char* right_column;
+
+    // 生成 "orders"."product_id" = "products"."id"
+    std::string render(const ISqlDialect& dialect) const {
+        return dialect.quoteIdentifier(left_table) + "." + dialect.quoteIdentifier(left_column) + " = " +
+               dialect.quoteIdentifier(right_table) + "." + dialect.quoteIdentifier(right_column);
+    }
+};
+
+// 由成员指针构造 JOIN 条件：uORM::on(&Order::product_id, &Product::id)
+template<typename L, typename LK, typename R, typename RK>
+JoinOn on(LK L::* left, RK R::* right) {
+    static_assert(std::is_arithmetic_v<LK> == std::is_arithmetic_v<RK>, "JOIN 两端列的类型不兼容");
+    const char* leftColumn = columnNameOf(left);
+    const char* rightColumn = columnNameOf(right);
+    if (!leftColumn || !rightColumn) {
+        throw OrmError("JOIN 条件中的成员未注册为字段");
+    }
+    return JoinOn{TableMeta<L>::name, leftColumn, TableMeta<R>::name, rightColumn};
+}
+
+} // namespace uORM
@@ -0,0 +1,361 @@
+#pragma once
+// 文件说明：
+// uORM 内部日志。库中的诊断输出都经过 Logger，不直接写 std::cout / std::cerr。
+//
+//   uORM::Logger::instance().setLevel(uORM::LogLevel::Warn);
+//   uORM::Logger::instance().setSink(std::make_shared<uORM::NullSink>());   // 关闭全部输出
+//   uORM::Logger::warn("连接失败: ", e.what());
+//
+// 默认 sink 是包裹 ConsoleSink 的 AsyncSink：调用线程只把记录放入无锁环形缓冲区，
+// 由后台线程写到标准错误，缓冲区满时丢弃新记录并计数，调用方不会因控制台 I/O 阻塞。
+// 低于当前级别的日志在格式化之前返回。
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace uORM {
+
+enum class LogLevel { Trace = 0, Debug, Info, Warn, Error, Off };
+
+inline const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warn: return "WARN";
+        case LogLevel::Error: return "ERROR";
+        default: return "OFF";
+    }
+}
+
+struct LogRecord {
+    LogLevel level = LogLevel::Info;
+    std::chrono::system_clock::time_point time;
+    std::string message;
+};
+
+// 日志输出端。write 可能被多个线程同时调用 (AsyncSink 只在后台线程调用内层 sink)
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+    virtual void write(const LogRecord& record) = 0;
+    virtual void flush() {}
+};
+
+// 丢弃全部日志
+class NullSink : public LogSink {
+public:
+    void write(const LogRecord&) override {}
+};
+
+// 同步写入 stdio 流 (默认标准错误)，每条记录一次 fwrite，不在每行后刷新
+class ConsoleSink : public LogSink {
+public:
+    explicit ConsoleSink(std::FILE* stream = stderr) : stream_(stream) {}
+
+    void write(const LogRecord& record) override {
+        std::string line = format(record);
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fwrite(line.data(), 1, line.size(), stream_);
+    }
+
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::fflush(stream_);
+    }
+
+    // "2026-01-01T00:00:00.123Z [WARN] uORM: message\n"
+    static std::string format(const LogRecord& record) {
+        auto sinceEpoch = record.time.time_since_epoch();
+        std::time_t t = std::chrono::system_clock::to_time_t(record.time);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch).count() % 1000;
+        std::tm tm{};
+        gmtime_r(&t, &tm);
+        char ts[40];
+        size_t n = std::strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%S", &tm);
+        std::snprintf(ts + n, sizeof(ts) - n, ".%03dZ", static_cast<int>(millis));
+
+        std::string line;
+        line.reserve(record.message.size() + 48);
+        line += ts;
+        line += " [";
+        line += logLevelName(record.level);
+        line += "] uORM: ";
+        line += record.message;
+        line += '\n';
+        return line;
+    }
+
+private:
+    std::FILE* stream_;
+    std::mutex mutex_;
+};
+
+// 异步 sink：多个生产者无锁写入固定容量的环形缓冲区 (每个槽位带序号，Vyukov 有界队列)，
+// 一个后台线程取出记录交给内层 sink。缓冲区满时丢弃新记录，dropped() 返回丢弃数量。
+// 停止后 (stop 或进程退出) 的记录直接同步写入内层 sink
+class AsyncSink : public LogSink {
+public:
+    explicit AsyncSink(std::shared_ptr<LogSink> inner, size_t capacity = 8192)
+        : inner_(std::move(inner)), mask_(roundUp(capacity) - 1), cells_(mask_ + 1) {
+        for (size_t i = 0; i <= mask_; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+        worker_ = std::thread([this] { work(); });
+    }
+
+    ~AsyncSink() override {
+        stop();
+    }
+
+    void write(const LogRecord& record) override {
+        if (stopped_.load(std::memory_order_acquire)) {
+            inner_->write(record);
+            return;
+        }
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->record = record;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        if (sleeping_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cond_.notify_one();
+        }
+    }
+
+    // 等待此前写入的记录全部交给内层 sink 并刷新
+    void flush() override {
+        size_t target = tail_.load(std::memory_order_acquire);
+        while (head_.load(std::memory_order_acquire) < target && !stopped_.load(std::memory_order_acquire)) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                cond_.notify_one();
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        inner_->flush();
+    }
+
+    // 写完缓冲区中的记录后停止后台线程
+    void stop() {
+        if (stopping_.exchange(true)) {
+            if (worker_.joinable() && worker_.get_id() != std::this_thread::get_id()) worker_.join();
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cond_.notify_one();
+        }
+        if (worker_.joinable()) worker_.join();
+    }
+
+    uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        LogRecord record;
+    };
+
+    static size_t roundUp(size_t n) {
+        size_t size = 2;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    // 只有后台线程消费，head_ 无需 CAS
+    bool pop(LogRecord& out) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[pos & mask_];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1) < 0) return false;
+        out = std::move(cell.record);
+        cell.record.message.clear();
+        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    void work() {
+        LogRecord record;
+        for (;;) {
+            bool any = false;
+            while (pop(record)) {
+                any = true;
+                try {
+                    inner_->write(record);
+                } catch (...) {
+                }
+            }
+            if (any) {
+                try {
+                    inner_->flush();
+                } catch (...) {
+                }
+            }
+            if (stopping_.load(std::memory_order_acquire)) {
+                // 生产者看到 stopped_ 后改为同步写入；之前已占用的槽位在此写完
+                stopped_.store(true, std::memory_order_release);
+                while (head_.load(std::memory_order_relaxed) < tail_.load(std::memory_order_acquire)) {
+                    if (pop(record)) {
+                        try {
+                            inner_->write(record);
+                        } catch (...) {
+                        }
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                inner_->flush();
+                return;
+            }
+            // 进入等待前再检查一次，生产者在 sleeping_ 置位后会唤醒；超时兜底错过的通知
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleeping_.store(true, std::memory_order_release);
+            if (head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire) &&
+                !stopping_.load(std::memory_order_acquire)) {
+                cond_.wait_for(lock, std::chrono::milliseconds(50));
+            }
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    std::shared_ptr<LogSink> inner_;
+    size_t mask_;
+    std::vector<Cell> cells_;
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::atomic<size_t> head_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> sleeping_{false};
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> stopped_{false};
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread worker_;
+};
+
+class Logger {
+public:
+    // 单例不析构，其他单例在析构时仍可记录日志；进程退出时写完异步缓冲区中的记录
+    static Logger& instance() {
+        static Logger* inst = [] {
+            auto* logger = new Logger();
+            std::atexit([] { Logger::instance().shutdown(); });
+            return logger;
+        }();
+        return *inst;
+    }
+
+    void setLevel(LogLevel level) {
+        level_.store(level, std::memory_order_relaxed);
+    }
+
+    LogLevel level() const {
+        return level_.load(std::memory_order_relaxed);
+    }
+
+    bool enabled(LogLevel level) const {
+        return level >= level_.load(std::memory_order_relaxed) && level != LogLevel::Off;
+    }
+
+    // 替换 sink，原 sink 先刷新；传入空指针等同于 NullSink
+    void setSink(std::shared_ptr<LogSink> sink) {
+        if (!sink) sink = std::make_shared<NullSink>();
+        auto old = std::atomic_exchange(&sink_, std::move(sink));
+        if (old) old->flush();
+    }
+
+    std::shared_ptr<LogSink> sink() const {
+        return std::atomic_load(&sink_);
+    }
+
+    void write(LogLevel level, std::string message) {
+        if (!enabled(level)) return;
+        LogRecord record;
+        record.level = level;
+        record.time = std::chrono::system_clock::now();
+        record.message = std::move(message);
+        auto target = sink();
+        try {
+            target->write(record);
+        } catch (...) {
+            // 日志失败不影响调用方
+        }
+    }
+
+    template<typename... Args>
+    void log(LogLevel level, const Args&... args) {
+        if (!enabled(level)) return;
+        std::ostringstream ss;
+        (ss << ... << args);
+        write(level, ss.str());
+    }
+
+    template<typename... Args>
+    static void debug(const Args&... args) {
+        instance().log(LogLevel::Debug, args...);
+    }
+
+    template<typename... Args>
+    static void info(const Args&... args) {
+        instance().log(LogLevel::Info, args...);
+    }
+
+    template<typename... Args>
+    static void warn(const Args&... args) {
+        instance().log(LogLevel::Warn, args...);
+    }
+
+    template<typename... Args>
+    static void error(const Args&... args) {
+        instance().log(LogLevel::Error, args...);
+    }
+
+    void flush() {
+        sink()->flush();
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+private:
+    Logger() : sink_(std::make_shared<AsyncSink>(std::make_shared<ConsoleSink>())) {}
+
+    void shutdown() {
+        auto current = sink();
+        if (auto async = std::dynamic_pointer_cast<AsyncSink>(current)) {
+            async->stop();
+        } else {
+            current->flush();
+        }
+    }
+
+    std::atomic<LogLevel> level_{LogLevel::Info};
+    std::shared_ptr<LogSink> sink_;   // 通过 std::atomic_load / atomic_exchange 访问
+};
+
+} // namespace uORM
@@ -4,20 +4,45 @@
 #include <string> 
 #include <vector> 
 #include <sstream> 
-#include <iostream> 
 #include <optional> 
+#include <tuple> 
+#include <algorithm> 
+#include <cstring> 
 #include "uORM/orm/Query.h"
+#include "uORM/orm/Relation.h"
+#include "uORM/orm/Join.h"
+#include "uORM/orm/EntityCache.h"
+#include "uORM/orm/QueryCache.h"
+#include "uORM/orm/Async.h"
+#include "uORM/orm/Pipeline.h"
+#include "uORM/orm/SlowQueryLog.h"
+#ifdef USE_REDIS
+#include "uORM/orm/RedisCache.h"
+#endif
 
 namespace uORM { 
 
-// Mapper 类提供实体对象的 CRUD 操作
+template<typename T, typename Driver = DefaultDriver> 
+class CompiledQuery; 
+
+namespace co { 
 template<typename T> 
+class Mapper; 
+} 
+
+// Mapper 类提供实体对象的 CRUD 操作。
+// Driver 为驱动策略 (见 DriverPolicy.h)，默认 DefaultDriver；
+// 使用 StaticDriver 时参数绑定与结果映射直接调用具体驱动类，不经过虚函数。
+// 连接池配置了只读副本时，select / count / findById / findAll / join 在副本上执行，save / update / remove / truncate 在主库上执行；
+// 结果要写入缓存的查询在主库上执行，原生 SQL 的 find / findOne 默认在主库上执行 (见 ReplicaRead)
+template<typename T, typename Driver> 
 class Mapper { 
 public: 
     // 保存实体到数据库 (INSERT)
     // 返回 true 表示成功。
     static bool save(const T& entity) { 
-        auto dialect = ConnectionPool::instance().getDialect(); 
+        auto& pool = ConnectionPool::forType<T>(); 
+        auto dialect = Driver::dialect(pool); 
         if (!dialect) return false; 
 
         std::stringstream ss; 
@@ -56,26 +81,29 @@ public:
             ss << " " << dialect->getLastInsertIdSql(); 
         } 
         
+        std::string sql = ss.str(); 
         try { 
-            auto connPtr = ConnectionPool::instance().getConnection(); 
-            auto pstmt = connPtr->prepareStatement(ss.str()); 
+            auto connPtr = pool.getConnection(); 
+            StatementTimer timer(sql, TableMeta<T>::name, &pool); 
+            auto pstmt = connPtr->prepareStatement(sql); 
             
             // 绑定参数值
             int index = 1; 
             std::apply([&](auto&&... field) { 
                 (( 
                     (!shouldSkipInsert(field, entity) ? ( 
-                        bindValue(pstmt.get(), index++, entity.*(field.member_ptr)), 0 // 修复: 逗号表达式确保返回 void 兼容类型或整数
+                        bindValue(pstmt.get(), index++, entity.*(field.member_ptr)), timer.bound(entity.*(field.member_ptr)), 0 // 修复: 逗号表达式确保返回 void 兼容类型或整数
                     ) : 0) 
                 ), ...); 
             }, fields); 
             
             if (dialect->supportsReturningId()) { 
-                auto res = pstmt->executeQuery(); 
+                auto res = Driver::statement(pstmt.get())->executeQuery(); 
                 // PG: 这里可以获取 ID
             } else { 
-                pstmt->executeUpdate(); 
+                Driver::statement(pstmt.get())->executeUpdate(); 
             } 
+            invalidateCached(pool, entity);
             return true; 
         } catch (const uORM::Exception& e) {
             throw; // Re-throw uORM exceptions
@@ -87,7 +115,8 @@ public:
     // 更新实体 (UPDATE)
     // 根据主键更新所有字段 (除主键外)
     static bool update(const T& entity) {
-        auto dialect = ConnectionPool::instance().getDialect(); 
+        auto& pool = ConnectionPool::forType<T>(); 
+        auto dialect = Driver::dialect(pool); 
         if (!dialect) return false; 
 
         std::stringstream ss; 
@@ -118,16 +147,18 @@ public:
             ), ...); 
         }, fields); 
         
+        std::string sql = ss.str(); 
         try {
-            auto connPtr = ConnectionPool::instance().getConnection(); 
-            auto pstmt = connPtr->prepareStatement(ss.str()); 
+            auto connPtr = pool.getConnection(); 
+            StatementTimer timer(sql, TableMeta<T>::name, &pool); 
+            auto pstmt = connPtr->prepareStatement(sql); 
             
             int index = 1; 
             // Bind SET values
             std::apply([&](auto&&... field) { 
                 (( 
                     (!isPrimaryKey(field.constraint_sql) ? ( 
-                        bindValue(pstmt.get(), index++, entity.*(field.member_ptr)), 0
+                        bindValue(pstmt.get(), index++, entity.*(field.member_ptr)), timer.bound(entity.*(field.member_ptr)), 0
                     ) : 0) 
                 ), ...); 
             }, fields); 
@@ -136,12 +167,13 @@ public:
             std::apply([&](auto&&... field) { 
                 (( 
                     (isPrimaryKey(field.constraint_sql) ? ( 
-                        bindValue(pstmt.get(), index++, entity.*(field.member_ptr)), 0
+                        bindValue(pstmt.get(), index++, entity.*(field.member_ptr)), timer.bound(entity.*(field.member_ptr)), 0
                     ) : 0) 
                 ), ...); 
             }, fields); 
             
-            pstmt->executeUpdate(); 
+            Driver::statement(pstmt.get())->executeUpdate(); 
+            invalidateCached(pool, entity);
             return true; 
         } catch (const uORM::Exception& e) {
             throw; // Re-throw uORM exceptions
@@ -153,7 +185,8 @@ public:
     // 删除实体 (DELETE)
     // 根据主键删除
     static bool remove(const T& entity) {
-        auto dialect = ConnectionPool::instance().getDialect(); 
+        auto& pool = ConnectionPool::forType<T>(); 
+        auto dialect = Driver::dialect(pool); 
         if (!dialect) return false; 
 
         std::stringstream ss; 
@@ -170,20 +203,23 @@ public:
             ), ...); 
         }, fields); 
         
+        std::string sql = ss.str(); 
         try {
-            auto connPtr = ConnectionPool::instance().getConnection(); 
-            auto pstmt = connPtr->prepareStatement(ss.str()); 
+            auto connPtr = pool.getConnection(); 
+            StatementTimer timer(sql, TableMeta<T>::name, &pool); 
+            auto pstmt = connPtr->prepareStatement(sql); 
             
             int index = 1; 
             std::apply([&](auto&&... field) { 
                 (( 
                     (isPrimaryKey(field.constraint_sql) ? ( 
-                        bindValue(pstmt.get(), index++, entity.*(field.member_ptr)), 0
+                        bindValue(pstmt.get(), index++, entity.*(field.member_ptr)), timer.bound(entity.*(field.member_ptr)), 0
                     ) : 0) 
                 ), ...); 
             }, fields); 
             
-            pstmt->executeUpdate(); 
+            Driver::statement(pstmt.get())->executeUpdate(); 
+            invalidateCached(pool, entity);
             return true; 
         } catch (const uORM::Exception& e) {
             throw; // Re-throw uORM exceptions
@@ -194,15 +230,25 @@ public:
 
     // 清空表数据 (TRUNCATE)
     static bool truncate() {
-        auto dialect = ConnectionPool::instance().getDialect();
+        auto& pool = ConnectionPool::forType<T>();
+        auto dialect = Driver::dialect(pool);
         if (!dialect) return false;
 
-        std::string sql = "TRUNCATE TABLE " + dialect->quoteIdentifier(TableMeta<T>::name);
+        std::string sql = dialect->truncateTableSql(dialect->quoteIdentifier(TableMeta<T>::name));
         
         try {
-            auto connPtr = ConnectionPool::instance().getConnection();
-            auto stmt = connPtr->createStatement();
-            stmt->execute(sql);
+            auto connPtr = pool.getConnection();
+            {
+                StatementTimer timer(sql, TableMeta<T>::name, &pool);
+                connPtr->createStatement()->execute(sql);
+            }
+            tableVersion(pool.name()).fetch_add(1, std::memory_order_acq_rel);
+            if constexpr (detail::primaryKeyCount<T>() == 1) {
+                EntityCache<T>::instance().clear(pool.name());
+            }
+#ifdef USE_REDIS
+            if (RedisCache<T>::instance().enabled()) RedisCache<T>::instance().onTruncate(pool.name());
+#endif
             return true;
         } catch (const uORM::Exception& e) {
             throw; // Re-throw uORM exceptions
@@ -212,63 +258,215 @@ public:
     }
 
     // 查询所有实体
-    static std::vector<T> findAll() { 
-        auto dialect = ConnectionPool::instance().getDialect(); 
+    static EntityList<T> findAll() { 
+        auto dialect = Driver::dialect(ConnectionPool::forType<T>()); 
         if (!dialect) return {}; 
 
         std::string sql = "SELECT * FROM " + dialect->quoteIdentifier(TableMeta<T>::name); 
-        return executeQuery(sql);
+        return executeQuery(ConnectionPool::forRead<T>(), sql);
     } 
     
-    // 根据条件查询单个实体 (支持占位符)
+    // 根据条件查询单个实体 (支持占位符)，在主库上执行
     // 例如: findOne("username = ?", "Alice")
     template<typename... Args>
     static std::optional<T> findOne(const std::string& whereClause, Args&&... args) {
-        auto dialect = ConnectionPool::instance().getDialect();
-        if (!dialect) return std::nullopt;
-        
-        std::string sql = "SELECT * FROM " + dialect->quoteIdentifier(TableMeta<T>::name);
-        if (!whereClause.empty()) {
-            sql += " WHERE " + whereClause;
-        }
-        sql += " LIMIT 1";
-        
-        auto list = executeQuery(sql, std::forward<Args>(args)...);
-        if (list.empty()) return std::nullopt;
-        return list[0];
+        return findOneIn(ConnectionPool::forType<T>(), whereClause, std::forward<Args>(args)...);
+    }
+
+    // 条件只读时允许在只读副本上执行: findOne(uORM::replicaRead, "username = ?", "Alice")
+    template<typename... Args>
+    static std::optional<T> findOne(ReplicaRead, const std::string& whereClause, Args&&... args) {
+        return findOneIn(ConnectionPool::forRead<T>(), whereClause, std::forward<Args>(args)...);
     }
     
-    // 根据条件查询列表 (支持占位符)
+    // 根据条件查询列表 (支持占位符)，在主库上执行
     // 例如: find("age > ? AND gender = ?", 18, "male")
     template<typename... Args>
-    static std::vector<T> find(const std::string& whereClause, Args&&... args) {
-        auto dialect = ConnectionPool::instance().getDialect();
-        if (!dialect) return {};
-        
-        std::string sql = "SELECT * FROM " + dialect->quoteIdentifier(TableMeta<T>::name);
-        if (!whereClause.empty()) {
-            sql += " WHERE " + whereClause;
-        }
-        return executeQuery(sql, std::forward<Args>(args)...);
+    static EntityList<T> find(const std::string& whereClause, Args&&... args) {
+        return findIn(ConnectionPool::forType<T>(), whereClause, std::forward<Args>(args)...);
+    }
+
+    // 条件只读时允许在只读副本上执行: find(uORM::replicaRead, "age > ?", 18)
+    template<typename... Args>
+    static EntityList<T> find(ReplicaRead, const std::string& whereClause, Args&&... args) {
+        return findIn(ConnectionPool::forRead<T>(), whereClause, std::forward<Args>(args)...);
     }
 
     // 使用 Query 构造器查询列表
-    static std::vector<T> select(const Query& query) {
-        auto dialect = ConnectionPool::instance().getDialect();
+    // 返回的 EntityList 可以链式预加载关联: select(query).with<&Order::product>()
+    // 开启 QueryCache<T> 后，相同 SQL 与参数的查询直接返回缓存结果
+    static EntityList<T> select(const Query& query) {
+        auto& pool = ConnectionPool::forType<T>();
+        auto dialect = Driver::dialect(pool);
         if (!dialect) return {};
+        std::optional<PrimaryReadScope> primary;
+        if (query.readsPrimary()) primary.emplace();
         
-        std::string sql = "SELECT * FROM " + dialect->quoteIdentifier(TableMeta<T>::name);
-        
-        std::string where = query.getWhere();
+        std::string sql = buildSelectSql(*dialect, query);
+
+        auto& cache = QueryCache<T>::instance();
+        const bool cached = cache.enabled();
+#ifdef USE_REDIS
+        auto& shared = RedisCache<T>::instance();
+        const bool sharedCached = shared.cachesQueries();
+#else
+        const bool sharedCached = false;
+#endif
+        if (!cached && !sharedCached) {
+            return selectSql(*dialect, sql, query);
+        }
+
+        // 缓存键与表版本都按连接池区分，PoolScope 切换数据库后不会读到其他库的结果
+        const std::string& poolName = pool.name();
+        std::string key = QueryCache<T>::makeKey(poolName, 'S', sql, query.getParams());
+        uint64_t version = cache.version(poolName);
+        if (cached) {
+            if (auto rows = cache.getRows(key)) return std::vector<T>(*rows);
+        }
+#ifdef USE_REDIS
+        uint64_t sharedVersion = 0;
+        if (sharedCached) {
+            if (auto rows = shared.getRows(poolName, key, sharedVersion)) {
+                if (cached) cache.putRows(poolName, key, version, *rows);
+                return std::move(*rows);
+            }
+        }
+#endif
+
+        // 写入缓存的结果从主库读取，副本上滞后的数据不能以当前版本缓存
+        if (!primary) primary.emplace();
+        auto results = selectSql(*dialect, sql, query);
+        if (cached) cache.putRows(poolName, key, version, results);
+#ifdef USE_REDIS
+        if (sharedCached) shared.putRows(poolName, key, sharedVersion, results);
+#endif
+        return results;
+    }
+
+    // 两表 JOIN 查询，一次往返同时返回两侧实体。两侧列按位置以 l0, l1, ... / r0, r1, ... 为别名选出，
+    // WHERE 条件中两表同名的列需要带表名；两个类型绑定到不同连接池时抛出 OrmError。例如:
+    // Mapper<Order>::join<Product>(uORM::on(&Order::product_id, &Product::id), Query().eq("products.category", "Home"))
+    template<typename U>
+    static std::vector<std::tuple<T, U>> join(const JoinOn& on, const Query& query = Query()) {
+        std::vector<std::tuple<T, U>> results;
+        joinEach<U>(on, query, [&](T&& left, U&& right) {
+            results.emplace_back(std::move(left), std::move(right));
+        });
+        return results;
+    }
+
+    // 流式 JOIN 查询：逐行回调 fn(T&&, U&&)，不在内存中保存完整结果
+    template<typename U, typename Fn>
+    static void joinEach(const JoinOn& on, const Query& query, Fn&& fn) {
+        static_assert(is_registered_v<U>, "类型必须使用 UORM_TABLE 宏进行注册");
+        static_assert(!std::is_same_v<T, U>, "JOIN 不支持同一类型的自连接");
+
+        // JOIN 只在 T 的连接池上执行，两侧实体必须位于同一个库
+        if (&ConnectionPool::forType<U>() != &ConnectionPool::forType<T>()) {
+            throw OrmError(std::string("JOIN 的两张表位于不同的连接池: ") + TableMeta<T>::name + ", " + TableMeta<U>::name);
+        }
+
+        auto& pool = ConnectionPool::forRead<T>(query.readsPrimary());
+        auto dialect = Driver::dialect(pool);
+        if (!dialect) return;
+
+        std::string sql = "SELECT ";
+        appendAliasedColumns<'l'>(sql, *dialect);
+        sql += ", ";
+        Mapper<U, Driver>::template appendAliasedColumns<'r'>(sql, *dialect);
+        sql += " FROM " + dialect->quoteIdentifier(TableMeta<T>::name);
+        sql += " INNER JOIN " + dialect->quoteIdentifier(TableMeta<U>::name);
+        sql += " ON " + on.render(*dialect);
+
+        std::string_view where = query.getWhere();
         if (!where.empty()) {
-            sql += " WHERE " + where;
+            sql += " WHERE ";
+            sql += where;
         }
-        
         sql += query.getOrderBy();
         sql += query.getLimit();
         sql += query.getOffset();
-        
-        return executeQueryWithParams(sql, query.getParams());
+
+        // JOIN 结果依赖完整的条件组合，IN 列表不拆分为多条语句，超过上限的列表改为查询临时表
+        BoundStatement stmt;
+        if (hasInList(query.getParams())) {
+            stmt = std::move(expandInLists(sql, query.getParams(), *dialect, false)[0]);
+        } else {
+            stmt.sql = std::move(sql);
+            stmt.params.assign(query.getParams().begin(), query.getParams().end());
+        }
+
+        try {
+            auto connPtr = pool.getConnection();
+            std::optional<InListTableScope> inLists;
+            if (!stmt.tables.empty()) inLists.emplace(*connPtr, *dialect, stmt.tables);
+            StatementTimer timer(stmt.sql, TableMeta<T>::name, &pool);
+            timer.bound(ParamView(stmt.params));
+            auto pstmt = connPtr->prepareStatement(stmt.sql);
+            for (size_t i = 0; i < stmt.params.size(); ++i) {
+                bindSqlValue(pstmt.get(), i + 1, stmt.params[i]);
+            }
+
+            auto res = Driver::statement(pstmt.get())->executeQuery();
+            auto* rs = Driver::resultSet(res.get());
+            while (rs->next()) {
+                T left = mapAliasedRow<'l'>(rs);
+                U right = Mapper<U, Driver>::template mapAliasedRow<'r'>(rs);
+                fn(std::move(left), std::move(right));
+                timer.rows(1);
+            }
+        } catch (const uORM::Exception& e) {
+            throw; // Re-throw uORM exceptions
+        } catch (const std::exception& e) {
+            throw SqlError(std::string("JOIN 查询失败: ") + e.what());
+        }
+    }
+
+    // 将含占位符的 Query 预编译为可重复执行的查询，例如：
+    // auto byCategory = Mapper<Product>::compile(Query().eq(&Product::category, uORM::placeholder));
+    // auto list = byCategory.execute("Electronics");
+    static CompiledQuery<T, Driver> compile(const Query& query) {
+        return CompiledQuery<T, Driver>(query);
+    }
+
+    // 按主键查询单个实体。开启 EntityCache<T> 后命中缓存时直接返回，不获取数据库连接
+    template<typename K>
+    static std::optional<T> findById(const K& id) {
+        static_assert(detail::primaryKeyCount<T>() == 1, "findById 要求表有且只有一个 PRIMARY KEY 字段");
+        using Key = typename PrimaryKey<T>::Type;
+        const Key key(id);
+        const std::string& pool = ConnectionPool::forType<T>().name();
+
+        auto& cache = EntityCache<T>::instance();
+        const bool cached = cache.enabled();
+        bool fillsCache = cached;
+        uint64_t stamp = 0;
+        if (cached) {
+            if (auto hit = cache.get(pool, key, &stamp)) return *hit;
+        }
+#ifdef USE_REDIS
+        auto& shared = RedisCache<T>::instance();
+        const bool sharedCached = shared.cachesEntities();
+        fillsCache = fillsCache || sharedCached;
+        uint64_t epoch = 0;
+        if (sharedCached) {
+            if (auto hit = shared.getEntity(pool, key, epoch)) {
+                if (cached) cache.fill(pool, *hit, stamp);
+                return hit;
+            }
+        }
+#endif
+
+        // 回填缓存的实体从主库读取，副本上滞后的数据不能写入缓存
+        Query query;
+        query.eq(PrimaryKey<T>::name, key).limit(1);
+        if (fillsCache) query.fromPrimary();
+        auto result = selectOne(query);
+        if (result && cached) cache.fill(pool, *result, stamp);
+#ifdef USE_REDIS
+        if (result && sharedCached) shared.fillEntity(pool, *result, epoch);
+#endif
+        return result;
     }
 
     // 使用 Query 构造器查询单个实体
@@ -280,38 +478,299 @@ public:
 
     // 统计记录数
     static long long count(const Query& query = Query()) {
-        auto dialect = ConnectionPool::instance().getDialect();
+        auto& pool = ConnectionPool::forType<T>();
+        auto dialect = Driver::dialect(pool);
         if (!dialect) return 0;
+        std::optional<PrimaryReadScope> primary;
+        if (query.readsPrimary()) primary.emplace();
+
+        std::string sql = buildCountSql(*dialect, query);
+
+        auto& cache = QueryCache<T>::instance();
+        const bool cached = cache.enabled();
+#ifdef USE_REDIS
+        auto& shared = RedisCache<T>::instance();
+        const bool sharedCached = shared.cachesQueries();
+#else
+        const bool sharedCached = false;
+#endif
+        if (!cached && !sharedCached) {
+            return countSql(*dialect, sql, query);
+        }
+
+        const std::string& poolName = pool.name();
+        std::string key = QueryCache<T>::makeKey(poolName, 'C', sql, query.getParams());
+        uint64_t version = cache.version(poolName);
+        long long total = 0;
+        if (cached && cache.getCount(key, total)) {
+            return total;
+        }
+#ifdef USE_REDIS
+        uint64_t sharedVersion = 0;
+        if (sharedCached && shared.getCount(poolName, key, total, sharedVersion)) {
+            if (cached) cache.putCount(poolName, key, version, total);
+            return total;
+        }
+#endif
+
+        // 写入缓存的结果从主库读取，副本上滞后的数据不能以当前版本缓存
+        if (!primary) primary.emplace();
+        total = countSql(*dialect, sql, query);
+        if (cached) cache.putCount(poolName, key, version, total);
+#ifdef USE_REDIS
+        if (sharedCached) shared.putCount(poolName, key, sharedVersion, total);
+#endif
+        return total;
+    }
+
+    // 异步接口：在 AsyncExecutor 上执行，互不依赖的查询可以并行占用不同的连接。
+    // 提交时确定连接池，查询在执行时选择只读副本；调用方的 PoolScope 与 PrimaryReadScope 在任务中同样生效
+    // 查询中借用调用方内存的参数 (const char*、string_view) 在提交前复制，调用方的字符串可以在任务执行前失效
+    // auto [list, total] = uORM::whenAll(Mapper<Product>::selectAsync(q), Mapper<Product>::countAsync(q));
+    static std::future<EntityList<T>> selectAsync(Query query) {
+        query.ownParams();
+        return AsyncExecutor::instance().submit([pool = &ConnectionPool::forType<T>(), primary = PrimaryReadScope::active(), query = std::move(query)] {
+            PoolScope scope(*pool, primary);
+            return select(query);
+        });
+    }
+
+    static std::future<long long> countAsync(Query query = Query()) {
+        query.ownParams();
+        return AsyncExecutor::instance().submit([pool = &ConnectionPool::forType<T>(), primary = PrimaryReadScope::active(), query = std::move(query)] {
+            PoolScope scope(*pool, primary);
+            return count(query);
+        });
+    }
+
+    static std::future<bool> saveAsync(T entity) {
+        return AsyncExecutor::instance().submit([pool = &ConnectionPool::forType<T>(), primary = PrimaryReadScope::active(), entity = std::move(entity)] {
+            PoolScope scope(*pool, primary);
+            return save(entity);
+        });
+    }
+
+    // 流水线操作：加入 uORM::Pipeline，与其他语句一起发送
+    // auto list = pipeline.add(Mapper<Product>::selectOp(q)); pipeline.run(); list.get();
+    static PipelineOp<EntityList<T>> selectOp(const Query& query) {
+        PipelineOp<EntityList<T>> op;
+        auto& pool = ConnectionPool::forType<T>();
+        op.pool = &pool;
+        op.readOnly = !query.readsPrimary();
+        auto dialect = Driver::dialect(pool);
+        if (!dialect) return op;
+        bool allowChunk = query.getOrderBy().empty() && query.getLimit().empty() && query.getOffset().empty();
+        op.statements = pipelineStatements(*dialect, buildSelectSql(*dialect, query), query, allowChunk);
+        op.accumulate = [](IResultSet* res, EntityList<T>& rows) {
+            auto* rs = Driver::resultSet(res);
+            while (rs->next()) rows.push_back(mapRow(rs));
+        };
+        return op;
+    }
+
+    static PipelineOp<long long> countOp(const Query& query = Query()) {
+        PipelineOp<long long> op;
+        auto& pool = ConnectionPool::forType<T>();
+        op.pool = &pool;
+        op.readOnly = !query.readsPrimary();
+        auto dialect = Driver::dialect(pool);
+        if (!dialect) return op;
+        op.statements = pipelineStatements(*dialect, buildCountSql(*dialect, query), query, true);
+        op.accumulate = [](IResultSet* res, long long& total) {
+            auto* rs = Driver::resultSet(res);
+            if (rs->next()) total += rs->getInt64("count_val");
+        };
+        return op;
+    }
+
+private: 
+    template<typename, typename> friend class CompiledQuery;
+    template<typename, typename> friend class Mapper;
+    template<typename> friend class co::Mapper;
+
+    using ArrayParam = std::shared_ptr<const SqlArray>;
+
+    // 写入会话级临时表的 IN 列表，执行语句前在同一连接上创建并填充
+    struct InListTable {
+        std::string name;               // 已引用的表名
+        std::string createSql;
+        std::vector<SqlValue> values;   // 已去重
+    };
 
-        std::string sql = "SELECT COUNT(*) AS count_val FROM " + dialect->quoteIdentifier(TableMeta<T>::name);
+    // 方言展开 IN 列表后得到的一条语句
+    struct BoundStatement {
+        std::string sql;
+        std::vector<SqlValue> params;
+        std::vector<InListTable> tables;
+    };
+
+    // 在连接上创建并填充语句引用的 IN 列表临时表，离开作用域时删除。
+    // 先删除同名表：此前的执行中断时，表可能还留在归还的连接上
+    class InListTableScope {
+    public:
+        InListTableScope(IConnection& conn, const ISqlDialect& dialect, const std::vector<InListTable>& tables)
+            : conn_(conn), dialect_(dialect), tables_(tables) {
+            try {
+                for (const auto& table : tables_) {
+                    auto stmt = conn_.createStatement();
+                    stmt->execute(dialect_.dropInListTableSql(table.name));
+                    stmt->execute(table.createSql);
+                    ++created_;
+                    fill(table);
+                }
+            } catch (...) {
+                drop();
+                throw;
+            }
+        }
+
+        ~InListTableScope() { drop(); }
+
+        InListTableScope(const InListTableScope&) = delete;
+        InListTableScope& operator=(const InListTableScope&) = delete;
+
+    private:
+        // 每条 INSERT 最多 maxInListSize() 行，与展开 IN 列表的占位符上限一致
+        void fill(const InListTable& table) {
+            const size_t batch = dialect_.maxInListSize();
+            for (size_t begin = 0; begin < table.values.size(); begin += batch) {
+                size_t end = std::min(begin + batch, table.values.size());
+                std::string sql = "INSERT INTO " + table.name + " (v) VALUES ";
+                for (size_t i = begin; i < end; ++i) sql += (i == begin ? "(?)" : ", (?)");
+                auto pstmt = conn_.prepareStatement(sql);
+                for (size_t i = begin; i < end; ++i) {
+                    bindSqlValue(pstmt.get(), static_cast<int>(i - begin + 1), table.values[i]);
+                }
+                pstmt->executeUpdate();
+            }
+        }
+
+        void drop() noexcept {
+            for (; created_ > 0; --created_) {
+                try {
+                    conn_.createStatement()->execute(dialect_.dropInListTableSql(tables_[created_ - 1].name));
+                } catch (...) {
+                    // 连接已失效时临时表随会话一起释放
+                }
+            }
+        }
+
+        IConnection& conn_;
+        const ISqlDialect& dialect_;
+        const std::vector<InListTable>& tables_;
+        size_t created_ = 0;
+    };
+
+    static std::string buildSelectSql(const ISqlDialect& dialect, const Query& query) {
+        std::string sql = "SELECT * FROM " + dialect.quoteIdentifier(TableMeta<T>::name);
         
-        std::string where = query.getWhere();
+        std::string_view where = query.getWhere();
         if (!where.empty()) {
-            sql += " WHERE " + where;
+            sql += " WHERE ";
+            sql += where;
         }
+        
+        sql += query.getOrderBy();
+        sql += query.getLimit();
+        sql += query.getOffset();
+        return sql;
+    }
 
-        try {
-            auto connPtr = ConnectionPool::instance().getConnection();
-            auto pstmt = connPtr->prepareStatement(sql);
-            
-            const auto& params = query.getParams();
-            for (size_t i = 0; i < params.size(); ++i) {
-                bindSqlValue(pstmt.get(), i + 1, params[i]);
+    static std::string buildCountSql(const ISqlDialect& dialect, const Query& query) {
+        std::string sql = "SELECT COUNT(*) AS count_val FROM " + dialect.quoteIdentifier(TableMeta<T>::name);
+        
+        std::string_view where = query.getWhere();
+        if (!where.empty()) {
+            sql += " WHERE ";
+            sql += where;
+        }
+        return sql;
+    }
+
+    // 执行已生成的 SELECT 语句，必要时展开或拆分 IN 列表
+    static EntityList<T> selectSql(const ISqlDialect& dialect, const std::string& sql, const Query& query) {
+        const auto& params = query.getParams();
+        if (!hasInList(params)) {
+            return executeQueryWithParams(sql, params);
+        }
+
+        // 排序和分页依赖完整结果集，此时不能拆分为多条语句，超过上限的列表改为查询临时表
+        bool allowChunk = query.getOrderBy().empty() && query.getLimit().empty() && query.getOffset().empty();
+        auto statements = expandInLists(sql, params, dialect, allowChunk, query.getWhere());
+        if (statements.size() == 1) {
+            return executeQueryWithParams(statements[0].sql, statements[0].params, &statements[0].tables);
+        }
+
+        std::vector<T> results;
+        for (const auto& stmt : statements) {
+            auto part = executeQueryWithParams(stmt.sql, stmt.params);
+            results.insert(results.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+        }
+        return results;
+    }
+
+    static long long countSql(const ISqlDialect& dialect, const std::string& sql, const Query& query) {
+        const auto& params = query.getParams();
+        if (!hasInList(params)) {
+            return executeCount(sql, params);
+        }
+
+        // 分块时各块的值互不相交，计数可以直接累加
+        long long total = 0;
+        for (const auto& stmt : expandInLists(sql, params, dialect, true, query.getWhere())) {
+            total += executeCount(stmt.sql, stmt.params, &stmt.tables);
+        }
+        return total;
+    }
+
+    // 生成流水线语句。参数在 run() 时才绑定，const char* 与 string_view (包括 IN 列表中的) 先复制为 std::string
+    static std::vector<PipelineStatement> pipelineStatements(const ISqlDialect& dialect, const std::string& sql,
+                                                             const Query& query, bool allowChunk) {
+        std::vector<BoundStatement> bound;
+        if (hasInList(query.getParams())) {
+            bound = expandInLists(sql, query.getParams(), dialect, allowChunk, query.getWhere());
+            if (!bound[0].tables.empty()) {
+                throw OrmError("流水线不支持需要临时表的 IN 列表 (超过 " + std::to_string(dialect.maxInListSize()) +
+                               " 个值且不能分批执行)，请改用 Mapper::select / count");
             }
-            
-            auto res = pstmt->executeQuery();
-            if (res->next()) {
-                return res->getInt64("count_val");
+        } else {
+            bound.push_back(BoundStatement{sql, std::vector<SqlValue>(query.getParams().begin(), query.getParams().end()), {}});
+        }
+
+        std::vector<PipelineStatement> statements;
+        statements.reserve(bound.size());
+        for (auto& stmt : bound) {
+            for (auto& param : stmt.params) {
+                if (detail::borrowsMemory(param)) param = detail::ownedSqlValue(param);
             }
-        } catch (const uORM::Exception& e) {
-            throw; 
-        } catch (const std::exception& e) {
-            throw SqlError(std::string("Count查询失败: ") + e.what());
+            auto params = std::make_shared<const std::vector<SqlValue>>(std::move(stmt.params));
+            statements.push_back(PipelineStatement{std::move(stmt.sql), [params](IPreparedStatement* pstmt) {
+                for (size_t i = 0; i < params->size(); ++i) {
+                    bindSqlValue(pstmt, static_cast<int>(i + 1), (*params)[i]);
+                }
+            }});
         }
-        return 0;
+        return statements;
+    }
+
+    // 写入成功后递增表在该连接池上的版本 (使查询缓存失效) 并使实体缓存中的对应主键失效，开启 Redis 缓存层时同步使其失效。
+    // update 不直接写回缓存：executeUpdate 不报告影响行数，写回可能缓存一条并不存在的记录
+    static void invalidateCached(const ConnectionPool& pool, const T& entity) {
+        tableVersion(pool.name()).fetch_add(1, std::memory_order_acq_rel);
+        if constexpr (detail::primaryKeyCount<T>() == 1) {
+            auto& cache = EntityCache<T>::instance();
+            if (cache.enabled()) cache.invalidate(pool.name(), PrimaryKey<T>::get(entity));
+        }
+#ifdef USE_REDIS
+        auto& shared = RedisCache<T>::instance();
+        if (shared.enabled()) shared.onWrite(pool.name(), entity);
+#endif
+    }
+
+    static std::atomic<uint64_t>& tableVersion(const std::string& pool) {
+        return TableVersions::instance().counter(pool, TableMeta<T>::name);
     }
 
-private: 
     static bool hasDefaultConstraint(const char* constraints) {
         std::string s(constraints);
         return s.find("DEFAULT") != std::string::npos;
@@ -328,7 +787,8 @@ private:
         return false;
     }
 
-    static T mapRow(IResultSet* res) {
+    static T mapRow(IResultSet* row) {
+        auto* res = Driver::resultSet(row);
         T entity;
         auto fields = TableMeta<T>::get_fields();
         std::apply([&](auto&&... field) {
@@ -339,20 +799,89 @@ private:
         return entity;
     }
 
+    // JOIN 查询中本表各列的别名：Side 加字段序号 (l0, l1, ...)，只构造一次。
+    // 按位置命名，不受表名与列名长度影响 (PostgreSQL 标识符超过 63 字节会被截断，拼接表名列名的别名可能冲突)
+    template<char Side>
+    static const std::vector<std::string>& columnAliases() {
+        static const std::vector<std::string> aliases = [] {
+            std::vector<std::string> names(std::tuple_size_v<std::decay_t<decltype(TableMeta<T>::get_fields())>>);
+            for (size_t i = 0; i < names.size(); ++i) names[i] = Side + std::to_string(i);
+            return names;
+        }();
+        return aliases;
+    }
+
+    // 追加 "表"."列" AS "l0" 形式的列清单
+    template<char Side>
+    static void appendAliasedColumns(std::string& sql, const ISqlDialect& dialect) {
+        const auto& aliases = columnAliases<Side>();
+        std::string table = dialect.quoteIdentifier(TableMeta<T>::name);
+        size_t i = 0;
+        std::apply([&](auto&&... field) {
+            ((sql += (i == 0 ? "" : ", "), sql += table, sql += '.', sql += dialect.quoteIdentifier(field.column_name),
+              sql += " AS ", sql += dialect.quoteIdentifier(aliases[i]), ++i), ...);
+        }, TableMeta<T>::get_fields());
+    }
+
+    template<char Side>
+    static T mapAliasedRow(IResultSet* row) {
+        auto* res = Driver::resultSet(row);
+        T entity;
+        const auto& aliases = columnAliases<Side>();
+        size_t i = 0;
+        std::apply([&](auto&&... field) {
+            ((
+                entity.*(field.member_ptr) = getValue<typename std::decay_t<decltype(field)>::Type>(res, aliases[i++].c_str())
+            ), ...);
+        }, TableMeta<T>::get_fields());
+        return entity;
+    }
+
+    template<typename... Args>
+    static std::optional<T> findOneIn(ConnectionPool& pool, const std::string& whereClause, Args&&... args) {
+        auto dialect = Driver::dialect(pool);
+        if (!dialect) return std::nullopt;
+
+        std::string sql = "SELECT * FROM " + dialect->quoteIdentifier(TableMeta<T>::name);
+        if (!whereClause.empty()) {
+            sql += " WHERE " + whereClause;
+        }
+        sql += " LIMIT 1";
+
+        auto list = executeQuery(pool, sql, std::forward<Args>(args)...);
+        if (list.empty()) return std::nullopt;
+        return list[0];
+    }
+
+    template<typename... Args>
+    static EntityList<T> findIn(ConnectionPool& pool, const std::string& whereClause, Args&&... args) {
+        auto dialect = Driver::dialect(pool);
+        if (!dialect) return {};
+
+        std::string sql = "SELECT * FROM " + dialect->quoteIdentifier(TableMeta<T>::name);
+        if (!whereClause.empty()) {
+            sql += " WHERE " + whereClause;
+        }
+        return executeQuery(pool, sql, std::forward<Args>(args)...);
+    }
+
     template<typename... Args>
-    static std::vector<T> executeQuery(const std::string& sql, Args&&... args) {
+    static std::vector<T> executeQuery(ConnectionPool& pool, const std::string& sql, Args&&... args) {
         std::vector<T> results;
         try {
-            auto connPtr = ConnectionPool::instance().getConnection();
+            auto connPtr = pool.getConnection();
+            StatementTimer timer(sql, TableMeta<T>::name, &pool);
             auto pstmt = connPtr->prepareStatement(sql);
             
             int index = 1;
-            (bindValue(pstmt.get(), index++, args), ...);
+            ((bindValue(pstmt.get(), index++, args), timer.bound(args)), ...);
             
-            auto res = pstmt->executeQuery();
-            while (res->next()) {
-                results.push_back(mapRow(res.get()));
+            auto res = Driver::statement(pstmt.get())->executeQuery();
+            auto* rs = Driver::resultSet(res.get());
+            while (rs->next()) {
+                results.push_back(mapRow(rs));
             }
+            timer.rows(results.size());
         } catch (const uORM::Exception& e) {
             throw; // Re-throw uORM exceptions
         } catch (const std::exception& e) {
@@ -361,20 +890,29 @@ private:
         return results;
     }
 
-    static std::vector<T> executeQueryWithParams(const std::string& sql, const std::vector<SqlValue>& params) {
+    // tables 非空时先在同一连接上创建语句引用的 IN 列表临时表
+    static std::vector<T> executeQueryWithParams(const std::string& sql, ParamView params,
+                                                 const std::vector<InListTable>* tables = nullptr) {
         std::vector<T> results;
         try {
-            auto connPtr = ConnectionPool::instance().getConnection();
+            auto& pool = ConnectionPool::forRead<T>();
+            auto connPtr = pool.getConnection();
+            std::optional<InListTableScope> inLists;
+            if (tables && !tables->empty()) inLists.emplace(*connPtr, *pool.dialect(), *tables);
+            StatementTimer timer(sql, TableMeta<T>::name, &pool);
+            timer.bound(params);
             auto pstmt = connPtr->prepareStatement(sql);
             
             for (size_t i = 0; i < params.size(); ++i) {
                 bindSqlValue(pstmt.get(), i + 1, params[i]);
             }
             
-            auto res = pstmt->executeQuery();
-            while (res->next()) {
-                results.push_back(mapRow(res.get()));
+            auto res = Driver::statement(pstmt.get())->executeQuery();
+            auto* rs = Driver::resultSet(res.get());
+            while (rs->next()) {
+                results.push_back(mapRow(rs));
             }
+            timer.rows(results.size());
         } catch (const uORM::Exception& e) {
             throw; // Re-throw uORM exceptions
         } catch (const std::exception& e) {
@@ -383,6 +921,215 @@ private:
         return results;
     }
 
+    static long long executeCount(const std::string& sql, ParamView params, const std::vector<InListTable>* tables = nullptr) {
+        try {
+            auto& pool = ConnectionPool::forRead<T>();
+            auto connPtr = pool.getConnection();
+            std::optional<InListTableScope> inLists;
+            if (tables && !tables->empty()) inLists.emplace(*connPtr, *pool.dialect(), *tables);
+            StatementTimer timer(sql, TableMeta<T>::name, &pool);
+            timer.bound(params);
+            auto pstmt = connPtr->prepareStatement(sql);
+            
+            for (size_t i = 0; i < params.size(); ++i) {
+                bindSqlValue(pstmt.get(), i + 1, params[i]);
+            }
+            
+            auto res = Driver::statement(pstmt.get())->executeQuery();
+            auto* rs = Driver::resultSet(res.get());
+            if (rs->next()) {
+                timer.rows(1);
+                return rs->getInt64("count_val");
+            }
+        } catch (const uORM::Exception& e) {
+            throw; 
+        } catch (const std::exception& e) {
+            throw SqlError(std::string("Count查询失败: ") + e.what());
+        }
+        return 0;
+    }
+
+    static bool hasInList(ParamView params) {
+        for (const auto& p : params) {
+            if (std::holds_alternative<ArrayParam>(p)) return true;
+        }
+        return false;
+    }
+
+    // WHERE 子句中第 slot 个 ? 是否为顶层的 AND 项：从该槽位到最外层，所在的每一层括号内都没有 OR。
+    // 只有这样，拆分该 IN 列表后各块的结果才能直接合并；where 中找不到该槽位时返回 false
+    static bool isTopLevelConjunct(std::string_view where, size_t slot) {
+        std::vector<bool> hasOr{false};   // 每个括号分组是否含有 OR，0 为最外层
+        std::vector<size_t> open{0};      // 当前所在的分组链
+        std::vector<size_t> enclosing;    // 槽位所在的分组链
+        size_t index = 0;
+        char quote = 0;
+        for (size_t i = 0; i < where.size(); ++i) {
+            char c = where[i];
+            if (quote) {
+                if (c == quote) quote = 0;
+            } else if (c == '\'' || c == '"' || c == '`') {
+                quote = c;
+            } else if (c == '(') {
+                hasOr.push_back(false);
+                open.push_back(hasOr.size() - 1);
+            } else if (c == ')') {
+                if (open.size() > 1) open.pop_back();
+            } else if (c == '?') {
+                if (index++ == slot) enclosing = open;
+            } else if (where.compare(i, 4, " OR ") == 0) {
+                hasOr[open.back()] = true;
+            }
+        }
+        if (enclosing.empty()) return false;
+        for (size_t group : enclosing) {
+            if (hasOr[group]) return false;
+        }
+        return true;
+    }
+
+    // 按方言展开 WHERE 子句中的 IN 列表槽位。
+    // allowChunk 为 true、恰好有一个超过上限的 IN 列表且该列表是 where 的顶层 AND 项时，按 maxInListSize() 拆成多条语句；
+    // 其余情况 (NOT IN、多个超长列表、列表处在 OR 分组中、带排序分页) 只生成一条语句，超过上限的列表改为查询临时表。
+    static std::vector<BoundStatement> expandInLists(const std::string& sql, ParamView params,
+                                                     const ISqlDialect& dialect, bool allowChunk,
+                                                     std::string_view where = {}) {
+        const SqlArray* chunkTarget = nullptr;
+        if (allowChunk) {
+            int candidates = 0;
+            for (size_t i = 0; i < params.size(); ++i) {
+                if (auto* arr = std::get_if<ArrayParam>(&params[i])) {
+                    if (dialect.inListStrategy((*arr)->values.size()) == InListStrategy::Chunked) {
+                        ++candidates;
+                        if (!(*arr)->negated && isTopLevelConjunct(where, i)) chunkTarget = arr->get();
+                    }
+                }
+            }
+            if (candidates != 1) chunkTarget = nullptr;
+        }
+
+        if (!chunkTarget) {
+            return { renderInLists(sql, params, dialect, nullptr, nullptr) };
+        }
+
+        // 先去重，保证各块互不相交，合并结果时不会出现重复行
+        std::vector<SqlValue> distinct = distinctValues(chunkTarget->values);
+
+        std::vector<BoundStatement> statements;
+        size_t chunk = dialect.maxInListSize();
+        for (size_t begin = 0; begin < distinct.size(); begin += chunk) {
+            size_t end = std::min(begin + chunk, distinct.size());
+            std::vector<SqlValue> slice(distinct.begin() + begin, distinct.begin() + end);
+            statements.push_back(renderInLists(sql, params, dialect, chunkTarget, &slice));
+        }
+        return statements;
+    }
+
+    // 逐个替换 ? 槽位：普通参数原样保留，IN 列表按方言策略生成谓词与参数。
+    // target 非空时，该列表使用 slice 中的值 (分块执行)；其他超过上限的列表写入临时表 uorm_in_N
+    static BoundStatement renderInLists(const std::string& sql, ParamView params, const ISqlDialect& dialect,
+                                        const SqlArray* target, const std::vector<SqlValue>* slice) {
+        BoundStatement out;
+        out.sql.reserve(sql.size() + 64);
+        out.params.reserve(params.size());
+
+        size_t index = 0;
+        char quote = 0;
+        for (char c : sql) {
+            if (quote) {
+                out.sql += c;
+                if (c == quote) quote = 0;
+                continue;
+            }
+            if (c == '\'' || c == '"' || c == '`') {
+                quote = c;
+                out.sql += c;
+                continue;
+            }
+            if (c != '?') {
+                out.sql += c;
+                continue;
+            }
+            if (index >= params.size()) {
+                throw OrmError("占位符数量与参数数量不匹配");
+            }
+
+            const SqlValue& param = params[index++];
+            auto* arr = std::get_if<ArrayParam>(&param);
+            if (!arr) {
+                out.sql += '?';
+                out.params.push_back(param);
+                continue;
+            }
+
+            const SqlArray& list = **arr;
+            const auto& values = (&list == target) ? *slice : list.values;
+            const InListStrategy strategy = (&list == target) ? InListStrategy::Expand : dialect.inListStrategy(values.size());
+            if (strategy == InListStrategy::ArrayParam) {
+                out.sql += dialect.arrayInPredicate(list.column, list.negated);
+                out.params.push_back(dialect.formatArrayParam(values));
+                continue;
+            }
+            if (strategy == InListStrategy::Chunked) {
+                InListTable table;
+                table.name = dialect.quoteIdentifier("uorm_in_" + std::to_string(out.tables.size() + 1));
+                table.values = distinctValues(values);
+                table.createSql = dialect.createInListTableSql(table.name, table.values.front());
+                if (table.createSql.empty()) {
+                    throw OrmError("IN 列表超过 " + std::to_string(dialect.maxInListSize()) + " 个值且不能分批执行，当前方言不支持临时表");
+                }
+                out.sql += list.column;
+                out.sql += list.negated ? " NOT IN (SELECT v FROM " : " IN (SELECT v FROM ";
+                out.sql += table.name;
+                out.sql += ')';
+                out.tables.push_back(std::move(table));
+                continue;
+            }
+
+            // 占位符数量补齐到桶大小，用最后一个值填充，IN / NOT IN 的语义不变
+            size_t padded = paddedInListSize(values.size(), dialect.maxInListSize());
+            out.sql += list.column;
+            out.sql += list.negated ? " NOT IN (" : " IN (";
+            for (size_t i = 0; i < padded; ++i) {
+                out.sql += (i == 0 ? "?" : ", ?");
+                out.params.push_back(values[std::min(i, values.size() - 1)]);
+            }
+            out.sql += ")";
+        }
+        return out;
+    }
+
+    // 展开后的占位符数量：取不小于 count 的 2 的幂 (最少 8 个，不超过 maxSize)，
+    // 使不同长度的列表共享少量语句形状
+    static size_t paddedInListSize(size_t count, size_t maxSize) {
+        if (count >= maxSize) return count;
+        size_t size = 8;
+        while (size < count) size *= 2;
+        return std::min(size, maxSize);
+    }
+
+    // 排序并去重后的列表值
+    static std::vector<SqlValue> distinctValues(const std::vector<SqlValue>& values) {
+        std::vector<SqlValue> distinct = values;
+        std::sort(distinct.begin(), distinct.end(), sqlValueLess);
+        distinct.erase(std::unique(distinct.begin(), distinct.end(),
+                                   [](const SqlValue& a, const SqlValue& b) { return !sqlValueLess(a, b) && !sqlValueLess(b, a); }),
+                       distinct.end());
+        return distinct;
+    }
+
+    static bool sqlValueLess(const SqlValue& a, const SqlValue& b) {
+        if (a.index() != b.index()) return a.index() < b.index();
+        return std::visit([&](auto&& lhs) {
+            using V = std::decay_t<decltype(lhs)>;
+            const auto& rhs = std::get<V>(b);
+            if constexpr (std::is_same_v<V, std::nullptr_t> || std::is_same_v<V, SqlPlaceholder>) return false;
+            else if constexpr (std::is_same_v<V, const char*>) return std::strcmp(lhs ? lhs : "", rhs ? rhs : "") < 0;
+            else if constexpr (std::is_same_v<V, ArrayParam>) return std::less<const SqlArray*>()(lhs.get(), rhs.get());
+            else return lhs < rhs;
+        }, a);
+    }
+
     // 检查约束中是否包含 AUTO_INCREMENT
     static bool isAutoIncrement(const char* constraints) { 
         std::string s(constraints); 
@@ -395,17 +1142,18 @@ private:
         return s.find("PRIMARY KEY") != std::string::npos;
     }
 
-    // 辅助函数：将 C++ 值绑定到 PreparedStatement
-    static void bindValue(IPreparedStatement* pstmt, int index, const int& val) { pstmt->setInt(index, val); } 
-    static void bindValue(IPreparedStatement* pstmt, int index, const long& val) { pstmt->setInt64(index, val); } 
-    static void bindValue(IPreparedStatement* pstmt, int index, const long long& val) { pstmt->setInt64(index, val); } 
-    static void bindValue(IPreparedStatement* pstmt, int index, const unsigned int& val) { pstmt->setUInt(index, val); } 
-    static void bindValue(IPreparedStatement* pstmt, int index, const unsigned long& val) { pstmt->setInt64(index, static_cast<long long>(val)); }
-    static void bindValue(IPreparedStatement* pstmt, int index, const unsigned long long& val) { pstmt->setInt64(index, static_cast<long long>(val)); } // MySQL Connector C++ doesn't have setUInt64 in older versions or wrapper needs it
-    static void bindValue(IPreparedStatement* pstmt, int index, const std::string& val) { pstmt->setString(index, val); } 
-    static void bindValue(IPreparedStatement* pstmt, int index, const char* val) { pstmt->setString(index, val); } 
-    static void bindValue(IPreparedStatement* pstmt, int index, const bool& val) { pstmt->setBoolean(index, val); } 
-    static void bindValue(IPreparedStatement* pstmt, int index, const double& val) { pstmt->setDouble(index, val); } 
+    // 辅助函数：将 C++ 值绑定到 PreparedStatement (经 Driver::statement 转换为策略的语句类型)
+    static void bindValue(IPreparedStatement* pstmt, int index, const int& val) { Driver::statement(pstmt)->setInt(index, val); } 
+    static void bindValue(IPreparedStatement* pstmt, int index, const long& val) { Driver::statement(pstmt)->setInt64(index, val); } 
+    static void bindValue(IPreparedStatement* pstmt, int index, const long long& val) { Driver::statement(pstmt)->setInt64(index, val); } 
+    static void bindValue(IPreparedStatement* pstmt, int index, const unsigned int& val) { Driver::statement(pstmt)->setUInt(index, val); } 
+    static void bindValue(IPreparedStatement* pstmt, int index, const unsigned long& val) { Driver::statement(pstmt)->setInt64(index, static_cast<long long>(val)); }
+    static void bindValue(IPreparedStatement* pstmt, int index, const unsigned long long& val) { Driver::statement(pstmt)->setInt64(index, static_cast<long long>(val)); } // MySQL Connector C++ doesn't have setUInt64 in older versions or wrapper needs it
+    static void bindValue(IPreparedStatement* pstmt, int index, const std::string& val) { Driver::statement(pstmt)->setString(index, val); } 
+    static void bindValue(IPreparedStatement* pstmt, int index, const char* val) { Driver::statement(pstmt)->setString(index, val); } 
+    static void bindValue(IPreparedStatement* pstmt, int index, std::string_view val) { Driver::statement(pstmt)->setString(index, std::string(val)); } 
+    static void bindValue(IPreparedStatement* pstmt, int index, const bool& val) { Driver::statement(pstmt)->setBoolean(index, val); } 
+    static void bindValue(IPreparedStatement* pstmt, int index, const double& val) { Driver::statement(pstmt)->setDouble(index, val); } 
     // 如有需要可添加更多重载 
 
     static void bindSqlValue(IPreparedStatement* pstmt, int index, const SqlValue& val) {
@@ -413,6 +1161,10 @@ private:
             using ArgType = std::decay_t<decltype(arg)>;
             if constexpr (std::is_same_v<ArgType, std::nullptr_t>) {
                 // Not supported
+            } else if constexpr (std::is_same_v<ArgType, ArrayParam>) {
+                throw OrmError("IN 列表参数必须先经过方言展开");
+            } else if constexpr (std::is_same_v<ArgType, SqlPlaceholder>) {
+                throw OrmError("占位符只能通过 CompiledQuery::execute 绑定");
             } else {
                 bindValue(pstmt, index, arg);
             }
@@ -421,7 +1173,7 @@ private:
 
     // 辅助函数：从 ResultSet 获取值并转换为 C++ 类型
     template<typename V> 
-    static V getValue(IResultSet* res, const char* colName) { 
+    static V getValue(typename Driver::ResultSet* res, const char* colName) { 
         if constexpr (std::is_same_v<V, int>) return res->getInt(colName); 
         else if constexpr (std::is_same_v<V, long>) return res->getInt64(colName); 
         else if constexpr (std::is_same_v<V, long long>) return res->getInt64(colName); 
@@ -434,4 +1186,7 @@ private:
     } 
 }; 
 
-} // namespace uORM 
+} // namespace uORM
+
+// CompiledQuery 依赖 Mapper 的内部实现，放在 Mapper 定义之后引入
+#include "uORM/orm/CompiledQuery.h"
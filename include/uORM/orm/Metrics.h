@@ -0,0 +1,518 @@
+#pragma once
+// 文件说明：
+// Metrics 记录 uORM 的执行耗时与计数：
+//   - 按语句指纹 (SQL 文本的 FNV-1a 哈希，参数以 ? 出现，同一形状的语句共用一个指纹)
+//     统计调用次数、失败次数、返回行数、绑定参数字节数与耗时分布 (p50/p99)
+//   - 连接池的取连接等待时间与新建连接耗时
+//
+// 计数器按线程分片，记录时只对本线程所在分片做 relaxed 原子加法，不加锁；
+// 指纹到统计项的查找在线程本地缓存中完成。读取时 snapshot() 合并所有分片。
+//
+//   uORM::Metrics::instance().setEnabled(true);   // 或在 DataBaseConfig 中设置 "metrics": true
+//   auto snap = uORM::Metrics::instance().snapshot();
+//   uORM::PrometheusExporter::writeFile("/var/lib/node_exporter/uorm.prom");
+
+#include "uORM/driver/ConfigManager.h"
+#include "uORM/orm/Error.h"
+#include "uORM/orm/SqlValue.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace uORM {
+
+// 一组统计数据在某一时刻的合并结果，耗时单位为微秒
+struct StatsSnapshot {
+    uint64_t calls = 0;
+    uint64_t errors = 0;
+    uint64_t rows = 0;
+    uint64_t bytesBound = 0;
+    uint64_t totalMicros = 0;
+    uint64_t maxMicros = 0;
+    double p50Micros = 0;
+    double p99Micros = 0;
+};
+
+struct StatementSnapshot {
+    uint64_t fingerprint = 0;
+    std::string sql;
+    std::string table;    // 首次执行该语句的实体表名，Mapper 以外的语句为空
+    StatsSnapshot stats;
+};
+
+struct MetricsSnapshot {
+    std::vector<StatementSnapshot> statements;
+    StatsSnapshot poolWait;      // getConnection 从调用到返回的耗时，errors 为取连接失败次数
+    StatsSnapshot poolConnect;   // 新建数据库连接的耗时，errors 为建连失败次数
+};
+
+namespace detail {
+
+// 语句指纹：FNV-1a 64 位，不依赖标准库实现，便于跨进程、跨版本对比
+inline uint64_t fingerprint(std::string_view sql) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : sql) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline std::string fingerprintHex(uint64_t fp) {
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(fp));
+    return buf;
+}
+
+// 绑定参数的字节数：字符串按长度，其余按值的大小
+template<typename V>
+uint64_t boundBytes(const V& value) {
+    if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::string_view>) {
+        return value.size();
+    } else if constexpr (std::is_same_v<V, const char*> || std::is_same_v<V, char*>) {
+        return value ? std::strlen(value) : 0;
+    } else if constexpr (std::is_same_v<V, SqlValue>) {
+        return std::visit([](const auto& arg) -> uint64_t {
+            using A = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<A, std::nullptr_t> || std::is_same_v<A, SqlPlaceholder>) {
+                return 0;
+            } else if constexpr (std::is_same_v<A, std::shared_ptr<const SqlArray>>) {
+                uint64_t total = 0;
+                if (arg) {
+                    for (const auto& v : arg->values) total += boundBytes(v);
+                }
+                return total;
+            } else {
+                return boundBytes(arg);
+            }
+        }, value);
+    } else if constexpr (std::is_arithmetic_v<V>) {
+        return sizeof(V);
+    } else {
+        return 0;
+    }
+}
+
+// 分片的统计项。耗时直方图按 2 的幂分段，每段再均分为 4 个子桶，相对误差不超过 12.5%
+class ShardedStats {
+public:
+    static constexpr size_t kShards = 8;
+    static constexpr size_t kBuckets = 128;
+
+    void record(uint64_t micros, bool failed, uint64_t rows, uint64_t bytes) {
+        Shard& s = shards_[shardIndex()];
+        s.calls.fetch_add(1, std::memory_order_relaxed);
+        if (failed) s.errors.fetch_add(1, std::memory_order_relaxed);
+        if (rows) s.rows.fetch_add(rows, std::memory_order_relaxed);
+        if (bytes) s.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        s.totalMicros.fetch_add(micros, std::memory_order_relaxed);
+        uint64_t prev = s.maxMicros.load(std::memory_order_relaxed);
+        while (micros > prev && !s.maxMicros.compare_exchange_weak(prev, micros, std::memory_order_relaxed)) {
+        }
+        s.buckets[bucketOf(micros)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    StatsSnapshot snapshot() const {
+        StatsSnapshot out;
+        std::array<uint64_t, kBuckets> merged{};
+        for (const auto& s : shards_) {
+            out.calls += s.calls.load(std::memory_order_relaxed);
+            out.errors += s.errors.load(std::memory_order_relaxed);
+            out.rows += s.rows.load(std::memory_order_relaxed);
+            out.bytesBound += s.bytes.load(std::memory_order_relaxed);
+            out.totalMicros += s.totalMicros.load(std::memory_order_relaxed);
+            out.maxMicros = std::max(out.maxMicros, s.maxMicros.load(std::memory_order_relaxed));
+            for (size_t i = 0; i < kBuckets; ++i) merged[i] += s.buckets[i].load(std::memory_order_relaxed);
+        }
+        out.p50Micros = percentile(merged, 0.50, out.maxMicros);
+        out.p99Micros = percentile(merged, 0.99, out.maxMicros);
+        return out;
+    }
+
+    void reset() {
+        for (auto& s : shards_) {
+            s.calls.store(0, std::memory_order_relaxed);
+            s.errors.store(0, std::memory_order_relaxed);
+            s.rows.store(0, std::memory_order_relaxed);
+            s.bytes.store(0, std::memory_order_relaxed);
+            s.totalMicros.store(0, std::memory_order_relaxed);
+            s.maxMicros.store(0, std::memory_order_relaxed);
+            for (auto& b : s.buckets) b.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // 0..7 各占一个桶，之后每个 [2^e, 2^(e+1)) 区间分为 4 个桶
+    static size_t bucketOf(uint64_t v) {
+        if (v < 8) return static_cast<size_t>(v);
+        unsigned e = 63u - static_cast<unsigned>(__builtin_clzll(v));
+        size_t index = 4 * (e - 1) + ((v >> (e - 2)) & 3);
+        return index < kBuckets ? index : kBuckets - 1;
+    }
+
+    static uint64_t bucketLower(size_t index) {
+        if (index < 8) return index;
+        unsigned e = static_cast<unsigned>(index / 4 + 1);
+        return (4ULL + index % 4) << (e - 2);
+    }
+
+    static uint64_t bucketWidth(size_t index) {
+        if (index < 8) return 1;
+        return 1ULL << (index / 4 - 1);
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> errors{0};
+        std::atomic<uint64_t> rows{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> totalMicros{0};
+        std::atomic<uint64_t> maxMicros{0};
+        std::atomic<uint64_t> buckets[kBuckets] = {};
+    };
+
+    // 线程按创建顺序轮流分配分片 (线程 id 的哈希常按页对齐，取模后会集中在同一分片)
+    static size_t shardIndex() {
+        static std::atomic<size_t> next{0};
+        thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return index;
+    }
+
+    // 在目标桶内按线性插值估算分位数，不超过观测到的最大值
+    static double percentile(const std::array<uint64_t, kBuckets>& buckets, double q, uint64_t maxMicros) {
+        uint64_t total = 0;
+        for (uint64_t b : buckets) total += b;
+        if (total == 0) return 0;
+        double rank = q * static_cast<double>(total);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            if (buckets[i] == 0) continue;
+            if (static_cast<double>(seen + buckets[i]) >= rank) {
+                double within = (rank - static_cast<double>(seen)) / static_cast<double>(buckets[i]);
+                double value = static_cast<double>(bucketLower(i)) + within * static_cast<double>(bucketWidth(i));
+                return std::min(value, static_cast<double>(maxMicros));
+            }
+            seen += buckets[i];
+        }
+        return static_cast<double>(maxMicros);
+    }
+
+    Shard shards_[kShards];
+};
+
+} // namespace detail
+
+class Metrics {
+public:
+    static Metrics& instance() {
+        static Metrics inst;
+        return inst;
+    }
+
+    bool enabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool on) {
+        enabled_.store(on, std::memory_order_relaxed);
+    }
+
+    // 取得语句的统计项，首次出现的指纹会注册。统计项在进程内不会释放，reset() 只清零计数
+    detail::ShardedStats* statement(std::string_view sql, const char* table = nullptr) {
+        return statement(detail::fingerprint(sql), sql, table);
+    }
+
+    // 指纹已预先计算 (如 CompiledQuery) 时跳过哈希
+    detail::ShardedStats* statement(uint64_t fp, std::string_view sql, const char* table = nullptr) {
+        thread_local std::unordered_map<uint64_t, detail::ShardedStats*> cache;
+        auto cached = cache.find(fp);
+        if (cached != cache.end()) return cached->second;
+
+        detail::ShardedStats* stats = nullptr;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = statements_.find(fp);
+            if (it != statements_.end()) stats = &it->second->stats;
+        }
+        if (!stats) {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            auto& entry = statements_[fp];
+            if (!entry) {
+                entry = std::make_unique<Entry>();
+                entry->sql.assign(sql);
+                if (table) entry->table = table;
+            }
+            stats = &entry->stats;
+        }
+        cache.emplace(fp, stats);
+        return stats;
+    }
+
+    detail::ShardedStats& poolWait() {
+        return poolWait_;
+    }
+
+    detail::ShardedStats& poolConnect() {
+        return poolConnect_;
+    }
+
+    MetricsSnapshot snapshot() const {
+        MetricsSnapshot out;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            out.statements.reserve(statements_.size());
+            for (const auto& [fp, entry] : statements_) {
+                StatementSnapshot s;
+                s.fingerprint = fp;
+                s.sql = entry->sql;
+                s.table = entry->table;
+                s.stats = entry->stats.snapshot();
+                out.statements.push_back(std::move(s));
+            }
+        }
+        out.poolWait = poolWait_.snapshot();
+        out.poolConnect = poolConnect_.snapshot();
+        return out;
+    }
+
+    // 清零所有计数，已注册的指纹保留
+    void reset() {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            for (auto& [fp, entry] : statements_) entry->stats.reset();
+        }
+        poolWait_.reset();
+        poolConnect_.reset();
+    }
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+private:
+    Metrics() : enabled_(ConfigManager::getInstance().databaseconfigdata_.metrics) {}
+
+    struct Entry {
+        std::string sql;
+        std::string table;
+        detail::ShardedStats stats;
+    };
+
+    std::atomic<bool> enabled_;
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<uint64_t, std::unique_ptr<Entry>> statements_;
+    detail::ShardedStats poolWait_;
+    detail::ShardedStats poolConnect_;
+};
+
+// 计时器：构造时开始计时，析构时写入统计项。
+// 析构时若有新的异常正在传播则记为失败；stats 为空 (未开启统计) 时所有操作为空操作
+class MetricsTimer {
+public:
+    explicit MetricsTimer(detail::ShardedStats* stats)
+        : stats_(stats), exceptions_(std::uncaught_exceptions()) {
+        if (stats_) start_ = std::chrono::steady_clock::now();
+    }
+
+    ~MetricsTimer() {
+        if (!stats_) return;
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count();
+        bool failed = failed_ || std::uncaught_exceptions() > exceptions_;
+        stats_->record(static_cast<uint64_t>(micros), failed, rows_, bytes_);
+    }
+
+    void rows(uint64_t n) {
+        rows_ += n;
+    }
+
+    template<typename V>
+    void bound(const V& value) {
+        if (stats_) bytes_ += detail::boundBytes(value);
+    }
+
+    void bound(ParamView params) {
+        if (!stats_) return;
+        for (const auto& p : params) bytes_ += detail::boundBytes(p);
+    }
+
+    void fail() {
+        failed_ = true;
+    }
+
+    MetricsTimer(const MetricsTimer&) = delete;
+    MetricsTimer& operator=(const MetricsTimer&) = delete;
+
+private:
+    detail::ShardedStats* stats_;
+    int exceptions_;
+    bool failed_ = false;
+    uint64_t rows_ = 0;
+    uint64_t bytes_ = 0;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// 取得语句的统计项，未开启统计时返回空指针且不计算指纹
+inline detail::ShardedStats* statementStats(std::string_view sql, const char* table = nullptr) {
+    auto& metrics = Metrics::instance();
+    return metrics.enabled() ? metrics.statement(sql, table) : nullptr;
+}
+
+inline detail::ShardedStats* statementStats(uint64_t fp, std::string_view sql, const char* table = nullptr) {
+    auto& metrics = Metrics::instance();
+    return metrics.enabled() ? metrics.statement(fp, sql, table) : nullptr;
+}
+
+// 以 Prometheus 文本格式导出统计数据
+class PrometheusExporter {
+public:
+    using Sink = std::function<void(const std::string&)>;
+
+    static std::string render(const MetricsSnapshot& snap) {
+        std::ostringstream out;
+
+        out << "# HELP uorm_statement_info SQL text of each statement fingerprint.\n"
+            << "# TYPE uorm_statement_info gauge\n";
+        for (const auto& s : snap.statements) {
+            out << "uorm_statement_info{fingerprint=\"" << detail::fingerprintHex(s.fingerprint)
+                << "\",table=\"" << escape(s.table) << "\",sql=\"" << escape(s.sql) << "\"} 1\n";
+        }
+
+        counter(out, snap, "uorm_statement_calls_total", "Statements executed.", &StatsSnapshot::calls);
+        counter(out, snap, "uorm_statement_errors_total", "Statements that failed.", &StatsSnapshot::errors);
+        counter(out, snap, "uorm_statement_rows_total", "Rows returned by statements.", &StatsSnapshot::rows);
+        counter(out, snap, "uorm_statement_bound_bytes_total", "Bytes of parameters bound to statements.", &StatsSnapshot::bytesBound);
+
+        out << "# HELP uorm_statement_duration_seconds Statement execution time, including reading the results.\n"
+            << "# TYPE uorm_statement_duration_seconds summary\n";
+        for (const auto& s : snap.statements) {
+            summary(out, "uorm_statement_duration_seconds", "fingerprint=\"" + detail::fingerprintHex(s.fingerprint) + "\"", s.stats);
+        }
+
+        out << "# HELP uorm_pool_wait_seconds Time spent in ConnectionPool::getConnection.\n"
+            << "# TYPE uorm_pool_wait_seconds summary\n";
+        summary(out, "uorm_pool_wait_seconds", "", snap.poolWait);
+        out << "# HELP uorm_pool_acquire_errors_total Failed ConnectionPool::getConnection calls.\n"
+            << "# TYPE uorm_pool_acquire_errors_total counter\n"
+            << "uorm_pool_acquire_errors_total " << snap.poolWait.errors << "\n";
+
+        out << "# HELP uorm_pool_connect_seconds Time spent opening new database connections.\n"
+            << "# TYPE uorm_pool_connect_seconds summary\n";
+        summary(out, "uorm_pool_connect_seconds", "", snap.poolConnect);
+        out << "# HELP uorm_pool_connect_errors_total Database connections that could not be opened.\n"
+            << "# TYPE uorm_pool_connect_errors_total counter\n"
+            << "uorm_pool_connect_errors_total " << snap.poolConnect.errors << "\n";
+        return out.str();
+    }
+
+    static std::string render() {
+        return render(Metrics::instance().snapshot());
+    }
+
+    // 先写入临时文件再重命名，读取方不会看到写了一半的内容 (node_exporter textfile collector 的约定)
+    static void writeFile(const std::string& path) {
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream file(tmp, std::ios::trunc);
+            if (!file) throw OrmError("无法写入指标文件: " + tmp);
+            file << render();
+            if (!file) throw OrmError("写入指标文件失败: " + tmp);
+        }
+        if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+            std::remove(tmp.c_str());
+            throw OrmError("无法替换指标文件: " + path);
+        }
+    }
+
+    static Sink fileSink(std::string path) {
+        return [path = std::move(path)](const std::string&) { writeFile(path); };
+    }
+
+    PrometheusExporter() = default;
+    ~PrometheusExporter() {
+        stop();
+    }
+
+    // 后台线程每隔 interval 渲染一次并交给 sink；sink 抛出的异常被忽略，下个周期重试
+    void start(std::chrono::milliseconds interval, Sink sink) {
+        stop();
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = false;
+        worker_ = std::thread([this, interval, sink = std::move(sink)] {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!cond_.wait_for(lock, interval, [this] { return stopping_; })) {
+                lock.unlock();
+                try {
+                    sink(render());
+                } catch (...) {
+                }
+                lock.lock();
+            }
+        });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cond_.notify_all();
+        if (worker_.joinable() && worker_.get_id() != std::this_thread::get_id()) worker_.join();
+    }
+
+    PrometheusExporter(const PrometheusExporter&) = delete;
+    PrometheusExporter& operator=(const PrometheusExporter&) = delete;
+
+private:
+    static std::string escape(std::string_view value) {
+        std::string out;
+        out.reserve(value.size());
+        for (char c : value) {
+            if (c == '\\') out += "\\\\";
+            else if (c == '"') out += "\\\"";
+            else if (c == '\n') out += "\\n";
+            else out += c;
+        }
+        return out;
+    }
+
+    static void counter(std::ostringstream& out, const MetricsSnapshot& snap, const char* name, const char* help,
+                        uint64_t StatsSnapshot::*field) {
+        out << "# HELP " << name << " " << help << "\n# TYPE " << name << " counter\n";
+        for (const auto& s : snap.statements) {
+            out << name << "{fingerprint=\"" << detail::fingerprintHex(s.fingerprint) << "\"} " << s.stats.*field << "\n";
+        }
+    }
+
+    static void summary(std::ostringstream& out, const char* name, const std::string& labels, const StatsSnapshot& s) {
+        std::string sep = labels.empty() ? "" : ",";
+        std::string braces = labels.empty() ? "" : "{" + labels + "}";
+        out << name << "{" << labels << sep << "quantile=\"0.5\"} " << s.p50Micros / 1e6 << "\n"
+            << name << "{" << labels << sep << "quantile=\"0.99\"} " << s.p99Micros / 1e6 << "\n"
+            << name << "_sum" << braces << " " << static_cast<double>(s.totalMicros) / 1e6 << "\n"
+            << name << "_count" << braces << " " << s.calls << "\n";
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread worker_;
+    bool stopping_ = true;
+};
+
+} // namespace uORM
@@ -6,3 +6,4 @@
 #include "uORM/orm/Schema.h" 
 #include "uORM/orm/Mapper.h" 
 #include "uORM/orm/Error.h"
+#include "uORM/orm/CacheInvalidation.h"
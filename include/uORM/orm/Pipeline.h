@@ -0,0 +1,187 @@
+#pragma once
+// 文件说明：
+// Pipeline 在一条连接上批量执行互不依赖的查询：先发送全部语句，再依次读取结果，
+// 多条语句只花费约一次网络往返。
+//
+//   uORM::Pipeline p;
+//   auto products = p.add(Mapper<Product>::selectOp(Query().eq(&Product::category, "Home")));
+//   auto total = p.add(Mapper<Order>::countOp());
+//   p.run();
+//   products.get(); total.get();
+//
+// 具体的发送方式由驱动的 IConnection::executePipeline 决定：PostgreSQL 使用 libpq 流水线模式或 pqxx::pipeline，
+// MySQL 在开启 multi_statements 时把参数转义后内联、一次发送多条语句 (NO_BACKSLASH_ESCAPES 下不内联)，其余情况逐条执行。
+// 流水线中的查询不经过 QueryCache。一个流水线只在一个连接池上执行，加入不同连接池的操作抛出 OrmError；
+// 全部为只读操作时在该池选出的只读副本上执行。
+// 开启 Metrics 时整个流水线按一条语句记录，SQL 为各语句以 "; " 连接的文本，耗时为整批的往返时间；
+// 追踪钩子中整批执行对应一个 Transaction span。
+
+#include "uORM/driver/ConnectionPool.h"
+#include "uORM/driver/DBInterfaces.h"
+#include "uORM/orm/Error.h"
+#include "uORM/orm/Metrics.h"
+#include "uORM/orm/Tracing.h"
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace uORM {
+
+// 流水线中的一条语句：SQL 使用 ? 占位符，bind 负责绑定参数
+struct PipelineStatement {
+    std::string sql;
+    std::function<void(IPreparedStatement*)> bind;
+};
+
+// 一个流水线操作，由 Mapper<T>::selectOp / countOp 等创建。
+// 一个操作可能对应多条语句 (IN 列表拆分)，accumulate 依次接收各条语句的结果集
+template<typename R>
+struct PipelineOp {
+    std::vector<PipelineStatement> statements;
+    std::function<void(IResultSet*, R&)> accumulate;
+    ConnectionPool* pool = nullptr;   // 为空时使用默认连接池
+    bool readOnly = false;            // 只读操作；整批都是只读操作时流水线在只读副本上执行
+};
+
+class Pipeline {
+public:
+    // 加入一个操作，run() 之后 future 中保存结果或异常
+    template<typename R>
+    std::future<R> add(PipelineOp<R> op) {
+        ConnectionPool* pool = op.pool ? op.pool : &ConnectionPool::instance();
+        if (!pool_) {
+            pool_ = pool;
+        } else if (pool_ != pool) {
+            throw OrmError("流水线中的操作必须使用同一个连接池: '" + pool_->name() + "' 与 '" + pool->name() + "'");
+        }
+        readOnly_ = (entries_.empty() || readOnly_) && op.readOnly;
+        auto promise = std::make_shared<std::promise<R>>();
+        std::future<R> future = promise->get_future();
+        Entry entry;
+        entry.statements = std::move(op.statements);
+        entry.complete = [promise, accumulate = std::move(op.accumulate)](std::unique_ptr<IResultSet>* results, size_t count) {
+            R value{};
+            for (size_t i = 0; i < count; ++i) {
+                // 驱动对没有结果集的语句返回空指针
+                if (results[i]) accumulate(results[i].get(), value);
+            }
+            promise->set_value(std::move(value));
+        };
+        entry.fail = [promise](std::exception_ptr error) { promise->set_exception(error); };
+        entries_.push_back(std::move(entry));
+        return future;
+    }
+
+    size_t size() const {
+        return entries_.size();
+    }
+
+    // 取一条连接执行全部操作。某条语句失败时，其后的操作都以该错误结束，run() 抛出第一个错误；
+    // 此前已完成的操作结果仍然有效。执行后流水线清空，可以继续 add 复用
+    void run() {
+        std::vector<Entry> entries;
+        entries.swap(entries_);
+        ConnectionPool* pool = pool_;
+        bool readOnly = readOnly_;
+        pool_ = nullptr;
+        readOnly_ = false;
+        if (entries.empty()) return;
+
+        std::exception_ptr firstError;
+        size_t completed = 0;
+        try {
+            auto conn = (readOnly ? pool->readPool() : *pool).getConnection();
+            std::optional<MetricsTimer> timer;
+            if (Metrics::instance().enabled()) {
+                std::string sql;
+                for (auto& entry : entries) {
+                    for (auto& stmt : entry.statements) {
+                        if (!sql.empty()) sql += "; ";
+                        sql += stmt.sql;
+                    }
+                }
+                timer.emplace(Metrics::instance().statement(sql));
+            }
+            std::vector<std::unique_ptr<IPreparedStatement>> prepared;
+            std::vector<IPreparedStatement*> statements;
+            for (auto& entry : entries) {
+                for (auto& stmt : entry.statements) {
+                    prepared.push_back(conn->preparePipelineStatement(stmt.sql));
+                    if (stmt.bind) stmt.bind(prepared.back().get());
+                    statements.push_back(prepared.back().get());
+                }
+            }
+
+            std::vector<std::unique_ptr<IResultSet>> results;
+            results.reserve(statements.size());
+            {
+                TraceSpan span(SpanKind::Transaction, "pipeline");
+                try {
+                    conn->executePipeline(statements, results);
+                } catch (...) {
+                    firstError = translate(std::current_exception());
+                    if (timer) timer->fail();
+                    span.fail();
+                }
+            }
+
+            // 结果集可能依赖语句与连接，在归还连接前映射
+            size_t offset = 0;
+            for (auto& entry : entries) {
+                size_t count = entry.statements.size();
+                if (offset + count > results.size()) break;
+                try {
+                    entry.complete(results.data() + offset, count);
+                } catch (...) {
+                    auto error = translate(std::current_exception());
+                    entry.fail(error);
+                    if (!firstError) firstError = error;
+                }
+                offset += count;
+                ++completed;
+            }
+            results.clear();
+            prepared.clear();
+        } catch (...) {
+            if (!firstError) firstError = translate(std::current_exception());
+        }
+
+        if (!firstError && completed < entries.size()) {
+            firstError = std::make_exception_ptr(SqlError("流水线返回的结果数量少于语句数量"));
+        }
+        for (size_t i = completed; i < entries.size(); ++i) {
+            entries[i].fail(firstError);
+        }
+        if (firstError) std::rethrow_exception(firstError);
+    }
+
+private:
+    struct Entry {
+        std::vector<PipelineStatement> statements;
+        std::function<void(std::unique_ptr<IResultSet>*, size_t)> complete;
+        std::function<void(std::exception_ptr)> fail;
+    };
+
+    // 驱动抛出的非 uORM 异常统一包装为 SqlError，与 Mapper 一致
+    static std::exception_ptr translate(std::exception_ptr error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const Exception&) {
+            return error;
+        } catch (const std::exception& e) {
+            return std::make_exception_ptr(SqlError(std::string("流水线执行失败: ") + e.what()));
+        } catch (...) {
+            return error;
+        }
+    }
+
+    std::vector<Entry> entries_;
+    ConnectionPool* pool_ = nullptr;   // 第一个操作确定的连接池
+    bool readOnly_ = false;
+};
+
+} // namespace uORM
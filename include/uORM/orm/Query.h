@@ -2,10 +2,20 @@
 #include <string>
 #include <vector>
 #include <sstream>
+#include <string_view>
+#include <charconv>
+#include <type_traits>
 #include "SqlValue.h"
+#include "Column.h"
+#include "Error.h"
+#include "SmallBuffer.h"
 
 namespace uORM {
 
+// 查询构造器。
+// WHERE 子句、排序分页片段和参数都使用对象内的内联缓冲区，
+// 常见规模的查询 (8 个条件以内) 构造过程不产生堆分配；超出容量时自动转移到堆上。
+// 以 const char* / std::string_view 传入的字符串值不会被复制，调用方需保证其在执行前有效。
 class Query {
 public:
     // 逻辑连接符设置
@@ -19,164 +29,402 @@ public:
         return *this;
     }
 
+    // 条件分组：组内条件整体加括号，与前一个条件之间使用当前连接符。
+    // q.eq("is_active", true).group([](Query& g) { g.eq("category", "Home").or_().gt("price", 1000.0); })
+    // 生成 is_active = ? AND (category = ? OR price > ?)，组内参数按顺序并入。可以任意嵌套。
+    template<typename Fn, typename = std::enable_if_t<std::is_invocable_v<Fn&, Query&>>>
+    Query& group(Fn&& build) {
+        Query sub;
+        build(sub);
+        return group(sub);
+    }
+
+    // 将另一个 Query 的条件作为一个分组并入 (只取 WHERE 条件和参数，忽略排序分页)，
+    // 便于把常用条件组合封装为可复用的对象
+    Query& group(const Query& sub) {
+        if (sub.whereClause_.empty()) {
+            nextConnector_ = "AND"; // 空分组不生成条件，之前的 or_() 也不再作用于下一个条件
+            return *this;
+        }
+        appendConnector();
+        whereClause_ += '(';
+        whereClause_ += sub.whereClause_.view();
+        whereClause_ += ')';
+        params_.append(sub.params_.data(), sub.params_.size());
+        return *this;
+    }
+
     // 基本比较
-    Query& eq(const std::string& col, const SqlValue& val) {
+    Query& eq(std::string_view col, const SqlValue& val) {
         appendCondition(col, "=", val);
         return *this;
     }
 
-    Query& ne(const std::string& col, const SqlValue& val) {
+    Query& ne(std::string_view col, const SqlValue& val) {
         appendCondition(col, "!=", val);
         return *this;
     }
 
-    Query& gt(const std::string& col, const SqlValue& val) {
+    Query& gt(std::string_view col, const SqlValue& val) {
         appendCondition(col, ">", val);
         return *this;
     }
     
-    Query& lt(const std::string& col, const SqlValue& val) {
+    Query& lt(std::string_view col, const SqlValue& val) {
         appendCondition(col, "<", val);
         return *this;
     }
 
-    Query& ge(const std::string& col, const SqlValue& val) {
+    Query& ge(std::string_view col, const SqlValue& val) {
         appendCondition(col, ">=", val);
         return *this;
     }
 
-    Query& le(const std::string& col, const SqlValue& val) {
+    Query& le(std::string_view col, const SqlValue& val) {
         appendCondition(col, "<=", val);
         return *this;
     }
 
-    Query& like(const std::string& col, const std::string& val) {
+    Query& like(std::string_view col, const SqlValue& val) {
         appendCondition(col, "LIKE", val);
         return *this;
     }
 
     // 空值检查
-    Query& isNull(const std::string& col) {
+    Query& isNull(std::string_view col) {
         appendConditionNoVal(col, "IS NULL");
         return *this;
     }
 
-    Query& isNotNull(const std::string& col) {
+    Query& isNotNull(std::string_view col) {
         appendConditionNoVal(col, "IS NOT NULL");
         return *this;
     }
 
     // 范围查询
-    Query& between(const std::string& col, const SqlValue& min, const SqlValue& max) {
+    Query& between(std::string_view col, const SqlValue& min, const SqlValue& max) {
         appendConnector();
-        whereClause_ += col + " BETWEEN ? AND ?";
+        whereClause_ += col;
+        whereClause_ += " BETWEEN ? AND ?";
         params_.push_back(min);
         params_.push_back(max);
         return *this;
     }
 
     // 集合查询
+    // 列表整体作为一个数组参数记录，具体绑定方式 (展开 / 数组参数 / 分批) 由方言在组装 SQL 时决定
     template<typename T>
-    Query& in(const std::string& col, const std::vector<T>& values) {
+    Query& in(std::string_view col, const std::vector<T>& values) {
         if (values.empty()) {
             appendConnector();
             whereClause_ += "1=0"; // Empty IN list is always false
             return *this;
         }
         
-        appendConnector();
-        whereClause_ += col + " IN (";
-        for (size_t i = 0; i < values.size(); ++i) {
-            whereClause_ += (i == 0 ? "?" : ", ?");
-            params_.push_back(values[i]);
-        }
-        whereClause_ += ")";
+        appendInList(col, false, values);
         return *this;
     }
 
     template<typename T>
-    Query& notIn(const std::string& col, const std::vector<T>& values) {
+    Query& notIn(std::string_view col, const std::vector<T>& values) {
         if (values.empty()) {
             appendConnector();
             whereClause_ += "1=1"; // Empty NOT IN list is always true
             return *this;
         }
 
-        appendConnector();
-        whereClause_ += col + " NOT IN (";
-        for (size_t i = 0; i < values.size(); ++i) {
-            whereClause_ += (i == 0 ? "?" : ", ?");
-            params_.push_back(values[i]);
-        }
-        whereClause_ += ")";
+        appendInList(col, true, values);
         return *this;
     }
 
     // 排序分页
-    Query& orderBy(const std::string& col, bool asc = true) {
-        if (orderByClause_.empty()) {
-            orderByClause_ = " ORDER BY " + col + (asc ? " ASC" : " DESC");
-        } else {
-            orderByClause_ += ", " + col + (asc ? " ASC" : " DESC");
-        }
+    Query& orderBy(std::string_view col, bool asc = true) {
+        appendOrderBy(col, asc);
+        return *this;
+    }
+
+    // 类型化列引用：q.eq(&Product::category, "Electronics")
+    // 列名通过 TableMeta 解析，绑定值在编译期与成员类型做检查
+    template<typename C, typename M, typename V>
+    Query& eq(M C::* member, const V& val) { return appendTyped<M>(member, "=", val); }
+
+    template<typename C, typename M, typename V>
+    Query& ne(M C::* member, const V& val) { return appendTyped<M>(member, "!=", val); }
+
+    template<typename C, typename M, typename V>
+    Query& gt(M C::* member, const V& val) { return appendTyped<M>(member, ">", val); }
+
+    template<typename C, typename M, typename V>
+    Query& lt(M C::* member, const V& val) { return appendTyped<M>(member, "<", val); }
+
+    template<typename C, typename M, typename V>
+    Query& ge(M C::* member, const V& val) { return appendTyped<M>(member, ">=", val); }
+
+    template<typename C, typename M, typename V>
+    Query& le(M C::* member, const V& val) { return appendTyped<M>(member, "<=", val); }
+
+    template<typename C, typename V>
+    Query& like(std::string C::* member, const V& val) { return appendTyped<std::string>(member, "LIKE", val); }
+
+    template<typename C, typename M>
+    Query& isNull(M C::* member) {
+        appendConditionNoVal(requireColumn(member), "IS NULL");
+        return *this;
+    }
+
+    template<typename C, typename M>
+    Query& isNotNull(M C::* member) {
+        appendConditionNoVal(requireColumn(member), "IS NOT NULL");
+        return *this;
+    }
+
+    template<typename C, typename M, typename V>
+    Query& between(M C::* member, const V& min, const V& max) {
+        return between(requireColumn(member), toSqlValue<M>(min), toSqlValue<M>(max));
+    }
+
+    template<typename C, typename M, typename V>
+    Query& in(M C::* member, const std::vector<V>& values) {
+        static_assert(detail::isBindable<M, V>(), "IN 列表元素类型与列的成员类型不匹配");
+        return in(requireColumn(member), values);
+    }
+
+    template<typename C, typename M, typename V>
+    Query& notIn(M C::* member, const std::vector<V>& values) {
+        static_assert(detail::isBindable<M, V>(), "NOT IN 列表元素类型与列的成员类型不匹配");
+        return notIn(requireColumn(member), values);
+    }
+
+    template<typename C, typename M>
+    Query& orderBy(M C::* member, bool asc = true) {
+        appendOrderBy(requireColumn(member), asc);
+        return *this;
+    }
+
+    // 编译期列引用：q.eq<&Product::category>("Electronics")
+    // 未注册的成员无法通过编译，条件片段 "category = ?" 在编译期拼接完成
+    template<auto Member, typename V>
+    Query& eq(const V& val) { return appendFragment<Member, detail::kEqSuffix>(val); }
+
+    template<auto Member, typename V>
+    Query& ne(const V& val) { return appendFragment<Member, detail::kNeSuffix>(val); }
+
+    template<auto Member, typename V>
+    Query& gt(const V& val) { return appendFragment<Member, detail::kGtSuffix>(val); }
+
+    template<auto Member, typename V>
+    Query& lt(const V& val) { return appendFragment<Member, detail::kLtSuffix>(val); }
+
+    template<auto Member, typename V>
+    Query& ge(const V& val) { return appendFragment<Member, detail::kGeSuffix>(val); }
+
+    template<auto Member, typename V>
+    Query& le(const V& val) { return appendFragment<Member, detail::kLeSuffix>(val); }
+
+    template<auto Member, typename V>
+    Query& like(const V& val) {
+        static_assert(std::is_same_v<typename Column<Member>::Type, std::string>, "LIKE 只能用于字符串列");
+        return appendFragment<Member, detail::kLikeSuffix>(val);
+    }
+
+    template<auto Member>
+    Query& isNull() {
+        appendConnector();
+        whereClause_ += ColumnFragment<Member, detail::kIsNullSuffix>::view();
+        return *this;
+    }
+
+    template<auto Member>
+    Query& isNotNull() {
+        appendConnector();
+        whereClause_ += ColumnFragment<Member, detail::kIsNotNullSuffix>::view();
+        return *this;
+    }
+
+    template<auto Member, typename V>
+    Query& between(const V& min, const V& max) {
+        using M = typename Column<Member>::Type;
+        appendConnector();
+        whereClause_ += ColumnFragment<Member, detail::kBetweenSuffix>::view();
+        params_.push_back(toSqlValue<M>(min));
+        params_.push_back(toSqlValue<M>(max));
+        return *this;
+    }
+
+    template<auto Member, typename V>
+    Query& in(const std::vector<V>& values) {
+        static_assert(detail::isBindable<typename Column<Member>::Type, V>(), "IN 列表元素类型与列的成员类型不匹配");
+        return in(Column<Member>::name, values);
+    }
+
+    template<auto Member, typename V>
+    Query& notIn(const std::vector<V>& values) {
+        static_assert(detail::isBindable<typename Column<Member>::Type, V>(), "NOT IN 列表元素类型与列的成员类型不匹配");
+        return notIn(Column<Member>::name, values);
+    }
+
+    template<auto Member>
+    Query& orderBy(bool asc = true) {
+        appendOrderBy(Column<Member>::name, asc);
         return *this;
     }
 
     Query& limit(int limit) {
-        limitClause_ = " LIMIT " + std::to_string(limit);
+        setNumberClause(limitClause_, " LIMIT ", limit);
         return *this;
     }
 
     Query& offset(int offset) {
-        offsetClause_ = " OFFSET " + std::to_string(offset);
+        setNumberClause(offsetClause_, " OFFSET ", offset);
+        return *this;
+    }
+
+    // 在主库上执行，不分配到只读副本，用于读取刚写入的数据
+    Query& fromPrimary() {
+        fromPrimary_ = true;
         return *this;
     }
 
-    // 获取构建结果
-    std::string getWhere() const {
+    // 获取构建结果 (视图指向 Query 内部缓冲区，Query 修改或销毁后失效)
+    std::string_view getWhere() const {
         return whereClause_;
     }
 
-    std::string getOrderBy() const {
+    std::string_view getOrderBy() const {
         return orderByClause_;
     }
 
-    std::string getLimit() const {
+    std::string_view getLimit() const {
         return limitClause_;
     }
 
-    std::string getOffset() const {
+    std::string_view getOffset() const {
         return offsetClause_;
     }
 
-    const std::vector<SqlValue>& getParams() const {
-        return params_;
+    ParamView getParams() const {
+        return ParamView(params_.data(), params_.size());
+    }
+
+    bool readsPrimary() const {
+        return fromPrimary_;
+    }
+
+    // 把借用调用方内存的参数 (const char*、string_view) 复制为 std::string，
+    // 查询延后到调用方的字符串可能已失效时才执行 (selectAsync / countAsync) 之前调用
+    Query& ownParams() {
+        for (auto& param : params_) {
+            if (detail::borrowsMemory(param)) param = detail::ownedSqlValue(param);
+        }
+        return *this;
     }
 
 private:
-    std::string whereClause_;
-    std::string orderByClause_;
-    std::string limitClause_;
-    std::string offsetClause_;
-    std::vector<SqlValue> params_;
-    std::string nextConnector_ = "AND";
+    InlineString<384> whereClause_;
+    InlineString<96> orderByClause_;
+    InlineString<24> limitClause_;
+    InlineString<24> offsetClause_;
+    SmallVector<SqlValue, 16> params_;
+    const char* nextConnector_ = "AND";
+    bool fromPrimary_ = false;
+
+    template<size_t N>
+    static void setNumberClause(InlineString<N>& clause, std::string_view keyword, int value) {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        clause.clear();
+        clause += keyword;
+        clause += std::string_view(digits, result.ptr - digits);
+    }
 
     void appendConnector() {
         if (!whereClause_.empty()) {
-            whereClause_ += " " + nextConnector_ + " ";
+            whereClause_ += ' ';
+            whereClause_ += nextConnector_;
+            whereClause_ += ' ';
         }
         nextConnector_ = "AND"; // Reset to default
     }
 
-    void appendCondition(const std::string& col, const std::string& op, const SqlValue& val) {
+    void appendCondition(std::string_view col, std::string_view op, const SqlValue& val) {
         appendConnector();
-        whereClause_ += col + " " + op + " ?";
+        whereClause_ += col;
+        whereClause_ += ' ';
+        whereClause_ += op;
+        whereClause_ += " ?";
         params_.push_back(val);
     }
 
-    void appendConditionNoVal(const std::string& col, const std::string& op) {
+    void appendConditionNoVal(std::string_view col, std::string_view op) {
+        appendConnector();
+        whereClause_ += col;
+        whereClause_ += ' ';
+        whereClause_ += op;
+    }
+
+    void appendOrderBy(std::string_view col, bool asc) {
+        orderByClause_ += orderByClause_.empty() ? " ORDER BY " : ", ";
+        orderByClause_ += col;
+        orderByClause_ += asc ? " ASC" : " DESC";
+    }
+
+    template<typename T>
+    void appendInList(std::string_view col, bool negated, const std::vector<T>& values) {
         appendConnector();
-        whereClause_ += col + " " + op;
+        auto arr = std::make_shared<SqlArray>();
+        arr->column = std::string(col);
+        arr->negated = negated;
+        arr->values.assign(values.begin(), values.end());
+        whereClause_ += "?";
+        params_.push_back(std::shared_ptr<const SqlArray>(std::move(arr)));
+    }
+
+    template<typename C, typename M>
+    static const char* requireColumn(M C::* member) {
+        const char* name = columnNameOf(member);
+        if (!name) {
+            throw OrmError(std::string("成员未在表 ") + TableMeta<C>::name + " 中注册为字段");
+        }
+        return name;
+    }
+
+    template<typename M, typename C, typename V>
+    Query& appendTyped(M C::* member, std::string_view op, const V& val) {
+        appendCondition(requireColumn(member), op, toSqlValue<M>(val));
+        return *this;
+    }
+
+    template<auto Member, const char* Suffix, typename V>
+    Query& appendFragment(const V& val) {
+        appendConnector();
+        whereClause_ += ColumnFragment<Member, Suffix>::view();
+        params_.push_back(toSqlValue<typename Column<Member>::Type>(val));
+        return *this;
+    }
+
+    // 按成员类型转换绑定值，类型不匹配时编译失败
+    template<typename M, typename V>
+    static SqlValue toSqlValue(const V& val) {
+        static_assert(std::is_same_v<V, SqlPlaceholder> || detail::isBindable<M, V>(), "绑定值类型与列的成员类型不匹配");
+        if constexpr (std::is_same_v<V, SqlPlaceholder>) {
+            return SqlValue(val);
+        } else if constexpr (std::is_same_v<M, std::string>) {
+            if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::string_view> ||
+                          std::is_convertible_v<const V&, const char*>) return SqlValue(val);
+            else return SqlValue(std::string(val));
+        } else if constexpr (std::is_same_v<M, bool>) {
+            return SqlValue(static_cast<bool>(val));
+        } else if constexpr (std::is_floating_point_v<M>) {
+            return SqlValue(static_cast<double>(val));
+        } else if constexpr (std::is_integral_v<M> && std::is_signed_v<M>) {
+            if constexpr (sizeof(M) <= sizeof(int)) return SqlValue(static_cast<int>(val));
+            else return SqlValue(static_cast<long long>(val));
+        } else if constexpr (std::is_integral_v<M>) {
+            if constexpr (sizeof(M) <= sizeof(unsigned int)) return SqlValue(static_cast<unsigned int>(val));
+            else return SqlValue(static_cast<unsigned long long>(val));
+        } else {
+            return SqlValue(static_cast<M>(val));
+        }
     }
 };
 
@@ -0,0 +1,247 @@
+#pragma once
+#include "uORM/orm/Reflection.h"
+#include "uORM/orm/SqlValue.h"
+#include "uORM/orm/EntityCache.h"
+#include "uORM/orm/ShardedLru.h"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace uORM {
+
+// 表版本号：每次经 Mapper 写入某个连接池上的某张表时递增，查询缓存条目记录生成时的版本，版本变化即视为失效。
+// 不同连接池 (命名数据库) 中的同名表互不影响
+class TableVersions {
+public:
+    static TableVersions& instance() {
+        static TableVersions inst;
+        return inst;
+    }
+
+    // 返回连接池 pool 上表 table 的版本计数器，引用在进程生命周期内有效，调用方可以缓存
+    std::atomic<uint64_t>& counter(const std::string& pool, const std::string& table) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = versions_.find(pool);
+            if (it != versions_.end()) {
+                auto slot = it->second.find(table);
+                if (slot != it->second.end()) return *slot->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto& slot = versions_[pool][table];
+        if (!slot) slot = std::make_unique<std::atomic<uint64_t>>(0);
+        return *slot;
+    }
+
+    void bump(const std::string& pool, const std::string& table) {
+        counter(pool, table).fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    TableVersions(const TableVersions&) = delete;
+    TableVersions& operator=(const TableVersions&) = delete;
+
+private:
+    TableVersions() = default;
+
+    std::shared_mutex mutex_;
+    std::unordered_map<std::string, std::unordered_map<std::string, std::unique_ptr<std::atomic<uint64_t>>>> versions_;
+};
+
+// 查询缓存配置
+struct QueryCacheOptions {
+    size_t shards = 16;                       // 分片数量，向上取整为 2 的幂
+    std::chrono::milliseconds ttl{0};         // 条目存活时间，0 表示不过期
+    size_t max_bytes = 64 * 1024 * 1024;      // 内存预算 (估算值)，平均分配到各分片
+};
+
+// 查询缓存统计
+struct QueryCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stale = 0;       // 因表版本变化被丢弃的条目
+    uint64_t evictions = 0;   // 超出内存预算被淘汰的条目
+    uint64_t expirations = 0; // 超过 TTL 被丢弃的条目
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+namespace detail {
+
+// 把参数追加到缓存键：类别标记 + 定长或带长度前缀的值。
+// 同一类别的不同 C++ 类型 (const char* 与 std::string、int 与 long long) 编码相同，
+// 不同类别或不同取值不会产生相同的编码
+inline void appendFingerprint(std::string& out, const SqlValue& value) {
+    std::visit([&](const auto& v) {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::string_view> || std::is_same_v<V, const char*>) {
+            out += 'S';
+            std::string_view s;
+            if constexpr (std::is_same_v<V, const char*>) {
+                if (v) s = v;
+            } else {
+                s = v;
+            }
+            out += std::to_string(s.size());
+            out += ':';
+            out += s;
+        } else if constexpr (std::is_same_v<V, bool>) {
+            out += v ? 'T' : 'F';
+        } else if constexpr (std::is_same_v<V, double>) {
+            out += 'D';
+            char buf[sizeof(double)];
+            std::memcpy(buf, &v, sizeof(double));
+            out.append(buf, sizeof(double));
+        } else if constexpr (std::is_integral_v<V>) {
+            out += 'I';
+            char buf[24];
+            auto res = std::to_chars(buf, buf + sizeof(buf), v);
+            out.append(buf, res.ptr);
+            out += ';';
+        } else if constexpr (std::is_same_v<V, std::nullptr_t>) {
+            out += 'N';
+        } else if constexpr (std::is_same_v<V, std::shared_ptr<const SqlArray>>) {
+            out += v->negated ? '!' : '=';
+            out += v->column;
+            out += '#';
+            out += std::to_string(v->values.size());
+            out += ':';
+            for (const auto& item : v->values) appendFingerprint(out, item);
+        } else {
+            out += '?';
+        }
+    }, value);
+}
+
+} // namespace detail
+
+// 查询结果缓存：以 "连接池 + 规范化 SQL + 参数指纹" 为键缓存 Mapper<T>::select / count 的结果，
+// 每个表类型独立开启。条目记录生成时 T 所在表在该连接池上的版本号，经 Mapper 对该表的任何写入都会使其失效。
+// 绕过 Mapper 的写入 (原生 SQL、其他进程) 不会被感知，只能依靠 TTL 过期。
+//
+// uORM::QueryCache<Product>::instance().enable(options);
+template<typename T>
+class QueryCache {
+public:
+    using Rows = std::shared_ptr<const std::vector<T>>;
+
+    static QueryCache& instance() {
+        static QueryCache inst;
+        return inst;
+    }
+
+    // 开启缓存。应在初始化阶段、并发访问之前调用；重复调用会清空现有条目并应用新配置
+    void enable(const QueryCacheOptions& options = QueryCacheOptions()) {
+        lru_.enable(options.shards, options.ttl, options.max_bytes);
+    }
+
+    void disable() {
+        lru_.disable();
+    }
+
+    bool enabled() const {
+        return lru_.enabled();
+    }
+
+    // 缓存键：连接池名 + 语句类别 + 最终 SQL + 参数指纹。pool 为 ConnectionPool::forType<T>() 的名字，
+    // PoolScope 切换到其他数据库时不会命中默认数据库的结果
+    static std::string makeKey(const std::string& pool, char kind, std::string_view sql, ParamView params) {
+        std::string key;
+        key.reserve(pool.size() + sql.size() + params.size() * 8 + 3);
+        key += pool;
+        key += '\0';
+        key += kind;
+        key += sql;
+        key += '\0';
+        for (const auto& param : params) detail::appendFingerprint(key, param);
+        return key;
+    }
+
+    // 表在连接池 pool 上的当前版本。必须在访问数据库之前读取，存入条目时使用，
+    // 这样读取期间发生的写入会使刚存入的条目立即失效
+    uint64_t version(const std::string& pool) const {
+        return counter(pool).load(std::memory_order_acquire);
+    }
+
+    Rows getRows(const std::string& key) {
+        Rows rows;
+        lookup(key, [&](const Entry& entry) { rows = entry.rows; });
+        return rows;
+    }
+
+    bool getCount(const std::string& key, long long& count) {
+        return lookup(key, [&](const Entry& entry) { count = entry.count; });
+    }
+
+    // pool 与生成 key 时一致，version 为访问数据库之前读取的 version(pool)
+    void putRows(const std::string& pool, const std::string& key, uint64_t version, const std::vector<T>& rows) {
+        size_t bytes = 0;
+        for (const auto& row : rows) bytes += detail::estimateEntityBytes(row);
+        store(pool, key, Entry{std::make_shared<const std::vector<T>>(rows), 0, version, nullptr}, bytes);
+    }
+
+    void putCount(const std::string& pool, const std::string& key, uint64_t version, long long count) {
+        store(pool, key, Entry{nullptr, count, version, nullptr}, 0);
+    }
+
+    void clear() {
+        lru_.clear();
+    }
+
+    QueryCacheStats stats() const {
+        auto lru = lru_.stats();
+        QueryCacheStats total;
+        total.hits = lru.hits;
+        total.misses = lru.misses;
+        total.stale = lru.stale;
+        total.evictions = lru.evictions;
+        total.expirations = lru.expirations;
+        total.entries = lru.entries;
+        total.bytes = lru.bytes;
+        return total;
+    }
+
+    QueryCache(const QueryCache&) = delete;
+    QueryCache& operator=(const QueryCache&) = delete;
+
+private:
+    struct Entry {
+        Rows rows;
+        long long count;
+        uint64_t version;
+        const std::atomic<uint64_t>* counter; // 条目所属连接池上的表版本
+    };
+
+    QueryCache() = default;
+
+    static std::atomic<uint64_t>& counter(const std::string& pool) {
+        return TableVersions::instance().counter(pool, TableMeta<T>::name);
+    }
+
+    // 条目的表版本与当前不一致即视为过期
+    template<typename Fn>
+    bool lookup(const std::string& key, Fn&& onHit) {
+        return lru_.get(key, [](const Entry& entry) { return entry.version == entry.counter->load(std::memory_order_acquire); }, onHit);
+    }
+
+    void store(const std::string& pool, const std::string& key, Entry&& entry, size_t bytes) {
+        // 读取期间表已被写入，结果可能是旧数据，不再缓存
+        const auto& current = counter(pool);
+        if (entry.version != current.load(std::memory_order_acquire)) return;
+        entry.counter = &current;
+        lru_.put(key, std::move(entry), bytes);
+    }
+
+    detail::ShardedLru<std::string, Entry> lru_;
+};
+
+} // namespace uORM
@@ -0,0 +1,339 @@
+#pragma once
+#include "uORM/driver/RedisPool.h"
+#include "uORM/orm/BinaryCodec.h"
+#include "uORM/orm/Column.h"
+#include "uORM/orm/Logger.h"
+#include "uORM/orm/Reflection.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace uORM {
+
+// Redis 缓存配置
+struct RedisCacheOptions {
+    bool cache_entities = true;                        // 缓存 findById 的结果
+    bool cache_queries = true;                         // 缓存 select / count 的结果
+    std::chrono::milliseconds entity_ttl{60000};
+    std::chrono::milliseconds query_ttl{10000};
+    std::chrono::milliseconds tombstone_ttl{2000};     // 写入后阻止回填的时间，应大于一次数据库读取的耗时
+    std::chrono::milliseconds retry_after{1000};       // Redis 出错后暂停访问的时间
+    std::string key_prefix = "uorm:";
+};
+
+// Redis 缓存统计
+struct RedisCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t errors = 0;  // 访问 Redis 失败的次数
+    uint64_t skipped = 0; // Redis 暂停访问期间跳过的次数
+};
+
+// 多实例共享的 Redis 缓存层，位于进程内缓存 (EntityCache / QueryCache) 与数据库之间，每个表类型独立开启。
+//
+// 键布局 (以默认前缀为例，<连接池> 为 ConnectionPool::forType<T>() 的名字，不同数据库的同名表互不影响)：
+//   uorm:e:<连接池>:<表名>:<主键>      实体，值为 'V' + 布局指纹 + 清空版本 + BinaryCodec 编码；写入后替换为墓碑 'X'
+//   uorm:q:<连接池>:<表名>:<键哈希>    查询结果，值为 'Q' + 布局指纹 + 表版本 + 完整缓存键 + 结果
+//   uorm:tv:<连接池>:<表名>            表版本，经 Mapper 的每次写入 INCR
+//   uorm:te:<连接池>:<表名>            清空版本，truncate 时 INCR
+//
+// 读取时用 MGET 同时取回值和版本号，一次往返完成校验。回填实体使用 SET NX，
+// 写入留下的墓碑在 tombstone_ttl 内阻止并发读取把旧值写回。
+// Redis 不可用时所有操作退化为未命中/空操作，不影响数据库访问。
+template<typename T>
+class RedisCache {
+public:
+    // 读取未能访问 Redis 时返回的版本号，带此版本的回填会被忽略
+    static constexpr uint64_t kNoVersion = ~uint64_t(0);
+
+    static RedisCache& instance() {
+        static RedisCache inst;
+        return inst;
+    }
+
+    // 开启缓存。应在初始化阶段、并发访问之前调用；需要先调用 readRedisconfig
+    void enable(const RedisCacheOptions& options = RedisCacheOptions()) {
+        options_ = options;
+        table_ = TableMeta<T>::name;
+        entityTtl_ = std::to_string(options_.entity_ttl.count());
+        queryTtl_ = std::to_string(options_.query_ttl.count());
+        tombstoneTtl_ = std::to_string(options_.tombstone_ttl.count());
+        RedisPool::instance();
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    void disable() {
+        enabled_.store(false, std::memory_order_release);
+    }
+
+    bool enabled() const {
+        return enabled_.load(std::memory_order_acquire);
+    }
+
+    bool cachesEntities() const {
+        return enabled() && options_.cache_entities;
+    }
+
+    bool cachesQueries() const {
+        return enabled() && options_.cache_queries;
+    }
+
+    // 按主键读取连接池 pool 中的实体。未命中时通过 epoch 返回当前清空版本，回填时使用
+    template<typename K>
+    std::optional<T> getEntity(const std::string& pool, const K& id, uint64_t& epoch) {
+        std::optional<T> result;
+        std::string key = entityKey(pool, id);
+        std::string epochKey = scopedKey("te:", pool);
+        epoch = kNoVersion;
+        run([&](RedisConnection& conn) {
+            auto reply = conn.command({"MGET", key, epochKey});
+            epoch = parseVersion(element(reply, 1));
+            const RedisReply& value = element(reply, 0);
+            std::string_view in = value.str;
+            uint64_t stored = 0;
+            T entity{};
+            if (value.type == RedisReply::Type::String && readHeader(in, 'V', stored) && stored == epoch &&
+                BinaryCodec<T>::decode(in, entity)) {
+                result = std::move(entity);
+            }
+        });
+        count(result.has_value());
+        return result;
+    }
+
+    // 回填实体；键已存在 (包括写入留下的墓碑) 时不覆盖
+    void fillEntity(const std::string& pool, const T& entity, uint64_t epoch) {
+        if (epoch == kNoVersion) return;
+        std::string key = entityKey(pool, PrimaryKey<T>::get(entity));
+        std::string value;
+        writeHeader(value, 'V', epoch);
+        BinaryCodec<T>::encode(entity, value);
+        run([&](RedisConnection& conn) {
+            conn.command({"SET", key, value, "PX", entityTtl_, "NX"});
+        });
+    }
+
+    // 读取查询结果，key 为 QueryCache<T>::makeKey 生成的完整缓存键。未命中时通过 version 返回当前表版本
+    std::optional<std::vector<T>> getRows(const std::string& pool, const std::string& key, uint64_t& version) {
+        std::optional<std::vector<T>> result;
+        getQuery(pool, key, version, [&](std::string_view payload) {
+            std::vector<T> rows;
+            if (BinaryCodec<T>::decodeList(payload, rows)) result = std::move(rows);
+        });
+        count(result.has_value());
+        return result;
+    }
+
+    bool getCount(const std::string& pool, const std::string& key, long long& total, uint64_t& version) {
+        bool hit = false;
+        getQuery(pool, key, version, [&](std::string_view payload) {
+            uint64_t value = 0;
+            if (BinaryCodec<T>::readVarint(payload, value)) {
+                total = static_cast<long long>(value);
+                hit = true;
+            }
+        });
+        count(hit);
+        return hit;
+    }
+
+    void putRows(const std::string& pool, const std::string& key, uint64_t version, const std::vector<T>& rows) {
+        if (version == kNoVersion) return;
+        std::string value = queryValueHeader(key, version);
+        BinaryCodec<T>::encodeList(rows, value);
+        putQuery(pool, key, value);
+    }
+
+    void putCount(const std::string& pool, const std::string& key, uint64_t version, long long total) {
+        if (version == kNoVersion) return;
+        std::string value = queryValueHeader(key, version);
+        BinaryCodec<T>::writeVarint(value, static_cast<uint64_t>(total));
+        putQuery(pool, key, value);
+    }
+
+    // Mapper 写入连接池 pool 成功后调用：实体键替换为墓碑，表版本加一
+    void onWrite(const std::string& pool, const T& entity) {
+        std::string versionKey = scopedKey("tv:", pool);
+        run([&](RedisConnection& conn) {
+            if constexpr (detail::primaryKeyCount<T>() == 1) {
+                std::string key = entityKey(pool, PrimaryKey<T>::get(entity));
+                conn.pipeline({{"SET", key, "X", "PX", tombstoneTtl_}, {"INCR", versionKey}});
+            } else {
+                conn.command({"INCR", versionKey});
+            }
+        });
+    }
+
+    // truncate 后调用：表版本与清空版本都加一，该连接池上的所有实体和查询结果同时失效
+    void onTruncate(const std::string& pool) {
+        std::string versionKey = scopedKey("tv:", pool);
+        std::string epochKey = scopedKey("te:", pool);
+        run([&](RedisConnection& conn) {
+            conn.pipeline({{"INCR", versionKey}, {"INCR", epochKey}});
+        });
+    }
+
+    RedisCacheStats stats() const {
+        RedisCacheStats s;
+        s.hits = hits_.load(std::memory_order_relaxed);
+        s.misses = misses_.load(std::memory_order_relaxed);
+        s.errors = errors_.load(std::memory_order_relaxed);
+        s.skipped = skipped_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    RedisCache(const RedisCache&) = delete;
+    RedisCache& operator=(const RedisCache&) = delete;
+
+private:
+    RedisCache() = default;
+
+    // 执行一次 Redis 访问；失败时记录并在 retry_after 内跳过后续访问
+    template<typename Fn>
+    void run(Fn&& fn) {
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        if (now < retryAt_.load(std::memory_order_relaxed)) {
+            skipped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        try {
+            auto conn = RedisPool::instance().getConnection();
+            fn(*conn);
+        } catch (const std::exception& e) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            auto pause = std::chrono::duration_cast<std::chrono::steady_clock::duration>(options_.retry_after);
+            retryAt_.store(now + pause.count(), std::memory_order_relaxed);
+            Logger::error("Redis cache error (", TableMeta<T>::name, "): ", e.what());
+        }
+    }
+
+    template<typename Fn>
+    void getQuery(const std::string& pool, const std::string& key, uint64_t& version, Fn&& onPayload) {
+        std::string redisKey = queryKey(pool, key);
+        std::string versionKey = scopedKey("tv:", pool);
+        version = kNoVersion;
+        run([&](RedisConnection& conn) {
+            auto reply = conn.command({"MGET", redisKey, versionKey});
+            version = parseVersion(element(reply, 1));
+            const RedisReply& value = element(reply, 0);
+            std::string_view in = value.str;
+            uint64_t stored = 0;
+            uint64_t keyLength = 0;
+            if (value.type != RedisReply::Type::String || !readHeader(in, 'Q', stored) || stored != version) return;
+            // 值中保存完整缓存键，哈希冲突时视为未命中
+            if (!BinaryCodec<T>::readVarint(in, keyLength) || in.size() < keyLength || in.substr(0, keyLength) != key) return;
+            in.remove_prefix(static_cast<size_t>(keyLength));
+            onPayload(in);
+        });
+    }
+
+    void putQuery(const std::string& pool, const std::string& key, const std::string& value) {
+        std::string redisKey = queryKey(pool, key);
+        run([&](RedisConnection& conn) {
+            conn.command({"SET", redisKey, value, "PX", queryTtl_});
+        });
+    }
+
+    std::string queryValueHeader(const std::string& key, uint64_t version) const {
+        std::string value;
+        value.reserve(key.size() + 32);
+        writeHeader(value, 'Q', version);
+        BinaryCodec<T>::writeVarint(value, key.size());
+        value += key;
+        return value;
+    }
+
+    // <前缀><类别><连接池>:<表名>
+    std::string scopedKey(std::string_view kind, const std::string& pool) const {
+        std::string key;
+        key.reserve(options_.key_prefix.size() + kind.size() + pool.size() + table_.size() + 24);
+        key += options_.key_prefix;
+        key += kind;
+        key += pool;
+        key += ':';
+        key += table_;
+        return key;
+    }
+
+    template<typename K>
+    std::string entityKey(const std::string& pool, const K& id) const {
+        std::string key = scopedKey("e:", pool);
+        key += ':';
+        if constexpr (std::is_arithmetic_v<K>) key += std::to_string(id);
+        else key += std::string_view(id);
+        return key;
+    }
+
+    // 查询键使用完整缓存键的 FNV-1a 64 位哈希
+    std::string queryKey(const std::string& pool, const std::string& key) const {
+        uint64_t h = 14695981039346656037ULL;
+        for (char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ULL;
+        }
+        char buf[17];
+        static const char digits[] = "0123456789abcdef";
+        for (int i = 15; i >= 0; --i) {
+            buf[i] = digits[h & 0xf];
+            h >>= 4;
+        }
+        std::string redisKey = scopedKey("q:", pool);
+        redisKey += ':';
+        redisKey.append(buf, 16);
+        return redisKey;
+    }
+
+    static void writeHeader(std::string& out, char tag, uint64_t version) {
+        out += tag;
+        uint32_t schema = BinaryCodec<T>::schemaHash();
+        for (int i = 0; i < 4; ++i) out += static_cast<char>((schema >> (8 * i)) & 0xff);
+        BinaryCodec<T>::writeVarint(out, version);
+    }
+
+    static bool readHeader(std::string_view& in, char tag, uint64_t& version) {
+        if (in.size() < 5 || in.front() != tag) return false;
+        uint32_t schema = 0;
+        for (int i = 0; i < 4; ++i) schema |= static_cast<uint32_t>(static_cast<unsigned char>(in[1 + i])) << (8 * i);
+        if (schema != BinaryCodec<T>::schemaHash()) return false;
+        in.remove_prefix(5);
+        return BinaryCodec<T>::readVarint(in, version);
+    }
+
+    static const RedisReply& element(const RedisReply& reply, size_t index) {
+        static const RedisReply nil;
+        if (reply.type != RedisReply::Type::Array || index >= reply.elements.size()) return nil;
+        return reply.elements[index];
+    }
+
+    static uint64_t parseVersion(const RedisReply& reply) {
+        if (reply.type != RedisReply::Type::String) return 0;
+        try {
+            return std::stoull(reply.str);
+        } catch (const std::exception&) {
+            return 0;
+        }
+    }
+
+    void count(bool hit) {
+        (hit ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    RedisCacheOptions options_;
+    std::string table_;
+    std::string entityTtl_;
+    std::string queryTtl_;
+    std::string tombstoneTtl_;
+    std::atomic<bool> enabled_{false};
+    std::atomic<long long> retryAt_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<uint64_t> skipped_{0};
+};
+
+} // namespace uORM
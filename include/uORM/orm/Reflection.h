@@ -60,6 +60,12 @@ struct TableMeta {
 template<typename T>
 constexpr bool is_registered_v = TableMeta<T>::is_registered;
 
+// 实体所在的命名连接池，默认 nullptr 表示默认连接池；用 UORM_TABLE_POOL 特化
+template<typename T>
+struct PoolBinding {
+    static constexpr const char* name = nullptr;
+};
+
 } // namespace uORM
 
 // 宏定义：开始注册表结构
@@ -101,3 +107,12 @@ constexpr bool is_registered_v = TableMeta<T>::is_registered;
         } \
     }; \
     }
+
+// 宏定义：把实体绑定到命名连接池 (配置文件 DataBases 中的 name)，该类型的 Mapper / Schema 调用都走这个池
+// 用法: UORM_TABLE_POOL(AuditLog, "audit")
+#define UORM_TABLE_POOL(Type, PoolName) \
+    namespace uORM { \
+    template<> struct PoolBinding<Type> { \
+        static constexpr const char* name = PoolName; \
+    }; \
+    }
@@ -0,0 +1,203 @@
+#pragma once
+#include "uORM/driver/DriverPolicy.h"
+#include "uORM/orm/Reflection.h"
+#include "uORM/orm/Column.h"
+#include "uORM/orm/Query.h"
+#include "uORM/orm/Error.h"
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace uORM {
+
+// Mapper 的唯一前置声明，驱动策略的默认值在此给出
+template<typename T, typename Driver = DefaultDriver>
+class Mapper;
+
+// 关联类型
+enum class RelationKind {
+    BelongsTo, // 本表外键指向目标表，例如 Order::product_id -> Product::id
+    HasMany    // 目标表外键指向本表，例如 Product::id <- Order::product_id
+};
+
+// 关联元数据：member 为存放关联对象的成员，local_key / remote_key 为两端用于匹配的列
+template<RelationKind Kind, typename Owner, typename Holder, typename LocalKey, typename Target, typename RemoteKey>
+struct RelationMeta {
+    using OwnerType = Owner;
+    using HolderType = Holder;
+    using TargetType = Target;
+    using RemoteKeyType = RemoteKey;
+    static constexpr RelationKind kind = Kind;
+
+    Holder Owner::* member;
+    LocalKey Owner::* local_key;
+    RemoteKey Target::* remote_key;
+};
+
+namespace detail {
+
+template<typename Holder, typename Target>
+constexpr bool isSingleHolder() {
+    return std::is_same_v<Holder, std::optional<Target>> ||
+           std::is_same_v<Holder, std::shared_ptr<Target>> ||
+           std::is_same_v<Holder, std::shared_ptr<const Target>>;
+}
+
+} // namespace detail
+
+// 声明 belongsTo 关联：belongsTo(&Order::product, &Order::product_id, &Product::id)
+// 关联成员可以是 std::optional<Target> 或 std::shared_ptr<(const) Target>
+template<typename Owner, typename Holder, typename LocalKey, typename Target, typename RemoteKey>
+constexpr auto belongsTo(Holder Owner::* member, LocalKey Owner::* foreignKey, RemoteKey Target::* targetKey) {
+    static_assert(detail::isSingleHolder<Holder, Target>(), "belongsTo 关联成员必须是 std::optional<Target> 或 std::shared_ptr<Target>");
+    return RelationMeta<RelationKind::BelongsTo, Owner, Holder, LocalKey, Target, RemoteKey>{member, foreignKey, targetKey};
+}
+
+// 声明 hasMany 关联：hasMany(&Product::orders, &Product::id, &Order::product_id)
+template<typename Owner, typename Target, typename LocalKey, typename RemoteKey>
+constexpr auto hasMany(std::vector<Target> Owner::* member, LocalKey Owner::* key, RemoteKey Target::* foreignKey) {
+    return RelationMeta<RelationKind::HasMany, Owner, std::vector<Target>, LocalKey, Target, RemoteKey>{member, key, foreignKey};
+}
+
+// 关联元数据模板，通过 UORM_RELATIONS 宏特化
+template<typename T>
+struct TableRelations {
+    static constexpr bool has_relations = false;
+};
+
+namespace detail {
+
+template<typename A, typename B>
+constexpr bool matchesRelation(A a, B b) {
+    if constexpr (std::is_same_v<A, B>) return a == b;
+    else return false;
+}
+
+template<typename Owner, auto Member>
+constexpr size_t relationIndexOf() {
+    constexpr auto relations = TableRelations<Owner>::get_relations();
+    size_t index = std::tuple_size_v<decltype(relations)>;
+    size_t i = 0;
+    std::apply([&](const auto&... rel) {
+        ((index = (index == std::tuple_size_v<decltype(relations)> && matchesRelation(rel.member, Member)) ? i : index, ++i), ...);
+    }, relations);
+    return index;
+}
+
+template<typename Holder, typename Target>
+void assignRelated(Holder& holder, const std::shared_ptr<Target>& target) {
+    if constexpr (std::is_same_v<Holder, std::optional<Target>>) {
+        if (target) holder = *target;
+        else holder.reset();
+    } else {
+        holder = target;
+    }
+}
+
+} // namespace detail
+
+// 批量预加载关联：对整批实体只发出一条 IN / ANY 查询 (MySQL 超长列表按块执行)，
+// 然后在内存中按键值拼接，避免逐条 findOne 的 N+1 查询
+template<auto Member, typename T>
+void loadRelation(std::vector<T>& entities) {
+    static_assert(TableRelations<T>::has_relations, "类型未使用 UORM_RELATIONS 声明关联");
+    constexpr auto relations = TableRelations<T>::get_relations();
+    constexpr size_t index = detail::relationIndexOf<T, Member>();
+    static_assert(index < std::tuple_size_v<decltype(relations)>, "成员未在 UORM_RELATIONS 中声明为关联");
+
+    constexpr auto rel = std::get<index>(relations);
+    using Rel = std::decay_t<decltype(rel)>;
+    using Target = typename Rel::TargetType;
+    using Key = typename Rel::RemoteKeyType;
+
+    if (entities.empty()) return;
+
+    // 收集去重后的关联键
+    std::vector<Key> keys;
+    std::unordered_set<Key> seen;
+    keys.reserve(entities.size());
+    for (const auto& entity : entities) {
+        Key key = static_cast<Key>(entity.*(rel.local_key));
+        if (seen.insert(key).second) keys.push_back(key);
+    }
+
+    const char* remoteColumn = columnNameOf(rel.remote_key);
+    if (!remoteColumn) {
+        throw OrmError(std::string("关联键未在表 ") + TableMeta<Target>::name + " 中注册为字段");
+    }
+
+    Query query;
+    query.in(remoteColumn, keys);
+    std::vector<Target> targets = Mapper<Target>::select(query);
+
+    if constexpr (Rel::kind == RelationKind::BelongsTo) {
+        // 同一个目标对象只构造一次，多个实体引用同一目标时共享
+        std::unordered_map<Key, std::shared_ptr<Target>> byKey;
+        byKey.reserve(targets.size());
+        for (auto& target : targets) {
+            Key key = target.*(rel.remote_key);
+            byKey.emplace(key, std::make_shared<Target>(std::move(target)));
+        }
+        for (auto& entity : entities) {
+            auto it = byKey.find(static_cast<Key>(entity.*(rel.local_key)));
+            detail::assignRelated(entity.*(rel.member), it != byKey.end() ? it->second : std::shared_ptr<Target>());
+        }
+    } else {
+        std::unordered_map<Key, std::vector<Target>> groups;
+        for (auto& target : targets) {
+            Key key = target.*(rel.remote_key);
+            groups[key].push_back(std::move(target));
+        }
+        for (auto& entity : entities) {
+            auto it = groups.find(static_cast<Key>(entity.*(rel.local_key)));
+            if (it != groups.end()) entity.*(rel.member) = it->second;
+            else (entity.*(rel.member)).clear();
+        }
+    }
+}
+
+// 查询结果列表，在 std::vector 的基础上支持链式预加载关联：
+// auto orders = Mapper<Order>::select(query).with<&Order::product>();
+template<typename T>
+class EntityList : public std::vector<T> {
+public:
+    using std::vector<T>::vector;
+
+    EntityList() = default;
+    EntityList(std::vector<T>&& values) : std::vector<T>(std::move(values)) {}
+
+    template<auto Member>
+    EntityList& with() & {
+        loadRelation<Member>(static_cast<std::vector<T>&>(*this));
+        return *this;
+    }
+
+    // 临时对象上调用时按值返回 (移动构造)，auto&& 绑定结果也不会悬空
+    template<auto Member>
+    EntityList with() && {
+        loadRelation<Member>(static_cast<std::vector<T>&>(*this));
+        return std::move(*this);
+    }
+};
+
+} // namespace uORM
+
+// 宏定义：注册关联 (放在 UORM_TABLE 注册之后)
+// 与 UORM_TABLE_POOL 一样不写在 UORM_TABLE_BEGIN 块内：关联成员不是列，
+// 且关联引用对端类型的成员，放在两张表都注册之后才能互相引用 (如 Order -> Product、Product -> Order)
+// 用法:
+// UORM_RELATIONS(Order,
+//     uORM::belongsTo(&Order::product, &Order::product_id, &Product::id))
+#define UORM_RELATIONS(Type, ...) \
+    namespace uORM { \
+    template<> struct TableRelations<Type> { \
+        static constexpr bool has_relations = true; \
+        static constexpr auto get_relations() { \
+            return std::make_tuple(__VA_ARGS__); \
+        } \
+    }; \
+    }
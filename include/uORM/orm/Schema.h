@@ -1,19 +1,31 @@
 #pragma once 
 #include "uORM/orm/Reflection.h" 
 #include "uORM/driver/ConnectionPool.h" 
+#include "uORM/driver/DriverPolicy.h"
+#include "uORM/orm/Column.h"
+#include "uORM/orm/Error.h"
+#include "uORM/orm/Logger.h"
 #include <string> 
 #include <vector> 
 #include <sstream> 
-#include <iostream> 
 #include <algorithm>
+#include <cstring>
 
 namespace uORM { 
 
-// Schema 类负责数据库结构的生成和管理
+// 表 T 的变更通知通道名，installNotifyTrigger 与 CacheInvalidationListener 共用
+template<typename T>
+std::string notifyChannel() {
+    return std::string("uorm_") + TableMeta<T>::name;
+}
+
+// Schema 类负责数据库结构的生成和管理。
+// 各方法的 Driver 为驱动策略，与 Mapper<T, Driver> 一致，默认 DefaultDriver；
+// 语句在 ConnectionPool::forType<T>() 的连接池上执行，与 Mapper<T> 相同
 class Schema { 
 public: 
     // 根据类型 T 的元数据创建数据库表
-    template<typename T> 
+    template<typename T, typename Driver = DefaultDriver> 
     static bool createTable() { 
         // 编译期检查：确保类型 T 已通过 UORM 宏注册
         if constexpr (!is_registered_v<T>) {
@@ -21,7 +33,8 @@ public:
             return false;
         }
 
-        auto dialect = ConnectionPool::instance().getDialect(); 
+        auto& pool = ConnectionPool::forType<T>(); 
+        auto dialect = Driver::dialect(pool); 
         if (!dialect) return false; 
 
         std::stringstream ss; 
@@ -35,9 +48,8 @@ public:
             (( 
                 ss << (first ? "" : ", ") 
                    << dialect->quoteIdentifier(field.column_name) << " " 
-                   // 优先使用自定义 SQL 类型，否则使用默认映射
-                   << (field.sql_type_override ? field.sql_type_override : getSqlType<typename std::decay_t<decltype(field)>::Type>()) 
-                   << " " << cleanConstraints(field.constraint_sql, dialect), 
+                   << columnType(field, *dialect) 
+                   << " " << cleanConstraints(field.constraint_sql, *dialect), 
                 first = false 
             ), ...); 
         }, fields); 
@@ -57,10 +69,10 @@ public:
         ss << ") " << dialect->getTableOptions(TableMeta<T>::options) << ";"; 
         
         std::string sql = ss.str(); 
-        std::cout << "执行 SQL: " << sql << std::endl; 
+        Logger::info("执行 SQL: ", sql); 
         
         // 尝试执行，如果失败（可能是默认值问题），尝试修复
-        if (!execute(sql)) {
+        if (!execute(pool, sql)) {
              // 简单的错误恢复逻辑：如果是因为 Invalid default value for 'xxx'，这通常是因为 MySQL 版本差异（如 5.7 vs 8.0 的 STRICT 模式）
              // 或者 TIMESTAMP 默认值问题。
              // 这里我们可以尝试去除 DEFAULT CURRENT_TIMESTAMP 再试一次，或者提示用户。
@@ -70,12 +82,66 @@ public:
         return true;
     } 
 
+    // 安装变更通知触发器 (仅 PostgreSQL)：表 T 的每次 INSERT / UPDATE / DELETE / TRUNCATE
+    // 在提交后向 notifyChannel<T>() 发出 "<操作>:<主键>" 通知，供 CacheInvalidationListener 驱逐缓存。
+    // 没有单列主键的表只发送操作名，监听端整表驱逐。可重复执行。
+    template<typename T, typename Driver = DefaultDriver>
+    static bool installNotifyTrigger() {
+        auto& pool = ConnectionPool::forType<T>();
+        auto dialect = Driver::dialect(pool);
+        if (!dialect) return false;
+        if (pool.config().driver_type != DriverType::PostgreSQL) {
+            throw OrmError("installNotifyTrigger 只支持 PostgreSQL");
+        }
+
+        std::string table = dialect->quoteIdentifier(TableMeta<T>::name);
+        std::string function = dialect->quoteIdentifier(notifyChannel<T>());
+        std::string rowTrigger = dialect->quoteIdentifier(notifyChannel<T>() + "_row");
+        std::string truncateTrigger = dialect->quoteIdentifier(notifyChannel<T>() + "_truncate");
+        std::string channel = "'" + notifyChannel<T>() + "'";
+
+        std::string newKey = "''";
+        std::string oldKey = "''";
+        if constexpr (detail::primaryKeyCount<T>() == 1) {
+            std::string pk = dialect->quoteIdentifier(PrimaryKey<T>::name);
+            newKey = "NEW." + pk + "::text";
+            oldKey = "OLD." + pk + "::text";
+        }
+
+        std::stringstream ss;
+        ss << "CREATE OR REPLACE FUNCTION " << function << "() RETURNS trigger AS $$\n"
+           << "BEGIN\n"
+           << "  IF TG_OP = 'TRUNCATE' THEN\n"
+           << "    PERFORM pg_notify(" << channel << ", 'TRUNCATE:');\n"
+           << "  ELSIF TG_OP = 'DELETE' THEN\n"
+           << "    PERFORM pg_notify(" << channel << ", 'DELETE:' || " << oldKey << ");\n"
+           << "  ELSE\n"
+           << "    PERFORM pg_notify(" << channel << ", TG_OP || ':' || " << newKey << ");\n"
+           << "    IF TG_OP = 'UPDATE' AND " << oldKey << " IS DISTINCT FROM " << newKey << " THEN\n"
+           << "      PERFORM pg_notify(" << channel << ", 'UPDATE:' || " << oldKey << ");\n"
+           << "    END IF;\n"
+           << "  END IF;\n"
+           << "  RETURN NULL;\n"
+           << "END;\n"
+           << "$$ LANGUAGE plpgsql";
+
+        return execute(pool, ss.str()) &&
+               execute(pool, "DROP TRIGGER IF EXISTS " + rowTrigger + " ON " + table) &&
+               execute(pool, "CREATE TRIGGER " + rowTrigger + " AFTER INSERT OR UPDATE OR DELETE ON " + table +
+                       " FOR EACH ROW EXECUTE PROCEDURE " + function + "()") &&
+               execute(pool, "DROP TRIGGER IF EXISTS " + truncateTrigger + " ON " + table) &&
+               execute(pool, "CREATE TRIGGER " + truncateTrigger + " AFTER TRUNCATE ON " + table +
+                       " FOR EACH STATEMENT EXECUTE PROCEDURE " + function + "()");
+    }
+
     // 删除表
-    template<typename T> 
+    template<typename T, typename Driver = DefaultDriver> 
     static bool dropTable() { 
-        auto dialect = ConnectionPool::instance().getDialect(); 
+        auto& pool = ConnectionPool::forType<T>(); 
+        auto dialect = Driver::dialect(pool); 
+        if (!dialect) return false; 
         std::string sql = "DROP TABLE IF EXISTS " + dialect->quoteIdentifier(TableMeta<T>::name) + ";"; 
-        return execute(sql); 
+        return execute(pool, sql); 
     } 
 
 private: 
@@ -85,15 +151,25 @@ private:
         return TypeMapping<FieldType>::type; 
     } 
 
+    // 列类型：优先使用自定义 SQL 类型，否则使用默认映射；方言要求时自增列改用方言指定的类型
+    template<typename Field>
+    static std::string columnType(const Field& field, const ISqlDialect& dialect) {
+        if (std::strstr(field.constraint_sql, "AUTO_INCREMENT")) {
+            std::string type = dialect.getAutoIncrementColumnType();
+            if (!type.empty()) return type;
+        }
+        return field.sql_type_override ? field.sql_type_override : getSqlType<typename Field::Type>();
+    }
+
     // 清理并适配约束字符串
-    static std::string cleanConstraints(const char* constraints, const std::shared_ptr<ISqlDialect>& dialect) { 
+    static std::string cleanConstraints(const char* constraints, const ISqlDialect& dialect) { 
         std::string s(constraints); 
         std::replace(s.begin(), s.end(), ',', ' '); 
         
         // 处理 AUTO_INCREMENT
         size_t pos = s.find("AUTO_INCREMENT"); 
         if (pos != std::string::npos) { 
-            std::string modifier = dialect->getAutoIncrementModifier(); 
+            std::string modifier = dialect.getAutoIncrementModifier(); 
             if (modifier.empty()) { 
                 // 如果方言不支持 AUTO_INCREMENT 修饰符 (如 PG 的 SERIAL 是类型的一部分，或者使用 GENERATED ALWAYS AS IDENTITY)
                 // 这里简单地将其移除，假设字段类型已经处理好了 (例如用户在 PG 中应该把字段类型定义为 SERIAL)
@@ -107,14 +183,14 @@ private:
     } 
 
     // 执行 SQL 语句
-    static bool execute(const std::string& sql) { 
+    static bool execute(ConnectionPool& pool, const std::string& sql) { 
         try { 
-            auto connPtr = ConnectionPool::instance().getConnection(); 
+            auto connPtr = pool.getConnection(); 
             auto stmt = connPtr->createStatement(); 
             stmt->execute(sql); 
             return true; 
         } catch (const std::exception& e) { 
-            std::cerr << "Schema 错误: " << e.what() << std::endl; 
+            Logger::error("Schema 错误: ", e.what()); 
             return false; 
         } 
     } 
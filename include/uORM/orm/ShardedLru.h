@@ -0,0 +1,192 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace uORM {
+namespace detail {
+
+// 分片 LRU 的统计，EntityCache / QueryCache 各自转换为公开的统计结构
+struct ShardedLruStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stale = 0;       // valid 判定为过期被丢弃的条目
+    uint64_t evictions = 0;   // 超出内存预算被淘汰的条目
+    uint64_t expirations = 0; // 超过 TTL 被丢弃的条目
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+// EntityCache 与 QueryCache 共用的分片 LRU：每个分片一把锁，条目带 TTL 与估算的内存占用，
+// 超出分片预算时从最久未使用的一端淘汰。分片的 generation 在失效时递增，
+// 回填方在访问数据库之前记下 generation，存入时不一致即放弃
+template<typename Key, typename Value>
+class ShardedLru {
+public:
+    // 字符串键在索引中以 string_view 指向条目内保存的键，不重复存储
+    using IndexKey = std::conditional_t<std::is_same_v<Key, std::string>, std::string_view, Key>;
+
+    // 开启并应用配置。应在初始化阶段、并发访问之前调用；重复调用会清空现有条目
+    void enable(size_t shards, std::chrono::milliseconds ttl, size_t maxBytes) {
+        enabled_.store(false, std::memory_order_release);
+
+        size_t count = 1;
+        while (count < shards) count <<= 1;
+        shards_ = std::vector<Shard>(count);
+        mask_ = count - 1;
+        ttl_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(ttl);
+        shardBudget_ = maxBytes / count;
+
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    void disable() {
+        enabled_.store(false, std::memory_order_release);
+        clear();
+    }
+
+    bool enabled() const {
+        return enabled_.load(std::memory_order_acquire);
+    }
+
+    // 查找条目：valid(value) 为 false 时按过期数据丢弃，命中时调用 onHit(value)。
+    // 未命中时通过 generation 返回分片的失效版本号
+    template<typename Valid, typename Hit>
+    bool get(const IndexKey& key, Valid&& valid, Hit&& onHit, uint64_t* generation = nullptr) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            auto entry = it->second;
+            if (!valid(entry->value)) {
+                ++shard.stats.stale;
+                erase(shard, it);
+            } else if (ttl_.count() != 0 && std::chrono::steady_clock::now() >= entry->expires_at) {
+                ++shard.stats.expirations;
+                erase(shard, it);
+            } else {
+                shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+                ++shard.stats.hits;
+                onHit(entry->value);
+                return true;
+            }
+        }
+
+        ++shard.stats.misses;
+        if (generation) *generation = shard.generation;
+        return false;
+    }
+
+    // 存入条目，bytes 为值本身的估算占用；给出 generation 且分片期间发生过失效时放弃
+    void put(const Key& key, Value value, size_t bytes, const uint64_t* generation = nullptr) {
+        // 条目占用：值、键以及链表/哈希表节点开销
+        bytes += sizeof(Entry) + 64;
+        if constexpr (std::is_same_v<Key, std::string>) bytes += key.size();
+        if (bytes > shardBudget_) return;
+
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (generation && shard.generation != *generation) return;
+
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) erase(shard, it);
+
+        shard.lru.push_front(Entry{key, std::move(value), std::chrono::steady_clock::now() + ttl_, bytes});
+        shard.index.emplace(IndexKey(shard.lru.front().key), shard.lru.begin());
+        shard.stats.bytes += bytes;
+        ++shard.stats.entries;
+
+        while (shard.stats.bytes > shardBudget_ && !shard.lru.empty()) {
+            ++shard.stats.evictions;
+            erase(shard, shard.index.find(IndexKey(shard.lru.back().key)));
+        }
+    }
+
+    // 使单个键失效
+    void invalidate(const IndexKey& key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        ++shard.generation;
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) erase(shard, it);
+    }
+
+    void clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            ++shard.generation;
+            shard.index.clear();
+            shard.lru.clear();
+            shard.stats.bytes = 0;
+            shard.stats.entries = 0;
+        }
+    }
+
+    ShardedLruStats stats() const {
+        ShardedLruStats total;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total.hits += shard.stats.hits;
+            total.misses += shard.stats.misses;
+            total.stale += shard.stats.stale;
+            total.evictions += shard.stats.evictions;
+            total.expirations += shard.stats.expirations;
+            total.entries += shard.stats.entries;
+            total.bytes += shard.stats.bytes;
+        }
+        return total;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        std::chrono::steady_clock::time_point expires_at;
+        size_t bytes;
+    };
+
+    using Index = std::unordered_map<IndexKey, typename std::list<Entry>::iterator>;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru; // 头部为最近使用
+        Index index;
+        uint64_t generation = 0;
+        ShardedLruStats stats;
+    };
+
+    Shard& shardFor(const IndexKey& key) {
+        // 对哈希值再做一次混合，避免连续整数主键集中到少数分片
+        uint64_t h = static_cast<uint64_t>(std::hash<IndexKey>{}(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return shards_[h & mask_];
+    }
+
+    void erase(Shard& shard, typename Index::iterator it) {
+        auto entry = it->second;
+        shard.stats.bytes -= entry->bytes;
+        --shard.stats.entries;
+        shard.index.erase(it);
+        shard.lru.erase(entry);
+    }
+
+    std::atomic<bool> enabled_{false};
+    std::vector<Shard> shards_;
+    size_t mask_ = 0;
+    std::chrono::steady_clock::duration ttl_{0};
+    size_t shardBudget_ = 0;
+};
+
+} // namespace detail
+} // namespace uORM
@@ -0,0 +1,458 @@
+#pragma once
+// 文件说明：
+// SlowQueryLog 记录耗时超过阈值的语句：SQL、绑定参数 (可脱敏)、耗时、行数与是否失败，
+// 并可按语句指纹限频采集一次 EXPLAIN (PostgreSQL: EXPLAIN (FORMAT JSON)，MySQL: EXPLAIN FORMAT=JSON，
+// SQLite: EXPLAIN QUERY PLAN)。
+//
+//   uORM::SlowQueryOptions options;
+//   options.threshold = std::chrono::milliseconds(200);
+//   options.explain = true;
+//   options.sink = uORM::SlowQueryLog::fileSink("/var/log/app/slow_query.log");
+//   uORM::SlowQueryLog::instance().configure(options);
+//
+// 慢查询记录交给后台线程处理，EXPLAIN 与写入 sink 都不在执行语句的线程上进行。
+// StatementTimer 是 Mapper 执行语句时使用的计时器，一次计时同时写入 Metrics 与慢查询日志，并开始一个追踪 span。
+
+#include "uORM/driver/ConnectionPool.h"
+#include "uORM/driver/ConfigManager.h"
+#include "uORM/orm/Logger.h"
+#include "uORM/orm/Metrics.h"
+#include "uORM/orm/SqlValue.h"
+#include "uORM/orm/Tracing.h"
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace uORM {
+
+struct SlowQueryRecord {
+    std::chrono::system_clock::time_point time;   // 语句结束的时间
+    uint64_t fingerprint = 0;
+    std::string sql;
+    std::string table;
+    std::string pool;                  // 连接池的名字 (只读副本为 "<库名>#replicaN")，默认连接池为空
+    std::vector<std::string> params;   // SQL 字面量形式；脱敏时只保留类型，如 <string>
+    double durationMs = 0;
+    uint64_t rows = 0;
+    bool failed = false;
+    std::string plan;                  // EXPLAIN 输出的 JSON，未采集时为空
+    std::string explainError;          // EXPLAIN 执行失败的原因
+
+    // 单行 JSON
+    std::string toJson() const;
+};
+
+struct SlowQueryOptions {
+    std::chrono::microseconds threshold{0};          // 0 表示关闭
+    bool redactParams = false;                       // 不记录参数值，只记录类型
+    bool explain = false;                            // 采集 EXPLAIN
+    std::chrono::seconds explainInterval{60};        // 同一指纹两次 EXPLAIN 的最小间隔
+    size_t maxPending = 1024;                        // 待处理记录上限，超出时丢弃并计数
+    std::function<void(const SlowQueryRecord&)> sink;   // 为空时以 JSON 行写入 Logger (Warn 级别)
+};
+
+namespace detail {
+
+inline void appendJsonString(std::string& out, std::string_view value) {
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+} // namespace detail
+
+inline std::string SlowQueryRecord::toJson() const {
+    std::string out = "{\"time\":";
+    std::time_t t = std::chrono::system_clock::to_time_t(time);
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    char ts[32];
+    std::strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    detail::appendJsonString(out, ts);
+    out += ",\"fingerprint\":";
+    detail::appendJsonString(out, detail::fingerprintHex(fingerprint));
+    out += ",\"table\":";
+    detail::appendJsonString(out, table);
+    if (!pool.empty()) {
+        out += ",\"pool\":";
+        detail::appendJsonString(out, pool);
+    }
+    out += ",\"duration_ms\":" + std::to_string(durationMs);
+    out += ",\"rows\":" + std::to_string(rows);
+    out += failed ? ",\"failed\":true" : ",\"failed\":false";
+    out += ",\"sql\":";
+    detail::appendJsonString(out, sql);
+    out += ",\"params\":[";
+    for (size_t i = 0; i < params.size(); ++i) {
+        if (i > 0) out += ',';
+        detail::appendJsonString(out, params[i]);
+    }
+    out += "]";
+    // 计划本身是 JSON，原样嵌入
+    if (!plan.empty()) out += ",\"plan\":" + plan;
+    if (!explainError.empty()) {
+        out += ",\"explain_error\":";
+        detail::appendJsonString(out, explainError);
+    }
+    out += "}";
+    return out;
+}
+
+class SlowQueryLog {
+public:
+    static SlowQueryLog& instance() {
+        static SlowQueryLog inst;
+        return inst;
+    }
+
+    void configure(SlowQueryOptions options) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        thresholdMicros_.store(options.threshold.count(), std::memory_order_relaxed);
+        options_ = std::move(options);
+    }
+
+    bool enabled() const {
+        return thresholdMicros_.load(std::memory_order_relaxed) > 0;
+    }
+
+    long long thresholdMicros() const {
+        return thresholdMicros_.load(std::memory_order_relaxed);
+    }
+
+    // 因队列已满被丢弃的记录数
+    uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    // 由 StatementTimer 在语句耗时超过阈值时调用；params 为执行时绑定的参数，pool 为执行语句的连接池 (EXPLAIN 也在该池上执行)
+    void report(uint64_t fingerprint, std::string_view sql, const char* table, std::vector<SqlValue> params,
+                uint64_t micros, uint64_t rows, bool failed, ConnectionPool* pool = nullptr) {
+        Pending item;
+        item.record.time = std::chrono::system_clock::now();
+        item.record.fingerprint = fingerprint;
+        item.record.sql.assign(sql);
+        if (table) item.record.table = table;
+        if (pool && pool->name() != ConnectionPool::DefaultName) item.record.pool = pool->name();
+        item.pool = pool;
+        item.record.durationMs = static_cast<double>(micros) / 1000.0;
+        item.record.rows = rows;
+        item.record.failed = failed;
+        item.params = std::move(params);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= options_.maxPending) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        queue_.push_back(std::move(item));
+        if (!worker_.joinable()) worker_ = std::thread([this] { work(); });
+        cond_.notify_one();
+    }
+
+    // 等待已提交的记录全部写入 sink
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return queue_.empty() && !busy_; });
+    }
+
+    // 以 JSON 行追加写入文件
+    static std::function<void(const SlowQueryRecord&)> fileSink(const std::string& path) {
+        auto file = std::make_shared<std::ofstream>(path, std::ios::app);
+        if (!*file) throw OrmError("无法打开慢查询日志文件: " + path);
+        return [file](const SlowQueryRecord& record) {
+            *file << record.toJson() << '\n';
+            file->flush();
+        };
+    }
+
+    SlowQueryLog(const SlowQueryLog&) = delete;
+    SlowQueryLog& operator=(const SlowQueryLog&) = delete;
+
+private:
+    struct Pending {
+        SlowQueryRecord record;
+        std::vector<SqlValue> params;
+        ConnectionPool* pool = nullptr;   // 连接池与进程同生命周期
+    };
+
+    SlowQueryLog() {
+        const auto& config = ConfigManager::getInstance().databaseconfigdata_;
+        options_.threshold = std::chrono::milliseconds(config.slow_query_ms);
+        options_.explain = config.slow_query_explain;
+        thresholdMicros_.store(options_.threshold.count(), std::memory_order_relaxed);
+    }
+
+    // 退出前写完队列中剩余的记录，不再执行 EXPLAIN
+    ~SlowQueryLog() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cond_.notify_all();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cond_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;
+            Pending item = std::move(queue_.front());
+            queue_.pop_front();
+            busy_ = true;
+            SlowQueryOptions options = options_;
+            bool explain = options.explain && !stopping_ && explainDue(item.record.fingerprint, options.explainInterval);
+            lock.unlock();
+
+            try {
+                process(item, options, explain);
+            } catch (...) {
+                // sink 抛出的异常不影响后续记录
+            }
+
+            lock.lock();
+            busy_ = false;
+            if (queue_.empty()) idle_.notify_all();
+        }
+    }
+
+    bool explainDue(uint64_t fingerprint, std::chrono::seconds interval) {
+        auto now = std::chrono::steady_clock::now();
+        auto it = lastExplain_.find(fingerprint);
+        if (it != lastExplain_.end() && now - it->second < interval) return false;
+        lastExplain_[fingerprint] = now;
+        return true;
+    }
+
+    void process(Pending& item, const SlowQueryOptions& options, bool explain) {
+        SlowQueryRecord& record = item.record;
+        record.params.reserve(item.params.size());
+        for (const auto& param : item.params) {
+            record.params.push_back(options.redactParams ? typeName(param) : literal(param));
+        }
+        if (explain && explainable(record.sql)) {
+            try {
+                record.plan = runExplain(item.pool ? *item.pool : ConnectionPool::instance(), record.sql, item.params);
+            } catch (const std::exception& e) {
+                record.explainError = e.what();
+            }
+        }
+        if (options.sink) {
+            options.sink(record);
+        } else {
+            Logger::warn("slow query: ", record.toJson());
+        }
+    }
+
+    // 只有 DML 与查询可以 EXPLAIN，DDL、TRUNCATE 等跳过
+    static bool explainable(std::string_view sql) {
+        size_t i = 0;
+        while (i < sql.size() && std::isspace(static_cast<unsigned char>(sql[i]))) ++i;
+        std::string word;
+        while (i < sql.size() && std::isalpha(static_cast<unsigned char>(sql[i]))) {
+            word += static_cast<char>(std::toupper(static_cast<unsigned char>(sql[i++])));
+        }
+        return word == "SELECT" || word == "INSERT" || word == "UPDATE" || word == "DELETE" || word == "WITH";
+    }
+
+    // 在执行语句的连接池的一条连接上以相同参数执行 EXPLAIN (不执行语句本身)
+    static std::string runExplain(ConnectionPool& pool, const std::string& sql, const std::vector<SqlValue>& params) {
+        auto dialect = pool.getDialect();
+        if (!dialect) throw OrmError("SQL 方言未初始化");
+        auto conn = pool.getConnection();
+        auto pstmt = conn->prepareStatement(dialect->explainSql(sql));
+        for (size_t i = 0; i < params.size(); ++i) {
+            bind(pstmt.get(), static_cast<int>(i + 1), params[i]);
+        }
+        auto res = pstmt->executeQuery();
+        std::vector<std::string> rows;
+        while (res->next()) rows.push_back(res->getString(dialect->explainColumn()));
+        // MySQL / PostgreSQL 返回一行 JSON；SQLite 每个计划节点一行文本，汇总为 JSON 字符串数组
+        if (rows.size() == 1 && !rows[0].empty() && (rows[0][0] == '{' || rows[0][0] == '[')) return rows[0];
+        std::string plan = "[";
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (i > 0) plan += ',';
+            detail::appendJsonString(plan, rows[i]);
+        }
+        return plan + "]";
+    }
+
+    static void bind(IPreparedStatement* pstmt, int index, const SqlValue& value) {
+        std::visit([&](const auto& v) {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<V, int>) pstmt->setInt(index, v);
+            else if constexpr (std::is_same_v<V, unsigned int>) pstmt->setUInt(index, v);
+            else if constexpr (std::is_same_v<V, long> || std::is_same_v<V, long long> || std::is_same_v<V, unsigned long long>)
+                pstmt->setInt64(index, static_cast<long long>(v));
+            else if constexpr (std::is_same_v<V, std::string>) pstmt->setString(index, v);
+            else if constexpr (std::is_same_v<V, bool>) pstmt->setBoolean(index, v);
+            else if constexpr (std::is_same_v<V, double>) pstmt->setDouble(index, v);
+            // 空值、数组与占位符在记录前已转换或不会出现
+        }, value);
+    }
+
+    static std::string literal(const SqlValue& value) {
+        return std::visit([](const auto& v) -> std::string {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<V, std::nullptr_t>) {
+                return "NULL";
+            } else if constexpr (std::is_same_v<V, bool>) {
+                return v ? "TRUE" : "FALSE";
+            } else if constexpr (std::is_same_v<V, std::string>) {
+                std::string out = "'";
+                for (char c : v) {
+                    if (c == '\'') out += '\'';
+                    out += c;
+                }
+                return out + "'";
+            } else if constexpr (std::is_arithmetic_v<V>) {
+                std::ostringstream ss;
+                ss.precision(17);
+                ss << v;
+                return ss.str();
+            } else {
+                return "?";
+            }
+        }, value);
+    }
+
+    static std::string typeName(const SqlValue& value) {
+        return std::visit([](const auto& v) -> std::string {
+            using V = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<V, std::nullptr_t>) return "NULL";
+            else if constexpr (std::is_same_v<V, bool>) return "<bool>";
+            else if constexpr (std::is_same_v<V, std::string>) return "<string>";
+            else if constexpr (std::is_floating_point_v<V>) return "<double>";
+            else if constexpr (std::is_arithmetic_v<V>) return "<int>";
+            else return "?";
+        }, value);
+    }
+
+    std::atomic<long long> thresholdMicros_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::condition_variable idle_;
+    SlowQueryOptions options_;
+    std::deque<Pending> queue_;
+    std::unordered_map<uint64_t, std::chrono::steady_clock::time_point> lastExplain_;
+    std::thread worker_;
+    bool busy_ = false;
+    bool stopping_ = false;
+};
+
+// 语句计时器：构造时开始计时，析构时按需写入 Metrics 与慢查询日志，并结束对应的追踪 span。
+// 析构时若有新的异常正在传播则记为失败；都未开启时不读取时钟
+class StatementTimer {
+public:
+    // pool 为执行语句的连接池，慢查询日志据此记录池名并在同一个池上 EXPLAIN；为空时视为默认连接池
+    StatementTimer(std::string_view sql, const char* table, ConnectionPool* pool = nullptr)
+        : StatementTimer(sql, table, std::nullopt, pool) {}
+
+    // 指纹已预先计算 (如 CompiledQuery) 时跳过哈希
+    StatementTimer(uint64_t fingerprint, std::string_view sql, const char* table, ConnectionPool* pool = nullptr)
+        : StatementTimer(sql, table, std::optional<uint64_t>(fingerprint), pool) {}
+
+    ~StatementTimer() {
+        if (!stats_ && !slow_ && !span_) return;
+        auto micros = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count());
+        bool failed = failed_ || std::uncaught_exceptions() > exceptions_;
+        if (stats_) stats_->record(micros, failed, rows_, bytes_);
+        auto& slowLog = SlowQueryLog::instance();
+        if (slow_ && static_cast<long long>(micros) >= slowLog.thresholdMicros()) {
+            uint64_t fp = fingerprint_ ? *fingerprint_ : detail::fingerprint(sql_);
+            slowLog.report(fp, sql_, table_, std::move(params_), micros, rows_, failed, pool_);
+        }
+        if (span_) {
+            span_->rows(rows_);
+            if (failed) span_->fail();
+        }
+    }
+
+    void rows(uint64_t n) {
+        rows_ += n;
+    }
+
+    template<typename V>
+    void bound(const V& value) {
+        if (stats_) bytes_ += detail::boundBytes(value);
+        if (slow_) params_.push_back(detail::ownedSqlValue(value));
+    }
+
+    void bound(ParamView params) {
+        for (const auto& p : params) bound(p);
+    }
+
+    void fail() {
+        failed_ = true;
+    }
+
+    StatementTimer(const StatementTimer&) = delete;
+    StatementTimer& operator=(const StatementTimer&) = delete;
+
+private:
+    StatementTimer(std::string_view sql, const char* table, std::optional<uint64_t> fingerprint, ConnectionPool* pool)
+        : sql_(sql), table_(table), pool_(pool), fingerprint_(fingerprint), exceptions_(std::uncaught_exceptions()) {
+        auto& metrics = Metrics::instance();
+        if (metrics.enabled()) {
+            if (!fingerprint_) fingerprint_ = detail::fingerprint(sql_);
+            stats_ = metrics.statement(*fingerprint_, sql_, table_);
+        }
+        slow_ = SlowQueryLog::instance().enabled();
+        if (Tracer::active()) {
+            if (!fingerprint_) fingerprint_ = detail::fingerprint(sql_);
+            span_.emplace(SpanKind::Statement, sql_, table_, *fingerprint_);
+        }
+        if (stats_ || slow_ || span_) start_ = std::chrono::steady_clock::now();
+    }
+
+    std::string_view sql_;
+    const char* table_;
+    ConnectionPool* pool_;
+    std::optional<uint64_t> fingerprint_;
+    detail::ShardedStats* stats_ = nullptr;
+    bool slow_ = false;
+    int exceptions_;
+    bool failed_ = false;
+    uint64_t rows_ = 0;
+    uint64_t bytes_ = 0;
+    std::vector<SqlValue> params_;
+    std::chrono::steady_clock::time_point start_;
+    std::optional<TraceSpan> span_;
+};
+
+} // namespace uORM
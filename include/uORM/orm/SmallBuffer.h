@@ -0,0 +1,132 @@
+#pragma once
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace uORM {
+
+// 内联字符串：内容不超过 N 字节时存放在对象内部，超过后才转移到堆上的 std::string
+template<size_t N>
+class InlineString {
+public:
+    InlineString() = default;
+
+    InlineString(const InlineString& other) { assign(other.view()); }
+
+    InlineString& operator=(const InlineString& other) {
+        if (this != &other) {
+            clear();
+            assign(other.view());
+        }
+        return *this;
+    }
+
+    InlineString& operator+=(std::string_view s) {
+        append(s);
+        return *this;
+    }
+
+    InlineString& operator+=(char c) {
+        append(std::string_view(&c, 1));
+        return *this;
+    }
+
+    void append(std::string_view s) {
+        if (onHeap_) {
+            heap_.append(s);
+        } else if (size_ + s.size() <= N) {
+            std::memcpy(inline_.data() + size_, s.data(), s.size());
+            size_ += s.size();
+        } else {
+            heap_.reserve((size_ + s.size()) * 2);
+            heap_.assign(inline_.data(), size_);
+            heap_.append(s);
+            onHeap_ = true;
+        }
+    }
+
+    void clear() {
+        size_ = 0;
+        heap_.clear();
+        onHeap_ = false;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t size() const { return onHeap_ ? heap_.size() : size_; }
+
+    std::string_view view() const {
+        return onHeap_ ? std::string_view(heap_) : std::string_view(inline_.data(), size_);
+    }
+
+    operator std::string_view() const { return view(); }
+
+private:
+    void assign(std::string_view s) {
+        append(s);
+    }
+
+    std::array<char, N> inline_;
+    size_t size_ = 0;
+    std::string heap_;
+    bool onHeap_ = false;
+};
+
+// 小容量向量：前 N 个元素存放在对象内部，超过后整体转移到堆上的 std::vector
+template<typename T, size_t N>
+class SmallVector {
+public:
+    void push_back(const T& value) {
+        if (!heap_.empty()) {
+            heap_.push_back(value);
+        } else if (size_ < N) {
+            inline_[size_++] = value;
+        } else {
+            heap_.reserve(N * 2);
+            for (size_t i = 0; i < size_; ++i) {
+                heap_.push_back(std::move(inline_[i]));
+            }
+            heap_.push_back(value);
+            size_ = 0;
+        }
+    }
+
+    void append(const T* first, size_t count) {
+        for (size_t i = 0; i < count; ++i) push_back(first[i]);
+    }
+
+    void clear() {
+        size_ = 0;
+        heap_.clear();
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t size() const { return heap_.empty() ? size_ : heap_.size(); }
+
+    T* data() { return heap_.empty() ? inline_.data() : heap_.data(); }
+
+    const T* data() const { return heap_.empty() ? inline_.data() : heap_.data(); }
+
+    T& operator[](size_t i) { return data()[i]; }
+
+    const T& operator[](size_t i) const { return data()[i]; }
+
+    T* begin() { return data(); }
+
+    const T* begin() const { return data(); }
+
+    T* end() { return data() + size(); }
+
+    const T* end() const { return data() + size(); }
+
+private:
+    std::array<T, N> inline_{};
+    size_t size_ = 0;
+    std::vector<T> heap_;
+};
+
+} // namespace uORM
@@ -1,10 +1,90 @@
 #pragma once
 #include <variant>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <memory>
+#include <type_traits>
 
 namespace uORM {
 
-using SqlValue = std::variant<int, long, long long, unsigned int, unsigned long long, std::string, const char*, bool, double, std::nullptr_t>;
+struct SqlArray;
+
+// 占位符：在 Query 模板中代替具体值，由 CompiledQuery::execute 在执行时按顺序绑定
+struct SqlPlaceholder {};
+inline constexpr SqlPlaceholder placeholder{};
+
+using SqlValue = std::variant<int, long, long long, unsigned int, unsigned long long, std::string, const char*, std::string_view, bool, double, std::nullptr_t, std::shared_ptr<const SqlArray>, SqlPlaceholder>;
+
+// IN 列表参数：整个 IN 谓词在 WHERE 子句中只占一个 ? 槽位，
+// 组装 SQL 时由方言根据列表大小决定展开为 IN (?, ...)、绑定为数组参数或拆分执行
+struct SqlArray {
+    std::string column;         // 列名
+    bool negated = false;       // true 表示 NOT IN
+    std::vector<SqlValue> values;
+};
+
+namespace detail {
+
+// 是否借用调用方的内存 (const char*、string_view，或含有这类值的 IN 列表)
+inline bool borrowsMemory(const SqlValue& value) {
+    if (std::holds_alternative<const char*>(value) || std::holds_alternative<std::string_view>(value)) return true;
+    if (auto* arr = std::get_if<std::shared_ptr<const SqlArray>>(&value)) {
+        if (!*arr) return false;
+        for (const auto& item : (*arr)->values) {
+            if (borrowsMemory(item)) return true;
+        }
+    }
+    return false;
+}
+
+// 复制一份不依赖调用方内存的参数值，用于日志与 EXPLAIN 的重新绑定以及延后执行的查询
+template<typename V>
+SqlValue ownedSqlValue(const V& value) {
+    if constexpr (std::is_same_v<V, SqlValue>) {
+        return std::visit([](const auto& arg) -> SqlValue { return ownedSqlValue(arg); }, value);
+    } else if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::string_view>) {
+        return std::string(value);
+    } else if constexpr (std::is_same_v<V, const char*> || std::is_same_v<V, char*>) {
+        return value ? SqlValue(std::string(value)) : SqlValue(nullptr);
+    } else if constexpr (std::is_same_v<V, float>) {
+        return static_cast<double>(value);
+    } else if constexpr (std::is_same_v<V, unsigned long>) {
+        return static_cast<unsigned long long>(value);
+    } else if constexpr (std::is_same_v<V, std::shared_ptr<const SqlArray>>) {
+        // 列表本身共享，只有含借用的值时才复制
+        if (!borrowsMemory(value)) return value;
+        auto arr = std::make_shared<SqlArray>();
+        arr->column = value->column;
+        arr->negated = value->negated;
+        arr->values.reserve(value->values.size());
+        for (const auto& item : value->values) arr->values.push_back(ownedSqlValue(item));
+        return std::shared_ptr<const SqlArray>(std::move(arr));
+    } else if constexpr (std::is_constructible_v<SqlValue, V>) {
+        return value;
+    } else {
+        return nullptr;
+    }
+}
+
+} // namespace detail
+
+// 参数序列的只读视图，Query 的内联参数存储和 std::vector<SqlValue> 都可以转换为它
+class ParamView {
+public:
+    ParamView() = default;
+    ParamView(const SqlValue* data, size_t size) : data_(data), size_(size) {}
+    ParamView(const std::vector<SqlValue>& values) : data_(values.data()), size_(values.size()) {}
+
+    const SqlValue* begin() const { return data_; }
+    const SqlValue* end() const { return data_ + size_; }
+    const SqlValue& operator[](size_t i) const { return data_[i]; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const SqlValue* data_ = nullptr;
+    size_t size_ = 0;
+};
 
 }
@@ -0,0 +1,327 @@
+#pragma once
+// 文件说明：
+// 追踪钩子：在语句执行、连接获取、新建连接与事务 (流水线) 前后通知观察者。
+// 观察者收到的 SpanInfo 包含语句指纹、实体表名 (TableMeta<T>::name) 与父 span，
+// 结束时的 SpanResult 包含结果 (成功/失败) 与行数。
+//
+//   auto trace = std::make_shared<uORM::ChromeTraceExporter>("uorm_trace.json");
+//   uORM::Tracer::instance().addObserver(trace);
+//   ...
+//   trace->write();   // 用 chrome://tracing 或 Perfetto 打开
+//
+// 未注册观察者时每个钩子只有一次原子读取；定义 UORM_NO_TRACING (CMake: -DUORM_ENABLE_TRACING=OFF) 时
+// TraceSpan 是空类型，Tracer::active() 为编译期常量 false，钩子被完全消除。
+//
+// 父子关系按线程传递：TraceSpan 存活期间，同一线程上开始的 span 以它为父 span。
+// 应用可以用 TraceSpan 包裹自己的事务或业务操作：
+//   uORM::TraceSpan tx(uORM::SpanKind::Transaction, "checkout");
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace uORM {
+
+enum class SpanKind {
+    Statement,     // 一条语句的执行，name 为 SQL
+    Acquire,       // ConnectionPool::getConnection
+    Connect,       // 新建数据库连接
+    Transaction,   // 事务边界 (流水线在一个事务中执行)，或应用自定义的事务
+    Custom
+};
+
+inline const char* spanKindName(SpanKind kind) {
+    switch (kind) {
+        case SpanKind::Statement: return "statement";
+        case SpanKind::Acquire: return "acquire";
+        case SpanKind::Connect: return "connect";
+        case SpanKind::Transaction: return "transaction";
+        default: return "custom";
+    }
+}
+
+struct SpanInfo {
+    uint64_t id = 0;
+    uint64_t parentId = 0;             // 0 表示没有父 span
+    SpanKind kind = SpanKind::Custom;
+    std::string_view name;             // Statement 为 SQL 文本，仅在回调期间有效
+    uint64_t fingerprint = 0;          // Statement 的语句指纹，与 Metrics 一致
+    const char* table = nullptr;       // 实体表名，未知时为空
+    uint32_t thread = 0;               // 开始 span 的线程序号 (从 1 开始)
+    bool async = false;                // 在其他线程结束 (协程接口的非阻塞执行)
+    std::chrono::steady_clock::time_point start;
+};
+
+struct SpanResult {
+    bool ok = true;
+    uint64_t rows = 0;
+    std::chrono::steady_clock::time_point end;
+};
+
+// 观察者在执行语句的线程上同步调用，实现应尽量轻量且线程安全
+class TraceObserver {
+public:
+    virtual ~TraceObserver() = default;
+    virtual void onStart(const SpanInfo&) {}
+    virtual void onEnd(const SpanInfo& span, const SpanResult& result) = 0;
+};
+
+namespace detail {
+
+inline uint32_t traceThreadId() {
+    static std::atomic<uint32_t> next{1};
+    thread_local const uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+// 当前线程上最内层的 span
+inline uint64_t& currentSpan() {
+    thread_local uint64_t id = 0;
+    return id;
+}
+
+} // namespace detail
+
+class Tracer {
+public:
+    static Tracer& instance() {
+        static Tracer inst;
+        return inst;
+    }
+
+#ifdef UORM_NO_TRACING
+    static constexpr bool active() {
+        return false;
+    }
+#else
+    static bool active() {
+        return instance().active_.load(std::memory_order_relaxed);
+    }
+#endif
+
+    void addObserver(std::shared_ptr<TraceObserver> observer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto next = std::make_shared<Observers>(*std::atomic_load(&observers_));
+        next->push_back(std::move(observer));
+        std::atomic_store(&observers_, std::shared_ptr<const Observers>(std::move(next)));
+        active_.store(true, std::memory_order_relaxed);
+    }
+
+    void removeObserver(const std::shared_ptr<TraceObserver>& observer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto next = std::make_shared<Observers>(*std::atomic_load(&observers_));
+        next->erase(std::remove(next->begin(), next->end(), observer), next->end());
+        active_.store(!next->empty(), std::memory_order_relaxed);
+        std::atomic_store(&observers_, std::shared_ptr<const Observers>(std::move(next)));
+    }
+
+    // 开始一个 span 并通知观察者，父 span 为当前线程上最内层的 TraceSpan
+    SpanInfo begin(SpanKind kind, std::string_view name, const char* table = nullptr, uint64_t fingerprint = 0) {
+        SpanInfo span;
+        span.id = nextId_.fetch_add(1, std::memory_order_relaxed);
+        span.parentId = detail::currentSpan();
+        span.kind = kind;
+        span.name = name;
+        span.fingerprint = fingerprint;
+        span.table = table;
+        span.thread = detail::traceThreadId();
+        span.start = std::chrono::steady_clock::now();
+        auto observers = std::atomic_load(&observers_);
+        for (const auto& observer : *observers) observer->onStart(span);
+        return span;
+    }
+
+    void end(const SpanInfo& span, bool ok, uint64_t rows) {
+        SpanResult result;
+        result.ok = ok;
+        result.rows = rows;
+        result.end = std::chrono::steady_clock::now();
+        auto observers = std::atomic_load(&observers_);
+        for (const auto& observer : *observers) observer->onEnd(span, result);
+    }
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+private:
+    using Observers = std::vector<std::shared_ptr<TraceObserver>>;
+
+    Tracer() : observers_(std::make_shared<const Observers>()) {}
+
+    std::atomic<bool> active_{false};
+    std::atomic<uint64_t> nextId_{1};
+    std::mutex mutex_;
+    std::shared_ptr<const Observers> observers_;
+};
+
+#ifdef UORM_NO_TRACING
+
+class TraceSpan {
+public:
+    TraceSpan(SpanKind, std::string_view, const char* = nullptr, uint64_t = 0) {}
+    void rows(uint64_t) {}
+    void fail() {}
+};
+
+#else
+
+// RAII span：构造时开始，析构时结束。析构时若有新的异常正在传播则记为失败
+class TraceSpan {
+public:
+    TraceSpan(SpanKind kind, std::string_view name, const char* table = nullptr, uint64_t fingerprint = 0) {
+        if (!Tracer::active()) return;
+        active_ = true;
+        exceptions_ = std::uncaught_exceptions();
+        span_ = Tracer::instance().begin(kind, name, table, fingerprint);
+        detail::currentSpan() = span_.id;
+    }
+
+    ~TraceSpan() {
+        if (!active_) return;
+        detail::currentSpan() = span_.parentId;
+        bool ok = !failed_ && std::uncaught_exceptions() <= exceptions_;
+        Tracer::instance().end(span_, ok, rows_);
+    }
+
+    void rows(uint64_t n) {
+        rows_ += n;
+    }
+
+    void fail() {
+        failed_ = true;
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    bool active_ = false;
+    bool failed_ = false;
+    int exceptions_ = 0;
+    uint64_t rows_ = 0;
+    SpanInfo span_;
+};
+
+#endif // UORM_NO_TRACING
+
+// 将 span 记录为 Chrome trace-event 格式 (JSON)，可在 chrome://tracing 或 https://ui.perfetto.dev 中查看。
+// 事件保存在内存中，write() 时写出全部事件；析构时自动写出一次
+class ChromeTraceExporter : public TraceObserver {
+public:
+    explicit ChromeTraceExporter(std::string path, size_t maxEvents = 1000000)
+        : path_(std::move(path)), maxEvents_(maxEvents), origin_(std::chrono::steady_clock::now()) {}
+
+    ~ChromeTraceExporter() override {
+        try {
+            write();
+        } catch (...) {
+        }
+    }
+
+    void onEnd(const SpanInfo& span, const SpanResult& result) override {
+        std::string event;
+        event.reserve(160 + span.name.size());
+        long long ts = micros(span.start);
+        long long dur = std::chrono::duration_cast<std::chrono::microseconds>(result.end - span.start).count();
+
+        // 语句以 SQL 开头部分作为事件名，完整 SQL 放在 args 中
+        std::string_view name = span.kind == SpanKind::Statement ? span.name.substr(0, 64) : span.name;
+        event += "{\"name\":";
+        appendString(event, name);
+        event += ",\"cat\":\"";
+        event += spanKindName(span.kind);
+        if (span.async) {
+            // 跨线程的 span 使用异步事件，避免破坏所在线程上 X 事件的嵌套关系
+            event += "\",\"ph\":\"b\",\"id\":" + std::to_string(span.id);
+        } else {
+            event += "\",\"ph\":\"X\",\"dur\":" + std::to_string(dur);
+        }
+        event += ",\"ts\":" + std::to_string(ts);
+        event += ",\"pid\":1,\"tid\":" + std::to_string(span.thread);
+        event += ",\"args\":{\"span\":" + std::to_string(span.id) + ",\"parent\":" + std::to_string(span.parentId);
+        event += result.ok ? ",\"outcome\":\"ok\"" : ",\"outcome\":\"error\"";
+        if (span.kind == SpanKind::Statement) {
+            char fp[17];
+            std::snprintf(fp, sizeof(fp), "%016llx", static_cast<unsigned long long>(span.fingerprint));
+            event += ",\"fingerprint\":\"";
+            event += fp;
+            event += "\",\"rows\":" + std::to_string(result.rows) + ",\"sql\":";
+            appendString(event, span.name);
+        }
+        if (span.table) {
+            event += ",\"table\":";
+            appendString(event, span.table);
+        }
+        event += "}}";
+        if (span.async) {
+            event += ",{\"name\":";
+            appendString(event, name);
+            event += ",\"cat\":\"statement\",\"ph\":\"e\",\"id\":" + std::to_string(span.id) +
+                     ",\"ts\":" + std::to_string(ts + dur) + ",\"pid\":1,\"tid\":" + std::to_string(span.thread) + "}";
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (events_.size() < maxEvents_) events_.push_back(std::move(event));
+    }
+
+    // 写出到目前为止记录的全部事件
+    void write() {
+        std::vector<std::string> events;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            events = events_;
+        }
+        std::ofstream file(path_, std::ios::trunc);
+        if (!file) return;
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (size_t i = 0; i < events.size(); ++i) {
+            if (i > 0) file << ",\n";
+            file << events[i];
+        }
+        file << "]}\n";
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_.size();
+    }
+
+private:
+    long long micros(std::chrono::steady_clock::time_point t) const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(t - origin_).count();
+    }
+
+    static void appendString(std::string& out, std::string_view value) {
+        out += '"';
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (c == '\n') {
+                out += "\\n";
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                out += ' ';
+            } else {
+                out += c;
+            }
+        }
+        out += '"';
+    }
+
+    std::string path_;
+    size_t maxEvents_;
+    std::chrono::steady_clock::time_point origin_;
+    mutable std::mutex mutex_;
+    std::vector<std::string> events_;
+};
+
+} // namespace uORM
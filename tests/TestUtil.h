@@ -0,0 +1,64 @@
+#pragma once
+// 文件说明：
+// 测试程序的公共工具：用例注册与断言。每个测试程序在 main 中调用 runTests()，
+// 有失败的断言时返回非 0，由 ctest 判定结果。
+
+#include <cstdio>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace uORM {
+namespace test {
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+};
+
+inline std::vector<TestCase>& registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+
+struct Registrar {
+    Registrar(const char* name, void (*fn)()) {
+        registry().push_back(TestCase{name, fn});
+    }
+};
+
+// 用例抛出的异常计为一次失败，其余用例继续执行
+inline int runTests() {
+    for (const auto& tc : registry()) {
+        int before = failures();
+        try {
+            tc.fn();
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "  exception: %s\n", e.what());
+            ++failures();
+        }
+        std::printf("[%s] %s\n", failures() == before ? "PASS" : "FAIL", tc.name);
+    }
+    return failures() == 0 ? 0 : 1;
+}
+
+} // namespace test
+} // namespace uORM
+
+#define UORM_TEST(Name) \
+    static void Name(); \
+    static ::uORM::test::Registrar Name##_registrar(#Name, &Name); \
+    static void Name()
+
+#define UORM_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::fprintf(stderr, "  %s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++::uORM::test::failures(); \
+        } \
+    } while (0)
@@ -0,0 +1,138 @@
+// 超过上限的 IN 列表：只有列表是顶层 AND 项时才拆分为多条语句，
+// 处在 OR 分组中时改为查询临时表，select 不产生重复行，count 不重复计数。
+// 使用 bench/FakeDriver.h 的内存驱动 (MySQL 方言，上限 1000)，不需要数据库。
+
+#include "TestUtil.h"
+#include "BenchModels.h"
+#include "FakeDriver.h"
+#include "uORM/orm/Mapper.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using uORM::bench::FakeResult;
+using uORM::bench::FakeScope;
+
+namespace {
+
+using ProductMapper = uORM::Mapper<Product, uORM::DynamicDriver>;
+
+// 记录执行过的查询语句 (SELECT)，建表与写入临时表的语句不计
+struct Recorder {
+    std::mutex mutex;
+    std::vector<std::string> queries;
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queries.size();
+    }
+
+    bool anyContains(const std::string& text) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& sql : queries) {
+            if (sql.find(text) != std::string::npos) return true;
+        }
+        return false;
+    }
+};
+
+std::shared_ptr<const FakeResult> productRows(size_t n) {
+    auto result = std::make_shared<FakeResult>(
+        std::vector<std::string>{"id", "name", "category", "price", "stock", "is_active", "created_at"});
+    for (size_t i = 0; i < n; ++i) {
+        long long id = static_cast<long long>(i) + 1;
+        result->rows.push_back({id, "Product " + std::to_string(id), std::string("Home"),
+                                1.0, 5LL, 1LL, std::string("2024-01-01 00:00:00")});
+    }
+    return result;
+}
+
+std::shared_ptr<const FakeResult> countRow(long long n) {
+    auto result = std::make_shared<FakeResult>(std::vector<std::string>{"count_val"});
+    result->rows.push_back({n});
+    return result;
+}
+
+// 每条 SELECT 返回 3 行，每条 COUNT 返回 3
+FakeScope respondWith(Recorder& recorder) {
+    return FakeScope(std::chrono::microseconds(0), [&recorder](const std::string& sql) -> std::shared_ptr<const FakeResult> {
+        if (sql.compare(0, 6, "SELECT") != 0) return nullptr;
+        {
+            std::lock_guard<std::mutex> lock(recorder.mutex);
+            recorder.queries.push_back(sql);
+        }
+        return sql.find("COUNT(") != std::string::npos ? countRow(3) : productRows(3);
+    });
+}
+
+std::vector<int> ids(size_t n) {
+    std::vector<int> values;
+    for (size_t i = 0; i < n; ++i) values.push_back(static_cast<int>(i) + 1);
+    return values;
+}
+
+uORM::Query orGroupQuery() {
+    uORM::Query q;
+    q.eq("category", "Home").group([](uORM::Query& g) { g.in("id", ids(2500)).or_().eq("stock", 5); });
+    return q;
+}
+
+} // namespace
+
+// 顶层 AND 项：2500 个值按 1000 拆成 3 条语句，计数累加
+UORM_TEST(TopLevelConjunctIsChunked) {
+    Recorder recorder;
+    auto scope = respondWith(recorder);
+    uORM::Query q;
+    q.eq("category", "Home").in("id", ids(2500));
+
+    UORM_CHECK(ProductMapper::count(q) == 9);
+    UORM_CHECK(recorder.count() == 3);
+    UORM_CHECK(!recorder.anyContains("uorm_in_"));
+}
+
+// OR 分组中的列表：拆分会重复返回满足 stock = 5 的行，必须改为一条查询临时表的语句
+UORM_TEST(OrGroupSelectUsesTempTable) {
+    Recorder recorder;
+    auto scope = respondWith(recorder);
+
+    auto rows = ProductMapper::select(orGroupQuery());
+    UORM_CHECK(rows.size() == 3);
+    UORM_CHECK(recorder.count() == 1);
+    UORM_CHECK(recorder.anyContains("uorm_in_1"));
+}
+
+UORM_TEST(OrGroupCountUsesTempTable) {
+    Recorder recorder;
+    auto scope = respondWith(recorder);
+
+    UORM_CHECK(ProductMapper::count(orGroupQuery()) == 3);
+    UORM_CHECK(recorder.count() == 1);
+    UORM_CHECK(recorder.anyContains("uorm_in_1"));
+}
+
+// 嵌套分组：外层分组含 OR 时，内层全为 AND 也不能拆分
+UORM_TEST(NestedOrGroupIsNotChunked) {
+    Recorder recorder;
+    auto scope = respondWith(recorder);
+    uORM::Query q;
+    q.group([](uORM::Query& g) {
+        g.group([](uORM::Query& inner) { inner.in("id", ids(2500)).eq("stock", 5); }).or_().eq("category", "Home");
+    });
+
+    UORM_CHECK(ProductMapper::count(q) == 3);
+    UORM_CHECK(recorder.count() == 1);
+}
+
+// 空分组不生成条件，之前的 or_() 不作用于下一个条件
+UORM_TEST(EmptyGroupResetsConnector) {
+    uORM::Query q;
+    q.eq("category", "Home").or_().group([](uORM::Query&) {}).eq("stock", 5);
+    UORM_CHECK(q.getWhere() == "category = ? AND stock = ?");
+}
+
+int main() {
+    uORM::bench::installFakeDriver(2);
+    return uORM::test::runTests();
+}
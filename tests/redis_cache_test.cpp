@@ -0,0 +1,124 @@
+// RedisCache 对真实 redis-server 的读写：回填与命中、写入后的墓碑、表版本与清空版本不一致时的失效、连接池之间的隔离。
+// 服务器地址取自 UORM_TEST_REDIS_HOST / UORM_TEST_REDIS_PORT (默认 127.0.0.1:6379)，
+// 连接不上时整个程序以返回码 77 跳过 (ctest 中记为 Skipped)。键使用带进程号的独立前缀，不影响其他数据。
+
+#include "TestUtil.h"
+#include "BenchModels.h"
+#include "uORM/driver/redis/RedisClient.h"
+#include "uORM/orm/RedisCache.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using uORM::RedisCache;
+
+namespace {
+
+const std::string kPool = "default";
+
+RedisCache<Product>& cache() {
+    return RedisCache<Product>::instance();
+}
+
+Product sampleProduct(int id) {
+    return Product{id, "Desk Lamp", "Home", 19.5, 7, true, "2024-01-01 00:00:00"};
+}
+
+} // namespace
+
+UORM_TEST(EntityFillThenHit) {
+    uint64_t epoch = 0;
+    UORM_CHECK(!cache().getEntity(kPool, 1, epoch).has_value());
+    UORM_CHECK(epoch != RedisCache<Product>::kNoVersion);
+
+    cache().fillEntity(kPool, sampleProduct(1), epoch);
+    auto hit = cache().getEntity(kPool, 1, epoch);
+    UORM_CHECK(hit.has_value());
+    UORM_CHECK(hit && hit->name == "Desk Lamp" && hit->stock == 7 && hit->price == 19.5);
+}
+
+// 写入留下墓碑：读取未命中，并发读取的回填 (SET NX) 不能把旧值写回
+UORM_TEST(WriteLeavesTombstone) {
+    uint64_t epoch = 0;
+    cache().getEntity(kPool, 2, epoch);
+    cache().fillEntity(kPool, sampleProduct(2), epoch);
+    UORM_CHECK(cache().getEntity(kPool, 2, epoch).has_value());
+
+    cache().onWrite(kPool, sampleProduct(2));
+    UORM_CHECK(!cache().getEntity(kPool, 2, epoch).has_value());
+    cache().fillEntity(kPool, sampleProduct(2), epoch);
+    UORM_CHECK(!cache().getEntity(kPool, 2, epoch).has_value());
+}
+
+// 查询结果带表版本：任意写入使版本加一，旧结果不再返回，旧版本的回填被拒绝
+UORM_TEST(QueryEvictedOnVersionMismatch) {
+    const std::string key = "S|SELECT * FROM products WHERE category = ?|Home";
+    uint64_t version = 0;
+    UORM_CHECK(!cache().getRows(kPool, key, version).has_value());
+
+    cache().putRows(kPool, key, version, {sampleProduct(3), sampleProduct(4)});
+    cache().putCount(kPool, key + "#count", version, 2);
+    uint64_t current = 0;
+    auto rows = cache().getRows(kPool, key, current);
+    UORM_CHECK(rows && rows->size() == 2 && (*rows)[1].id == 4);
+    long long total = 0;
+    UORM_CHECK(cache().getCount(kPool, key + "#count", total, current) && total == 2);
+
+    uint64_t stale = version;
+    cache().onWrite(kPool, sampleProduct(3));
+    UORM_CHECK(!cache().getRows(kPool, key, current).has_value());
+    UORM_CHECK(!cache().getCount(kPool, key + "#count", total, current));
+    UORM_CHECK(current != stale);
+
+    cache().putRows(kPool, key, stale, {sampleProduct(3)});
+    UORM_CHECK(!cache().getRows(kPool, key, current).has_value());
+}
+
+// truncate 使清空版本加一，之前回填的实体全部失效
+UORM_TEST(EntityEvictedOnEpochMismatch) {
+    uint64_t epoch = 0;
+    cache().getEntity(kPool, 5, epoch);
+    cache().fillEntity(kPool, sampleProduct(5), epoch);
+    UORM_CHECK(cache().getEntity(kPool, 5, epoch).has_value());
+
+    cache().onTruncate(kPool);
+    uint64_t current = 0;
+    UORM_CHECK(!cache().getEntity(kPool, 5, current).has_value());
+    UORM_CHECK(current != epoch);
+}
+
+// 键与版本按连接池区分：一个库中的实体与写入不影响另一个库
+UORM_TEST(PoolsAreIsolated) {
+    uint64_t epoch = 0;
+    cache().getEntity(kPool, 6, epoch);
+    cache().fillEntity(kPool, sampleProduct(6), epoch);
+
+    uint64_t archiveEpoch = 0;
+    UORM_CHECK(!cache().getEntity("archive", 6, archiveEpoch).has_value());
+    cache().onWrite("archive", sampleProduct(6));
+    UORM_CHECK(cache().getEntity(kPool, 6, epoch).has_value());
+}
+
+int main() {
+    const char* host = std::getenv("UORM_TEST_REDIS_HOST");
+    const char* port = std::getenv("UORM_TEST_REDIS_PORT");
+    auto& config = uORM::ConfigManager::getInstance().redisconfigdata_;
+    config.hostname = host ? host : "127.0.0.1";
+    config.port = port ? std::atoi(port) : 6379;
+    config.poolsize = 2;
+
+    try {
+        uORM::RedisConnection probe(config.hostname, config.port, 1);
+        probe.command({"PING"});
+    } catch (const std::exception& e) {
+        std::printf("redis-server not reachable at %s:%d (%s), skipping\n", config.hostname.c_str(), config.port, e.what());
+        return 77;
+    }
+
+    uORM::RedisCacheOptions options;
+    options.key_prefix = "uorm_test:" + std::to_string(::getpid()) + ":";
+    cache().enable(options);
+    return uORM::test::runTests();
+}